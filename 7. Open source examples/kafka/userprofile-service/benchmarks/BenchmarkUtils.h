@@ -0,0 +1,81 @@
+/**
+ * @file BenchmarkUtils.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file contains small helpers shared by the benchmarks
+ */
+
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace benchmark_utils
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Get the value at a percentile of the samples
+ * @param samples The samples, they are sorted in place
+ * @param percentile The percentile in range [0, 100]
+ * @return The sample at the percentile, 0 if there is no sample
+ */
+inline std::int64_t percentile(std::vector<std::int64_t>& samples, double percentile)
+{
+    if (samples.empty()) {
+        return 0;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto index = static_cast<std::size_t>(percentile / 100.0 * static_cast<double>(samples.size() - 1));
+    return samples[index];
+}
+
+/**
+ * @brief Get the nanoseconds elapsed since a time point
+ */
+inline std::int64_t elapsedNs(Clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Busy wait, used to model a fixed per-request cost without sleeping
+ */
+inline void spinFor(std::chrono::nanoseconds duration)
+{
+    const auto deadline = Clock::now() + duration;
+    while (Clock::now() < deadline) {
+    }
+}
+
+/**
+ * @brief Print one result row
+ */
+inline void printRow(const std::string& name, double recordsPerSec, std::int64_t p99Ns)
+{
+    std::cout << std::left << std::setw(36) << name
+              << std::right << std::setw(14) << std::fixed << std::setprecision(0) << recordsPerSec << " rec/s"
+              << std::setw(12) << p99Ns << " ns p99" << std::endl;
+}
+
+/**
+ * @brief Print one result row without a latency column
+ */
+inline void printRow(const std::string& name, double recordsPerSec)
+{
+    std::cout << std::left << std::setw(36) << name
+              << std::right << std::setw(14) << std::fixed << std::setprecision(0) << recordsPerSec << " rec/s"
+              << std::endl;
+}
+
+} // benchmark_utils
+
+#endif // BENCHMARK_UTILS_H
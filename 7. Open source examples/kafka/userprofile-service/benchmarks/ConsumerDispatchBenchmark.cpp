@@ -0,0 +1,152 @@
+/**
+ * @file ConsumerDispatchBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file compares inline record handling against the partition dispatcher
+ * * The in-process message bus serves poll batches over several partitions. The handler
+ * * blocks for a fixed time per event, like a database write. Inline handling is what
+ * * KafkaMessageConsumer::consume did before, the dispatcher spreads partitions over workers.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "Event.h"
+#include "PartitionDispatcher.h"
+#include "bus/InProcessMessageBus.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+
+    constexpr std::size_t kRecords = 20000;
+    constexpr int kPartitions = 12;
+    const std::string kTopic = "user-events";
+    constexpr std::size_t kMaxPollRecords = 500;
+    constexpr std::size_t kPayloadSize = 256;
+    constexpr auto kHandlerCost = std::chrono::microseconds(20);
+
+    /**
+     * @brief Reads pre-published records from the in-process bus, poll() converts them to events
+     */
+    class BrokerStandIn
+    {
+    public:
+        explicit BrokerStandIn(std::size_t records)
+            : mBus(InProcessMessageBus::Options{kPartitions})
+        {
+            const SharedPayload payload = SharedPayload::fromString(std::string(kPayloadSize, 'x'));
+            const auto producer = mBus.createProducer({});
+            for (std::size_t i = 0; i < records; ++i) {
+                IMessageBus::Record record;
+                record.topic = kTopic;
+                record.partition = static_cast<std::int32_t>(i % kPartitions);
+                record.key = "user-" + std::to_string(i % 1000);
+                record.value = payload;
+                producer->publish(std::move(record), {});
+            }
+            mConsumer = mBus.createConsumer("consumer-dispatch-benchmark", kMaxPollRecords);
+            mConsumer->subscribe({kTopic}, {});
+        }
+
+        std::vector<Event> poll()
+        {
+            std::vector<Event> events;
+            const auto batch = mConsumer->poll(std::chrono::milliseconds(0));
+            events.reserve(batch->size());
+            for (const auto& record : batch->records()) {
+                Event event(Event::EventType::eUserUpdated);
+                event.setPayload(record.value);
+                event.setKey(record.key);
+                event.setSource(record.topic, record.partition, record.offset);
+                events.push_back(std::move(event));
+            }
+            return events;
+        }
+
+    private:
+        InProcessMessageBus mBus;
+        std::unique_ptr<IMessageBus::Consumer> mConsumer;
+    };
+
+    /**
+     * @brief Handler stand-in which checks that every partition is handled in offset order
+     */
+    class OrderCheckingHandler
+    {
+    public:
+        void handle(const Event& event)
+        {
+            std::this_thread::sleep_for(kHandlerCost);
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto [it, created] = mLastOffsets.try_emplace(event.getPartition(), -1);
+            if (event.getOffset() <= it->second) {
+                mOrdered = false;
+            }
+            it->second = event.getOffset();
+        }
+
+        bool ordered() const { return mOrdered; }
+
+    private:
+        std::mutex mMutex;
+        std::unordered_map<int, std::int64_t> mLastOffsets;
+        bool mOrdered = true;
+    };
+
+    double runInline()
+    {
+        BrokerStandIn broker(kRecords);
+        OrderCheckingHandler handler;
+        const auto start = Clock::now();
+        for (auto events = broker.poll(); !events.empty(); events = broker.poll()) {
+            for (const auto& event : events) {
+                handler.handle(event);
+            }
+        }
+        return static_cast<double>(kRecords) / (static_cast<double>(elapsedNs(start)) / 1e9);
+    }
+
+    double runDispatched(std::size_t workers, bool& ordered)
+    {
+        BrokerStandIn broker(kRecords);
+        OrderCheckingHandler handler;
+        const auto start = Clock::now();
+        {
+            PartitionDispatcher::Options options;
+            options.workers = workers;
+            PartitionDispatcher dispatcher(options, [&handler](std::size_t, std::vector<Event>& events) {
+                for (const auto& event : events) {
+                    handler.handle(event);
+                }
+            });
+            for (auto events = broker.poll(); !events.empty(); events = broker.poll()) {
+                dispatcher.dispatch(std::move(events));
+            }
+            dispatcher.drain();
+        }
+        ordered = handler.ordered();
+        return static_cast<double>(kRecords) / (static_cast<double>(elapsedNs(start)) / 1e9);
+    }
+}
+
+int main()
+{
+    std::cout << "Handling " << kRecords << " records over " << kPartitions << " partitions, "
+              << kHandlerCost.count() << " us blocking handler" << std::endl;
+
+    printRow("inline", runInline());
+    for (const std::size_t workers : {1, 2, 4, 8, 12}) {
+        bool ordered = false;
+        const double rate = runDispatched(workers, ordered);
+        printRow("dispatcher workers=" + std::to_string(workers) + (ordered ? "" : " (out of order)"), rate);
+    }
+    return 0;
+}
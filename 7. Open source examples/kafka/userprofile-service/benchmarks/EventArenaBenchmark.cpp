@@ -0,0 +1,172 @@
+/**
+ * @file EventArenaBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file counts the allocations per consumed record of the event fields
+ * * The records are polled from the in-process message bus and converted by
+ * * KafkaMessageConsumer::toEvent, moved to a handler queue like the partition dispatcher does
+ * * and released once handled. They carry a UUID event ID header, a user key and a topic name,
+ * * all too long for the small string buffer. Global operator new is counted to report the
+ * * allocations per record; those of the poll itself are not counted against the events.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "Event.h"
+#include "const/KafkaConst.h"
+#include "KafkaMessageConsumer.h"
+#include "bus/InProcessMessageBus.h"
+
+namespace
+{
+    std::atomic<std::uint64_t> gAllocations{0};
+}
+
+void* operator new(std::size_t size)
+{
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size > 0 ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    using namespace benchmark_utils;
+
+    constexpr std::size_t kRecords = 20000;
+    constexpr std::size_t kPasses = 50;
+    constexpr std::size_t kMaxPollRecords = 500;
+    const IMessageBus::TopicPartition kPartition{"user-profile-events", 0};
+
+    /**
+     * @brief Publishes the records once, every pass reads them again from the first offset
+     */
+    class PolledRecords
+    {
+    public:
+        PolledRecords()
+            : mBus(InProcessMessageBus::Options{1})
+        {
+            const SharedPayload payload = SharedPayload::fromString(std::string(256, 'x'));
+            const std::string type = std::to_string(static_cast<int>(Event::EventType::eUserUpdated));
+            const auto producer = mBus.createProducer({});
+            for (std::size_t i = 0; i < kRecords; ++i) {
+                IMessageBus::Record record;
+                record.topic = kPartition.first;
+                record.partition = kPartition.second;
+                record.key = "user-" + std::to_string(1000000000000 + i);
+                record.value = payload;
+                record.headers = {{kafka_const::kEventTypeHeader, type},
+                    {kafka_const::kEventIdHeader, "6f1c2a4e-9b7d-4c3e-8a5f-" + std::to_string(100000000000 + i)}};
+                producer->publish(std::move(record), {});
+            }
+            mConsumer = mBus.createConsumer("", kMaxPollRecords);
+            mConsumer->assign({kPartition});
+        }
+
+        void rewind()
+        {
+            mConsumer->seek(kPartition, 0);
+        }
+
+        std::shared_ptr<const PolledBatch> poll()
+        {
+            return mConsumer->poll(std::chrono::milliseconds(0));
+        }
+
+    private:
+        InProcessMessageBus mBus;
+        std::unique_ptr<IMessageBus::Consumer> mConsumer;
+    };
+
+    /**
+     * @brief Convert, queue and release every poll batch of every pass
+     * @param convert Returns the event of a record of the batch
+     */
+    template <typename Convert>
+    void run(const std::string& name, PolledRecords& polled, Convert convert)
+    {
+        std::vector<Event> events;
+        std::vector<Event> queue;
+        events.reserve(kMaxPollRecords);
+        queue.reserve(kMaxPollRecords);
+
+        std::uint64_t pollAllocations = 0;
+        std::size_t converted = 0;
+        const auto allocationsBefore = gAllocations.load();
+        const auto start = Clock::now();
+        for (std::size_t pass = 0; pass < kPasses; ++pass) {
+            polled.rewind();
+            while (true) {
+                const auto polledFrom = gAllocations.load();
+                auto batch = polled.poll();
+                pollAllocations += gAllocations.load() - polledFrom;
+                if (batch->empty()) {
+                    break;
+                }
+
+                for (const auto& record : batch->records()) {
+                    events.push_back(convert(record, batch));
+                }
+                converted += batch->size();
+                batch.reset();
+
+                for (auto& event : events) {
+                    queue.push_back(std::move(event));
+                }
+                events.clear();
+                queue.clear(); // handled, the last reference to the batch goes with the last event
+            }
+        }
+        const auto elapsed = elapsedNs(start);
+        const auto allocations = gAllocations.load() - allocationsBefore - pollAllocations;
+
+        const double total = static_cast<double>(converted);
+        printRow(name, total * 1e9 / static_cast<double>(elapsed));
+        std::cout << std::left << std::setw(36) << "" << std::right << std::setprecision(3)
+                  << std::setw(14) << static_cast<double>(allocations) / total << " allocations/rec" << std::endl;
+    }
+}
+
+int main()
+{
+    PolledRecords polled;
+
+    // What the consumer did before the event fields pointed into the poll batch
+    run("owned fields (setters)", polled,
+        [](const PolledBatch::Record& record, const std::shared_ptr<const PolledBatch>& batch) {
+            Event event(Event::EventType::eUserUpdated);
+            for (const auto& [name, value] : batch->headers(record)) {
+                if (name == kafka_const::kEventIdHeader) {
+                    event.setId(value);
+                }
+            }
+            event.setPayload(record.value);
+            event.setKey(record.key);
+            event.setSource(record.topic, record.partition, record.offset);
+            return event;
+        });
+
+    run("KafkaMessageConsumer::toEvent", polled, &KafkaMessageConsumer::toEvent);
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file EventEnvelopeBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file compares reading the routing fields of a JSON payload and of an envelope
+ * * Routing and auditing only need the event type and the user ID. From a JSON payload they
+ * * cost a full User::fromJson parse, from an EventEnvelope they are read from its header.
+ */
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "EventEnvelope.h"
+#include "User.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+
+    constexpr std::size_t kEvents = 10000;
+    constexpr std::size_t kRounds = 20;
+
+    User makeUser(std::size_t i)
+    {
+        return User("6f1c2a4e-9b7d-4c3e-8a5f-" + std::to_string(100000000000 + i), "user" + std::to_string(i),
+            "user" + std::to_string(i) + "@example.com", "2026-10-16T08:00:00Z", "2026-10-16T09:30:00Z");
+    }
+
+    template <typename Item, typename Read>
+    void run(const std::string& name, const std::vector<Item>& items, Read read)
+    {
+        std::size_t checksum = 0;
+        const auto start = Clock::now();
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            for (const auto& item : items) {
+                checksum += read(item);
+            }
+        }
+        const auto elapsed = elapsedNs(start);
+        const double total = static_cast<double>(kRounds * items.size());
+        printRow(name, total * 1e9 / static_cast<double>(elapsed));
+        std::cout << std::left << std::setw(36) << "" << std::right << std::setprecision(1)
+                  << std::setw(14) << static_cast<double>(elapsed) / total << " ns/event"
+                  << "  (checksum " << checksum << ")" << std::endl;
+    }
+}
+
+int main()
+{
+    std::vector<std::string> userIds;
+    std::vector<std::string> json;
+    std::vector<std::string> envelopes;
+    std::vector<std::size_t> indexes;
+    const auto now = EventEnvelope::Clock::now();
+    for (std::size_t i = 0; i < kEvents; ++i) {
+        User user = makeUser(i);
+        userIds.push_back(user.getUserId());
+        json.push_back(user.toJson());
+        envelopes.push_back(EventEnvelope::encode(EventEnvelope::EventType::eUserUpdated, userIds.back(), now,
+            json.back()));
+        indexes.push_back(i);
+    }
+
+    run("json, User::fromJson", json, [](const std::string& payload) {
+        return User().fromJson(payload).getUserId().size();
+    });
+    run("envelope, header only", envelopes, [](const std::string& payload) {
+        const auto envelope = EventEnvelope::read(payload);
+        return envelope ? envelope->getUserId().size() + static_cast<std::size_t>(envelope->getType()) : 0;
+    });
+
+    std::string out;
+    run("envelope, encode", indexes, [&](std::size_t i) {
+        out.clear();
+        EventEnvelope::encodeTo(out, EventEnvelope::EventType::eUserUpdated, userIds[i], now, json[i]);
+        return out.size();
+    });
+    return 0;
+}
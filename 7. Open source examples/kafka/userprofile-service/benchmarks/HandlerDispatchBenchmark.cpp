@@ -0,0 +1,150 @@
+/**
+ * @file HandlerDispatchBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file compares handing every event to every handler against type-indexed dispatch
+ * * Each handler stand-in takes one or two event types and ignores the rest, like the service
+ * * handlers. Broadcast calls handleEvent of every handler and lets it drop foreign types,
+ * * the registry looks up the handlers of the type, the static table dispatches without a
+ * * virtual call. The handlers only count, so the numbers are the cost of routing alone.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "Event.h"
+#include "Handler.h"
+#include "HandlerRegistry.h"
+#include "StaticHandlerTable.h"
+#include "utils.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+    using user_profile::utils::event::EventTypeMask;
+    using user_profile::utils::event::eventTypeMask;
+
+    constexpr std::size_t kEvents = 4096;
+    constexpr int kRounds = 2000;
+
+    /**
+     * @brief Handler stand-in which counts the events of its types
+     * @tparam Types The event types the handler takes
+     */
+    template <EventTypeMask Types>
+    class CountingHandler final : public Handler
+    {
+    public:
+        static constexpr EventTypeMask kEventTypes = Types;
+
+        bool handleEvent(const Event& event) override
+        {
+            // What a handler does without routing: check the type itself
+            if ((kEventTypes & (EventTypeMask(1) << static_cast<uint16_t>(event.getType()))) == 0) {
+                return true;
+            }
+            ++mHandled;
+            return true;
+        }
+
+        std::uint64_t handled() const
+        {
+            return mHandled;
+        }
+
+    private:
+        std::uint64_t mHandled = 0;
+    };
+
+    using CreatedHandler = CountingHandler<eventTypeMask(Event::EventType::eUserCreated)>;
+    using UpdatedHandler = CountingHandler<eventTypeMask(Event::EventType::eUserUpdated)>;
+    using DeletedHandler = CountingHandler<eventTypeMask(Event::EventType::eUserDeleted)>;
+    using LifecycleHandler = CountingHandler<eventTypeMask(Event::EventType::eUserCreated, Event::EventType::eUserDeleted)>;
+    using AuditHandler = CountingHandler<user_profile::utils::event::kAllEventTypes>;
+
+    struct Handlers
+    {
+        std::shared_ptr<CreatedHandler> created = std::make_shared<CreatedHandler>();
+        std::shared_ptr<UpdatedHandler> updated = std::make_shared<UpdatedHandler>();
+        std::shared_ptr<DeletedHandler> deleted = std::make_shared<DeletedHandler>();
+        std::shared_ptr<LifecycleHandler> lifecycle = std::make_shared<LifecycleHandler>();
+        std::shared_ptr<AuditHandler> audit = std::make_shared<AuditHandler>();
+
+        std::uint64_t handled() const
+        {
+            return created->handled() + updated->handled() + deleted->handled() + lifecycle->handled()
+                + audit->handled();
+        }
+    };
+
+    std::vector<Event> makeEvents()
+    {
+        // Mostly updates, like the real topic
+        std::vector<Event> events;
+        events.reserve(kEvents);
+        for (std::size_t i = 0; i < kEvents; ++i) {
+            const auto slot = i % 8;
+            events.emplace_back(slot == 0 ? Event::EventType::eUserCreated
+                : slot == 1 ? Event::EventType::eUserDeleted : Event::EventType::eUserUpdated);
+        }
+        return events;
+    }
+
+    /**
+     * @brief Run a dispatch function over the events and print its throughput
+     */
+    template <typename Dispatch>
+    void run(const std::string& name, const std::vector<Event>& events, const Handlers& handlers, Dispatch dispatch)
+    {
+        const auto before = handlers.handled();
+        const auto start = Clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            for (const auto& event : events) {
+                dispatch(event);
+            }
+        }
+        const auto elapsed = elapsedNs(start);
+        const auto handled = handlers.handled() - before;
+
+        const double records = static_cast<double>(events.size()) * kRounds;
+        printRow(name, records * 1e9 / static_cast<double>(elapsed));
+        std::cout << std::left << std::setw(36) << "" << std::right << std::setprecision(2)
+                  << std::setw(14) << static_cast<double>(elapsed) / records << " ns/rec"
+                  << std::setw(12) << static_cast<double>(handled) / records << " handled/rec" << std::endl;
+    }
+}
+
+int main()
+{
+    const auto events = makeEvents();
+    Handlers handlers;
+
+    const std::vector<std::shared_ptr<Handler>> all{
+        handlers.created, handlers.updated, handlers.deleted, handlers.lifecycle, handlers.audit};
+    run("broadcast to every handler", events, handlers, [&all](const Event& event) {
+        for (const auto& handler : all) {
+            handler->handleEvent(event);
+        }
+    });
+
+    HandlerRegistry registry;
+    registry.add(handlers.created);
+    registry.add(handlers.updated);
+    registry.add(handlers.deleted);
+    registry.add(handlers.lifecycle);
+    registry.add(handlers.audit);
+    run("handler registry", events, handlers, [&registry](const Event& event) {
+        for (const auto& handler : registry.handlersFor(event.getType())) {
+            handler->handleEvent(event);
+        }
+    });
+
+    const StaticHandlerTable<CreatedHandler, UpdatedHandler, DeletedHandler, LifecycleHandler, AuditHandler> table(
+        *handlers.created, *handlers.updated, *handlers.deleted, *handlers.lifecycle, *handlers.audit);
+    run("static handler table", events, handlers, [&table](const Event& event) {
+        table.dispatch(event);
+    });
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file HandlerFanOutBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file compares running the handlers of a batch one after another against the fan-out
+ * * Three handler stand-ins block for a fixed time per batch, like the notification, order and
+ * * audit handlers calling out to other services. Several handler threads share the fan-out,
+ * * as the partition dispatcher workers do. The last run gives the audit stand-in a timeout
+ * * below its cost, so its batches fail instead of holding up the others.
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "Event.h"
+#include "Handler.h"
+#include "HandlerFanOut.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+
+    constexpr std::size_t kHandlerThreads = 4;
+    constexpr std::size_t kBatchesPerThread = 200;
+    constexpr std::size_t kBatchSize = 50;
+
+    /**
+     * @brief Handler stand-in which blocks for a fixed time per batch
+     */
+    class BlockingHandler final : public Handler
+    {
+    public:
+        explicit BlockingHandler(std::chrono::microseconds cost)
+            : mCost(cost)
+        {
+        }
+
+        bool handleEvent(const Event&) override
+        {
+            return true;
+        }
+
+        std::vector<std::size_t> handleEvents(std::span<const Event>) override
+        {
+            std::this_thread::sleep_for(mCost);
+            return {};
+        }
+
+    private:
+        std::chrono::microseconds mCost;
+    };
+
+    void run(const std::string& name, std::size_t poolThreads, std::chrono::milliseconds auditTimeout)
+    {
+        const HandlerFanOut::Handlers handlers{
+            std::make_shared<BlockingHandler>(std::chrono::microseconds(300)),
+            std::make_shared<BlockingHandler>(std::chrono::microseconds(500)),
+            std::make_shared<BlockingHandler>(std::chrono::microseconds(2000))};
+
+        HandlerFanOut fanOut;
+        fanOut.add(handlers[0], {.name = "notification"});
+        fanOut.add(handlers[1], {.name = "order"});
+        fanOut.add(handlers[2], {.name = "audit", .timeout = auditTimeout});
+        fanOut.start(poolThreads);
+
+        const std::vector<Event> batch(kBatchSize, Event(Event::EventType::eUserUpdated));
+        std::vector<std::vector<std::int64_t>> latencies(kHandlerThreads);
+        std::atomic<std::uint64_t> failed{0};
+
+        const auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (std::size_t thread = 0; thread < kHandlerThreads; ++thread) {
+            threads.emplace_back([&, thread] {
+                for (std::size_t i = 0; i < kBatchesPerThread; ++i) {
+                    const auto batchStart = Clock::now();
+                    for (const auto& indexes : fanOut.run(handlers, batch)) {
+                        failed.fetch_add(indexes.size(), std::memory_order_relaxed);
+                    }
+                    latencies[thread].push_back(elapsedNs(batchStart));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const double seconds = static_cast<double>(elapsedNs(start)) / 1e9;
+
+        std::vector<std::int64_t> all;
+        for (const auto& samples : latencies) {
+            all.insert(all.end(), samples.begin(), samples.end());
+        }
+        const double records = static_cast<double>(kHandlerThreads * kBatchesPerThread * kBatchSize);
+        printRow(name, records / seconds, percentile(all, 99.0));
+        for (const auto& handler : fanOut.stats()) {
+            std::cout << "    " << std::left << std::setw(32) << handler.name << std::right
+                      << std::setw(14) << handler.latencyUs.p99 << " us p99"
+                      << std::setw(10) << handler.failedEvents << " failed"
+                      << std::setw(10) << handler.timeouts << " timeouts" << std::endl;
+        }
+    }
+}
+
+int main()
+{
+    run("sequential", 0, std::chrono::milliseconds(0));
+    run("fan-out, 8 pool threads", 8, std::chrono::milliseconds(0));
+    run("fan-out, audit timeout 1 ms", 8, std::chrono::milliseconds(1));
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file HandlerLaneBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file measures how much a slow handler holds up the others, shared and isolated
+ * * The audit stand-in blocks for far longer per batch than the notification and order
+ * * stand-ins, like a handler waiting on disk. Several handler threads share the fan-out, as
+ * * the partition dispatcher workers do. Shared, every batch waits for the audit handler;
+ * * isolated, it gets a lane with as many workers as there are handler threads and each overflow
+ * * policy is tried once the lane fills.
+ */
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "Event.h"
+#include "Handler.h"
+#include "HandlerFanOut.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+
+    constexpr std::size_t kHandlerThreads = 4;
+    constexpr std::size_t kBatchesPerThread = 200;
+    constexpr std::size_t kBatchSize = 50;
+    constexpr std::size_t kLaneCapacity = 20 * kBatchSize;
+
+    /**
+     * @brief Handler stand-in which blocks for a fixed time per batch
+     */
+    class BlockingHandler final : public Handler
+    {
+    public:
+        explicit BlockingHandler(std::chrono::microseconds cost)
+            : mCost(cost)
+        {
+        }
+
+        bool handleEvent(const Event&) override
+        {
+            return true;
+        }
+
+        std::vector<std::size_t> handleEvents(std::span<const Event>) override
+        {
+            std::this_thread::sleep_for(mCost);
+            return {};
+        }
+
+    private:
+        std::chrono::microseconds mCost;
+    };
+
+    void run(const std::string& name, std::optional<HandlerLane::Overflow> overflow)
+    {
+        const HandlerFanOut::Handlers handlers{
+            std::make_shared<BlockingHandler>(std::chrono::microseconds(300)),
+            std::make_shared<BlockingHandler>(std::chrono::microseconds(500)),
+            std::make_shared<BlockingHandler>(std::chrono::microseconds(4000))};
+
+        const auto spillDirectory = std::filesystem::temp_directory_path() / "handler-lane-benchmark";
+        std::filesystem::remove_all(spillDirectory);
+
+        HandlerFanOut::Options audit{.name = "audit"};
+        if (overflow.has_value()) {
+            audit.lane = HandlerLane::Options{kHandlerThreads, kLaneCapacity, *overflow, spillDirectory};
+        }
+
+        std::vector<std::vector<std::int64_t>> latencies(kHandlerThreads);
+        {
+            HandlerFanOut fanOut;
+            fanOut.add(handlers[0], {.name = "notification"});
+            fanOut.add(handlers[1], {.name = "order"});
+            fanOut.add(handlers[2], audit);
+            fanOut.start(8);
+
+            const std::vector<Event> batch(kBatchSize, Event(Event::EventType::eUserUpdated));
+            const auto start = Clock::now();
+            std::vector<std::thread> threads;
+            for (std::size_t thread = 0; thread < kHandlerThreads; ++thread) {
+                threads.emplace_back([&, thread] {
+                    for (std::size_t i = 0; i < kBatchesPerThread; ++i) {
+                        const auto batchStart = Clock::now();
+                        fanOut.run(handlers, batch);
+                        latencies[thread].push_back(elapsedNs(batchStart));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            const double seconds = static_cast<double>(elapsedNs(start)) / 1e9;
+
+            std::vector<std::int64_t> all;
+            for (const auto& samples : latencies) {
+                all.insert(all.end(), samples.begin(), samples.end());
+            }
+            const double records = static_cast<double>(kHandlerThreads * kBatchesPerThread * kBatchSize);
+            printRow(name, records / seconds, percentile(all, 99.0));
+            for (const auto& handler : fanOut.stats()) {
+                std::cout << "    " << std::left << std::setw(14) << handler.name << std::right
+                          << std::setw(8) << handler.latencyUs.p99 << " us p99"
+                          << std::setw(8) << handler.queueDepth << " queued"
+                          << std::setw(8) << handler.spillDepth << " on disk"
+                          << std::setw(8) << handler.shedEvents << " shed"
+                          << std::setw(10) << handler.queueUs.p99 << " us queue p99" << std::endl;
+            }
+            // Leaving the scope stops the lane, whatever is still spilled is removed unhandled
+        }
+        std::filesystem::remove_all(spillDirectory);
+    }
+}
+
+int main()
+{
+    run("shared", std::nullopt);
+    run("isolated, block", HandlerLane::Overflow::eBlock);
+    run("isolated, shed", HandlerLane::Overflow::eShed);
+    run("isolated, spill", HandlerLane::Overflow::eSpill);
+    return 0;
+}
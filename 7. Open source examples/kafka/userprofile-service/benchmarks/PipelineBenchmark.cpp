@@ -0,0 +1,183 @@
+/**
+ * @file PipelineBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file measures the consume pipeline end to end on the in-process message bus
+ * * Producer threads publish keyed records through KafkaMessageProducer while the members of a
+ * * consumer group run KafkaMessageConsumer::consume, so polling, dispatching, handler fan-out,
+ * * offset tracking and commits are the ones of the service. Members join the group at the
+ * * same time, so the run includes the rebalances of a real deployment start. The visibility
+ * * latency models the broker replication delay. Producers publish as fast as they can, so the
+ * * publish to handled latency includes the backlog the consumers work through.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "EventEnvelope.h"
+#include "Handler.h"
+#include "KafkaMessageConsumer.h"
+#include "KafkaMessageProducer.h"
+#include "bus/InProcessMessageBus.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+
+    constexpr std::size_t kRecords = 100000;
+    constexpr int kPartitions = 12;
+    constexpr std::size_t kProducers = 2;
+    constexpr int kMaxPollRecords = 500;
+    constexpr std::size_t kPayloadSize = 256;
+    constexpr int kWorkersPerMember = 2;
+    constexpr auto kHandlerCost = std::chrono::microseconds(2);
+    const std::string kTopic = "user-events";
+
+    struct Result
+    {
+        double recordsPerSec = 0.0;
+        std::int64_t p99Ns = 0;
+    };
+
+    /**
+     * @brief Handler stand-in which costs a fixed time per event and samples the publish to handled latency
+     * The envelope timestamp of every record is its publish time.
+     */
+    class LatencyHandler : public Handler
+    {
+    public:
+        bool handleEvent(const Event& event) override
+        {
+            return handleEvents(std::span<const Event>(&event, 1)).empty();
+        }
+
+        std::vector<std::size_t> handleEvents(std::span<const Event> events) override
+        {
+            spinFor(kHandlerCost * events.size());
+
+            const auto now = EventEnvelope::Clock::now();
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                for (const auto& event : events) {
+                    if (const auto envelope = EventEnvelope::read(event.getPayload())) {
+                        mSamples.push_back(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(now - envelope->getTimestamp()).count());
+                    }
+                }
+            }
+            mHandled.fetch_add(events.size(), std::memory_order_relaxed);
+            return {};
+        }
+
+        std::size_t handled() const
+        {
+            return mHandled.load(std::memory_order_relaxed);
+        }
+
+        std::vector<std::int64_t> takeSamples()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return std::move(mSamples);
+        }
+
+    private:
+        std::atomic<std::size_t> mHandled{0};
+        std::mutex mMutex;
+        std::vector<std::int64_t> mSamples;
+    };
+
+    ServiceConfig makeConfig()
+    {
+        ServiceConfig config;
+        config.getTopicConfig().setUserEvents(kTopic);
+        config.getTopicConfig().setPartitionCount(kPartitions);
+        config.setKafkaGroupId("pipeline-benchmark");
+        config.setEventHandlerThreads(kWorkersPerMember);
+        config.setConsumerMaxPollRecords(kMaxPollRecords);
+        return config;
+    }
+
+    Result run(std::size_t members, std::chrono::microseconds visibilityLatency)
+    {
+        InProcessMessageBus::Options busOptions;
+        busOptions.defaultPartitions = kPartitions;
+        busOptions.visibilityLatency = visibilityLatency;
+        const auto bus = std::make_shared<InProcessMessageBus>(busOptions);
+        bus->createTopic(kTopic, kPartitions);
+
+        const ServiceConfig config = makeConfig();
+        const auto handler = std::make_shared<LatencyHandler>();
+
+        std::vector<std::unique_ptr<KafkaMessageConsumer>> consumers;
+        for (std::size_t member = 0; member < members; ++member) {
+            auto consumer = std::make_unique<KafkaMessageConsumer>(config, bus);
+            consumer->registerHandler(handler);
+            if (!consumer->initialize()) {
+                std::cerr << "Failed to initialize a consumer" << std::endl;
+                return {};
+            }
+            consumers.push_back(std::move(consumer));
+        }
+
+        const auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (auto& consumer : consumers) {
+            threads.emplace_back([&consumer] { consumer->consume(); });
+        }
+        for (std::size_t producer = 0; producer < kProducers; ++producer) {
+            threads.emplace_back([&bus, &config, producer] {
+                KafkaMessageProducer publisher(config, bus);
+                if (!publisher.initialize()) {
+                    return;
+                }
+                const std::string payload(kPayloadSize, 'x');
+                for (std::size_t i = producer; i < kRecords; i += kProducers) {
+                    const std::string key = "user-" + std::to_string(i % 10000);
+                    publisher.sendMessage(kTopic, key, EventEnvelope::encode(Event::EventType::eUserUpdated, key,
+                        EventEnvelope::Clock::now(), payload));
+                }
+                publisher.flush();
+            });
+        }
+
+        while (handler->handled() < kRecords) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const auto elapsed = elapsedNs(start);
+        for (auto& consumer : consumers) {
+            consumer->stop();
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        Result result;
+        result.recordsPerSec = static_cast<double>(kRecords) / (static_cast<double>(elapsed) / 1e9);
+        auto samples = handler->takeSamples();
+        result.p99Ns = percentile(samples, 99.0);
+        return result;
+    }
+}
+
+int main()
+{
+    std::cout << "Publishing and consuming " << kRecords << " records over " << kPartitions << " partitions, "
+              << kProducers << " producers, " << kWorkersPerMember << " handler threads per member, "
+              << kHandlerCost.count() << " us handler" << std::endl;
+
+    for (const auto latency : {std::chrono::microseconds(0), std::chrono::microseconds(2000)}) {
+        for (const std::size_t members : {1, 2, 3}) {
+            const Result result = run(members, latency);
+            printRow("members=" + std::to_string(members) + " visibility=" + std::to_string(latency.count()) + "us",
+                result.recordsPerSec, result.p99Ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file PollTimeoutBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file compares fixed consumer poll timeouts against the adaptive poller
+ * * The broker stand-in serves polls like librdkafka: a poll returns once it has a full batch
+ * * or its timeout has passed. Idle cost is the number of wake-ups and the CPU time of the
+ * * polling thread with no traffic. Wake latency is how long the first record after the idle
+ * * period waits, load latency is the steady state time from produce to poll return.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AdaptivePoller.h"
+#include "BenchmarkUtils.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+
+    constexpr std::size_t kMaxPollRecords = 500;
+    constexpr auto kIdleDuration = std::chrono::seconds(1);
+    constexpr auto kLoadDuration = std::chrono::seconds(1);
+    constexpr auto kLoadWarmup = std::chrono::milliseconds(200);
+    constexpr auto kLoadInterval = std::chrono::microseconds(500); // 2000 records per second
+
+    /**
+     * @brief In-process broker stand-in with batch-or-timeout poll semantics
+     */
+    class BrokerStandIn
+    {
+    public:
+        void produce()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mRecords.push_back(Clock::now());
+            }
+            mCv.notify_one();
+        }
+
+        std::vector<Clock::time_point> poll(std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCv.wait_for(lock, timeout, [this] { return mRecords.size() >= kMaxPollRecords; });
+            const std::size_t count = std::min(mRecords.size(), kMaxPollRecords);
+            std::vector<Clock::time_point> records(mRecords.begin(), mRecords.begin() + static_cast<long>(count));
+            mRecords.erase(mRecords.begin(), mRecords.begin() + static_cast<long>(count));
+            return records;
+        }
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mCv;
+        std::deque<Clock::time_point> mRecords;
+    };
+
+    std::int64_t threadCpuNs()
+    {
+        timespec now{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return static_cast<std::int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+
+    struct Result
+    {
+        std::uint64_t idleWakeups = 0;
+        std::int64_t idleCpuUs = 0;
+        std::int64_t wakeLatencyUs = 0;
+        std::int64_t loadP50Us = 0;
+        std::int64_t loadP99Us = 0;
+    };
+
+    /**
+     * @brief Run the idle and the load phase with a timeout policy
+     * @param nextTimeout Returns the timeout of the next poll
+     * @param onPoll Receives the number of records of every poll
+     */
+    Result run(const std::function<std::chrono::milliseconds()>& nextTimeout,
+        const std::function<void(std::size_t)>& onPoll)
+    {
+        Result result;
+        BrokerStandIn broker;
+
+        // Idle: no traffic at all
+        const auto idleEnd = Clock::now() + kIdleDuration;
+        const auto cpuStart = threadCpuNs();
+        while (Clock::now() < idleEnd) {
+            const auto records = broker.poll(nextTimeout());
+            onPoll(records.size());
+            ++result.idleWakeups;
+        }
+        result.idleCpuUs = (threadCpuNs() - cpuStart) / 1000;
+
+        // Load: a steady trickle which never fills a batch
+        std::atomic<bool> producing{true};
+        std::thread producer([&broker, &producing] {
+            auto next = Clock::now();
+            while (producing.load()) {
+                broker.produce();
+                next += kLoadInterval;
+                std::this_thread::sleep_until(next);
+            }
+        });
+
+        std::vector<std::int64_t> latencies;
+        const auto loadStart = Clock::now();
+        bool first = true;
+        while (Clock::now() < loadStart + kLoadWarmup + kLoadDuration) {
+            const auto records = broker.poll(nextTimeout());
+            onPoll(records.size());
+            const auto now = Clock::now();
+            if (first && !records.empty()) {
+                result.wakeLatencyUs = std::chrono::duration_cast<std::chrono::microseconds>(now - records.front()).count();
+                first = false;
+            }
+            if (now < loadStart + kLoadWarmup) {
+                continue;
+            }
+            for (const auto& producedAt : records) {
+                latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(now - producedAt).count());
+            }
+        }
+        producing = false;
+        producer.join();
+
+        result.loadP50Us = percentile(latencies, 50.0);
+        result.loadP99Us = percentile(latencies, 99.0);
+        return result;
+    }
+
+    void print(const std::string& name, const Result& result)
+    {
+        std::cout << std::left << std::setw(24) << name << std::right
+                  << std::setw(10) << result.idleWakeups << " wakeups/s"
+                  << std::setw(10) << result.idleCpuUs << " us cpu/s idle"
+                  << std::setw(10) << result.wakeLatencyUs << " us wake"
+                  << std::setw(10) << result.loadP50Us << " us p50"
+                  << std::setw(10) << result.loadP99Us << " us p99 load" << std::endl;
+    }
+}
+
+int main()
+{
+    const auto noop = [](std::size_t) {};
+    for (const int timeoutMs : {1, 100}) {
+        const auto timeout = std::chrono::milliseconds(timeoutMs);
+        print("fixed " + std::to_string(timeoutMs) + " ms", run([timeout] { return timeout; }, noop));
+    }
+
+    AdaptivePoller poller(AdaptivePoller::Options{std::chrono::milliseconds(1), std::chrono::milliseconds(100)});
+    print("adaptive 1-100 ms", run([&poller] { return poller.nextTimeout(); },
+        [&poller](std::size_t records) { poller.onPoll(records); }));
+    return 0;
+}
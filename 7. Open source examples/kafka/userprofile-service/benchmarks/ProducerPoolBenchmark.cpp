@@ -0,0 +1,174 @@
+/**
+ * @file ProducerPoolBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file compares one shared producer pipeline against a sharded pool
+ * * Each publisher thread sends keyed records through the send path the producer owns before
+ * * librdkafka (pooled payload copy, in-flight budget, batch accumulator) into an in-process
+ * * broker stand-in. The single design shares one pipeline, the pool routes keys to shards.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "InFlightBudget.h"
+#include "PayloadBufferPool.h"
+#include "ProducerBatchAccumulator.h"
+#include "ShardRouter.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+
+    constexpr std::size_t kRecordsPerThread = 50000;
+    constexpr std::size_t kUsers = 10000;
+    constexpr std::size_t kPayloadSize = 256;
+    constexpr int kPartitions = 12;
+    constexpr std::size_t kPoolShards = 8;
+    constexpr auto kRequestCost = std::chrono::nanoseconds(2000);
+
+    /**
+     * @brief In-process broker stand-in with one lock per partition
+     */
+    class BrokerStandIn
+    {
+    public:
+        void produce(int partition, std::size_t records)
+        {
+            auto& log = mPartitions[static_cast<std::size_t>(std::max(partition, 0)) % mPartitions.size()];
+            std::lock_guard<std::mutex> lock(log.mutex);
+            spinFor(kRequestCost);
+            log.endOffset += records;
+            mTotal.fetch_add(records, std::memory_order_relaxed);
+        }
+
+        std::uint64_t totalRecords() const { return mTotal.load(); }
+
+    private:
+        struct PartitionLog
+        {
+            std::mutex mutex;
+            std::uint64_t endOffset = 0;
+        };
+
+        std::array<PartitionLog, kPartitions> mPartitions;
+        std::atomic<std::uint64_t> mTotal{0};
+    };
+
+    /**
+     * @brief The part of KafkaMessageProducer which runs before librdkafka
+     */
+    struct Shard
+    {
+        Shard(BrokerStandIn& broker, std::size_t budgetShare)
+            : budget(budgetShare * 1024, budgetShare)
+            , accumulator(options(), [this, &broker](ProducerBatchAccumulator::Batch&& batch) {
+                broker.produce(batch.partition, batch.records.size());
+                for (const auto& record : batch.records) {
+                    budget.release(record.key.size() + record.value.size());
+                }
+            })
+        {
+        }
+
+        static ProducerBatchAccumulator::Options options()
+        {
+            ProducerBatchAccumulator::Options result;
+            result.batchSize = 100;
+            result.linger = std::chrono::milliseconds(5);
+            result.partitionCount = kPartitions;
+            return result;
+        }
+
+        bool send(const std::string& key, const std::string& value)
+        {
+            const std::size_t bytes = key.size() + value.size();
+            if (!budget.acquire(bytes, std::chrono::milliseconds(1000))) {
+                return false;
+            }
+            return accumulator.append("user-events", key, pool.copyOf(value));
+        }
+
+        PayloadBufferPool pool;
+        InFlightBudget budget;
+        ProducerBatchAccumulator accumulator;
+    };
+
+    struct Result
+    {
+        double recordsPerSec = 0;
+        std::int64_t sendP99Ns = 0;
+    };
+
+    Result run(std::size_t threads, std::size_t shards, const std::vector<std::string>& keys,
+        const std::string& payload)
+    {
+        constexpr std::size_t kSampleEvery = 16;
+        BrokerStandIn broker;
+        std::vector<std::vector<std::int64_t>> samples(threads);
+        const auto start = Clock::now();
+        {
+            constexpr std::size_t kTotalBudgetRecords = 100000;
+            std::vector<std::unique_ptr<Shard>> pool;
+            for (std::size_t index = 0; index < shards; ++index) {
+                pool.push_back(std::make_unique<Shard>(broker, kTotalBudgetRecords / shards));
+            }
+            const ShardRouter router(shards);
+
+            std::vector<std::thread> publishers;
+            for (std::size_t thread = 0; thread < threads; ++thread) {
+                publishers.emplace_back([&, thread] {
+                    samples[thread].reserve(kRecordsPerThread / kSampleEvery + 1);
+                    for (std::size_t i = 0; i < kRecordsPerThread; ++i) {
+                        const auto& key = keys[(thread * kRecordsPerThread + i) % keys.size()];
+                        const auto sendStart = Clock::now();
+                        pool[router.shardFor(key)]->send(key, payload);
+                        if (i % kSampleEvery == 0) {
+                            samples[thread].push_back(elapsedNs(sendStart));
+                        }
+                    }
+                });
+            }
+            for (auto& publisher : publishers) {
+                publisher.join();
+            }
+            for (auto& shard : pool) {
+                shard->accumulator.flush();
+            }
+        }
+        const auto seconds = static_cast<double>(elapsedNs(start)) / 1e9;
+
+        std::vector<std::int64_t> all;
+        for (const auto& threadSamples : samples) {
+            all.insert(all.end(), threadSamples.begin(), threadSamples.end());
+        }
+        return {static_cast<double>(broker.totalRecords()) / seconds, percentile(all, 99.0)};
+    }
+}
+
+int main()
+{
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < kUsers; ++i) {
+        keys.push_back("user-" + std::to_string(i));
+    }
+    const std::string payload(kPayloadSize, 'x');
+
+    std::cout << "Publishing " << kRecordsPerThread << " records per thread, pool of "
+              << kPoolShards << " shards" << std::endl;
+
+    for (const std::size_t threads : {1, 2, 4, 8, 16, 32}) {
+        const auto single = run(threads, 1, keys, payload);
+        const auto pooled = run(threads, kPoolShards, keys, payload);
+        printRow("threads=" + std::to_string(threads) + " single", single.recordsPerSec, single.sendP99Ns);
+        printRow("threads=" + std::to_string(threads) + " pool", pooled.recordsPerSec, pooled.sendP99Ns);
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file UserEventDecodeBenchmark.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file compares decoding a whole user event payload with decoding the fields a handler reads
+ * * Each handler type reads a different part of the user: auditing the user ID, notification the
+ * * user ID, the email and the username, replay every field. Eagerly the payload is decoded whole
+ * * whatever the handler reads, with User::fromJson or user_service::User::ParseFromString;
+ * * through a UserEventView only as far as the last field the handler reads.
+ */
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/util/time_util.h>
+
+#include "BenchmarkUtils.h"
+#include "EventEnvelope.h"
+#include "User.h"
+#include "UserEventView.h"
+#include "userprofile.pb.h"
+
+namespace
+{
+    using namespace benchmark_utils;
+    using google::protobuf::util::TimeUtil;
+
+    constexpr std::size_t kEvents = 10000;
+    constexpr std::size_t kRounds = 20;
+
+    /**
+     * @brief A handler type and the fields it reads, from an eagerly decoded user and from a view
+     */
+    struct HandlerType
+    {
+        std::string name;
+        std::function<std::size_t(const User&)> readUser;
+        std::function<std::size_t(UserEventView&)> readView;
+    };
+
+    User makeUser(std::size_t i)
+    {
+        return User("6f1c2a4e-9b7d-4c3e-8a5f-" + std::to_string(100000000000 + i), "user" + std::to_string(i),
+            "user" + std::to_string(i) + "@example.com", "2026-10-16T08:00:00Z", "2026-10-16T09:30:00Z");
+    }
+
+    std::string toProtobuf(const User& user)
+    {
+        using namespace std::chrono;
+        const auto created = sys_days{year{2026} / 10 / 16} + hours(8);
+        const auto updated = created + minutes(90);
+
+        user_service::User message;
+        message.set_user_id(user.getUserId());
+        message.set_email(user.getEmail());
+        message.set_username(user.getUserName());
+        message.mutable_created_at()->set_seconds(duration_cast<seconds>(created.time_since_epoch()).count());
+        message.mutable_updated_at()->set_seconds(duration_cast<seconds>(updated.time_since_epoch()).count());
+        return message.SerializeAsString();
+    }
+
+    User fromProtobuf(const std::string& payload)
+    {
+        user_service::User message;
+        if (!message.ParseFromString(payload)) {
+            return User();
+        }
+        return User(message.user_id(), message.username(), message.email(), TimeUtil::ToString(message.created_at()),
+            TimeUtil::ToString(message.updated_at()));
+    }
+
+    void run(const std::string& name, const std::vector<std::string>& payloads,
+        const std::function<std::size_t(const std::string&)>& read)
+    {
+        std::size_t checksum = 0;
+        const auto start = Clock::now();
+        for (std::size_t round = 0; round < kRounds; ++round) {
+            for (const auto& payload : payloads) {
+                checksum += read(payload);
+            }
+        }
+        const auto elapsed = elapsedNs(start);
+        const double total = static_cast<double>(kRounds * payloads.size());
+        printRow(name, total * 1e9 / static_cast<double>(elapsed));
+        std::cout << std::left << std::setw(36) << "" << std::right << std::setprecision(1)
+                  << std::setw(14) << static_cast<double>(elapsed) / total << " ns/event"
+                  << "  (checksum " << checksum << ")" << std::endl;
+    }
+}
+
+int main()
+{
+    std::vector<std::string> json;
+    std::vector<std::string> protobuf;
+    std::vector<std::string> envelopes;
+    const auto now = EventEnvelope::Clock::now();
+    for (std::size_t i = 0; i < kEvents; ++i) {
+        User user = makeUser(i);
+        json.push_back(user.toJson());
+        protobuf.push_back(toProtobuf(user));
+        envelopes.push_back(EventEnvelope::encode(EventEnvelope::EventType::eUserUpdated, user.getUserId(), now,
+            json.back()));
+    }
+
+    // The checksums of a handler type match between the eager and the lazy rows
+    const std::vector<HandlerType> handlerTypes{
+        {"audit",
+            [](const User& user) { return user.getUserId().size(); },
+            [](UserEventView& view) { return view.getUserId().size(); }},
+        {"notification",
+            [](const User& user) { return user.getUserId().size() + user.getEmail().size() + user.getUserName().size(); },
+            [](UserEventView& view) { return view.getUserId().size() + view.getEmail().size() + view.getUserName().size(); }},
+        {"replay",
+            [](const User& user) { return user.getUserId().size() + user.getCreateAt().size() + user.getUpdateAt().size(); },
+            [](UserEventView& view) {
+                const User user = view.toUser();
+                return user.getUserId().size() + user.getCreateAt().size() + user.getUpdateAt().size();
+            }}};
+
+    for (const auto& handlerType : handlerTypes) {
+        run(handlerType.name + ", json, fromJson", json, [&](const std::string& payload) {
+            return handlerType.readUser(User().fromJson(payload));
+        });
+        run(handlerType.name + ", json, view", json, [&](const std::string& payload) {
+            UserEventView view(payload);
+            return handlerType.readView(view);
+        });
+        run(handlerType.name + ", envelope, view", envelopes, [&](const std::string& payload) {
+            UserEventView view(payload);
+            return handlerType.readView(view);
+        });
+        run(handlerType.name + ", protobuf, parse", protobuf, [&](const std::string& payload) {
+            return handlerType.readUser(fromProtobuf(payload));
+        });
+        run(handlerType.name + ", protobuf, view", protobuf, [&](const std::string& payload) {
+            UserEventView view(payload);
+            return handlerType.readView(view);
+        });
+    }
+    return 0;
+}
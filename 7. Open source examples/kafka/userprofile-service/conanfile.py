@@ -12,5 +12,8 @@ class ExampleRecipe(ConanFile):
         self.requires("protobuf/5.27.0")
         self.requires("sqlitecpp/3.3.2")
 
+    def build_requirements(self):
+        self.test_requires("gtest/1.14.0")
+
     def layout(self):
         cmake_layout(self)
\ No newline at end of file
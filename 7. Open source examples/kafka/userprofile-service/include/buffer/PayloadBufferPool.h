@@ -0,0 +1,116 @@
+/**
+ * @file PayloadBufferPool.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of PayloadBuffer and PayloadBufferPool classes
+ */
+
+#ifndef PAYLOAD_BUFFER_POOL_H
+#define PAYLOAD_BUFFER_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SharedPayload.h"
+
+/**
+ * @brief PayloadBuffer class
+ * A growable byte buffer handed out by PayloadBufferPool.
+ */
+class PayloadBuffer
+{
+public:
+    /**
+     * @brief Constructor with the capacity to reserve
+     * @param capacity The number of bytes to reserve
+     */
+    explicit PayloadBuffer(std::size_t capacity) { mData.reserve(capacity); }
+
+    /**
+     * @brief Get the buffer storage to write the payload into
+     */
+    std::string& data() { return mData; }
+
+    /**
+     * @brief Get the buffer content
+     */
+    std::string_view view() const { return mData; }
+
+private:
+    std::string mData;
+};
+
+using PayloadBufferPtr = std::shared_ptr<PayloadBuffer>; ///< Returned to its pool when the last reference is gone
+
+/**
+ * @brief PayloadBufferPool class
+ * This class recycles payload buffers so large payloads do not allocate on every send.
+ * The pool may be destroyed before the buffers it handed out, they are then freed normally.
+ */
+class PayloadBufferPool
+{
+public:
+    /**
+     * @brief Pool limits
+     * maxPooledBuffers bounds the free list, buffers above maxPooledCapacity are never kept.
+     */
+    struct Options
+    {
+        std::size_t maxPooledBuffers = 1024;
+        std::size_t maxPooledCapacity = 1 << 20;
+    };
+
+    /**
+     * @brief Constructor with default limits
+     */
+    PayloadBufferPool();
+
+    /**
+     * @brief Constructor with limits
+     * @param options The pool limits
+     */
+    explicit PayloadBufferPool(Options options);
+
+    /**
+     * @brief Get an empty buffer with at least the given capacity
+     * @param capacity The number of bytes the caller is about to write
+     * @return The buffer, it goes back to the pool when its last reference is released
+     */
+    PayloadBufferPtr acquire(std::size_t capacity);
+
+    /**
+     * @brief Copy bytes into a pooled buffer and expose them as a payload
+     * @param bytes The bytes to copy
+     * @return The payload which owns the pooled buffer
+     */
+    SharedPayload copyOf(std::string_view bytes);
+
+    /**
+     * @brief Expose a filled buffer as a payload
+     * The buffer must not be modified afterwards.
+     * @param buffer The buffer to share
+     * @return The payload which owns the buffer
+     */
+    static SharedPayload share(PayloadBufferPtr buffer);
+
+    /**
+     * @brief Get the number of buffers waiting in the free list
+     */
+    std::size_t pooledBuffers() const;
+
+private:
+    struct State
+    {
+        Options options;
+        std::mutex mutex;
+        std::vector<std::unique_ptr<PayloadBuffer>> freeList;
+    };
+
+    std::shared_ptr<State> mState;
+};
+
+#endif // PAYLOAD_BUFFER_POOL_H
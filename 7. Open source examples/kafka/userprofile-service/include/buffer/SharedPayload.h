@@ -0,0 +1,81 @@
+/**
+ * @file SharedPayload.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of SharedPayload class
+ */
+
+#ifndef SHARED_PAYLOAD_H
+#define SHARED_PAYLOAD_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief SharedPayload class
+ * A read-only view of payload bytes together with the reference that keeps them alive.
+ * Copying a SharedPayload never copies the bytes, the owner is released with the last copy.
+ */
+class SharedPayload
+{
+public:
+    /**
+     * @brief Default constructor, an empty payload
+     */
+    SharedPayload() = default;
+
+    /**
+     * @brief Constructor with a view and its owner
+     * @param view The payload bytes
+     * @param owner The object which keeps the bytes alive, may be null for static storage
+     */
+    SharedPayload(std::string_view view, std::shared_ptr<const void> owner)
+        : mView(view)
+        , mOwner(std::move(owner))
+    {
+    }
+
+    /**
+     * @brief Take ownership of a string and expose it as a payload
+     * @param bytes The string to own
+     * @return The payload which owns the string
+     */
+    static SharedPayload fromString(std::string bytes)
+    {
+        auto owner = std::make_shared<const std::string>(std::move(bytes));
+        const std::string_view view = *owner;
+        return SharedPayload(view, std::move(owner));
+    }
+
+    /**
+     * @brief Get the payload bytes
+     */
+    std::string_view view() const { return mView; }
+
+    /**
+     * @brief Get the payload size in bytes
+     */
+    std::size_t size() const { return mView.size(); }
+
+    /**
+     * @brief Check whether the payload is empty
+     */
+    bool empty() const { return mView.empty(); }
+
+    /**
+     * @brief Release the reference to the payload bytes
+     */
+    void reset()
+    {
+        mView = {};
+        mOwner.reset();
+    }
+
+private:
+    std::string_view mView;
+    std::shared_ptr<const void> mOwner;
+};
+
+#endif // SHARED_PAYLOAD_H
@@ -14,6 +14,7 @@
 #include <optional>
 
 #include "TopicConfig.h"
+#include "utils.h"
 
 /**
  * @brief ServiceConfig class
@@ -23,11 +24,16 @@
  */
 class ServiceConfig
 {
+public:
+    using BackpressurePolicy = user_profile::utils::producer::BackpressurePolicy;
+    using DispatchOrdering = user_profile::utils::consumer::DispatchOrdering;
+
 private:
     /// @brief Kafka configuration
     std::string mKafkaBroker;
     std::string mKafkaGroupId;
     std::string mKafkaClientId;
+    std::string mKafkaTransactionalId;
 
     /// @brief  Database configuration
     std::string mDatabaseUrl;
@@ -49,10 +55,35 @@ private:
 
     /// @brief performance settings
     int mProducerBatchSize;
+    int mProducerLingerMs;
+    int mProducerShards;
     int mConsumerPollTimeout;
+    int mConsumerMinPollTimeout;
+    int mConsumerMaxPollRecords;
     int mEventHandlerThreads;
+    int mEventFanOutThreads;
+    int mConsumerWorkerQueueCapacity;
+    int mConsumerQueueHighWatermark;
+    int mConsumerQueueLowWatermark;
+    DispatchOrdering mConsumerDispatchOrdering;
+    int mConsumerCommitEveryRecords;
+    int mConsumerCommitIntervalMs;
+    int mConsumerMetricsIntervalMs;
+    std::size_t mConsumerDedupMaxBytes;
+    int mConsumerRetryMaxAttempts;
+    int mConsumerRetryInitialBackoffMs;
+    int mConsumerRetryMaxBackoffMs;
+    std::size_t mConsumerRetryMaxEvents;
+    std::size_t mConsumerRetryMaxBytes;
     bool mEnableIdempotence;
 
+    /// @brief producer backpressure settings
+    std::size_t mProducerMaxInFlightBytes;
+    std::size_t mProducerMaxInFlightRecords;
+    BackpressurePolicy mProducerBackpressurePolicy;
+    int mProducerBlockTimeoutMs;
+    std::unordered_map<std::string, int> mTopicPriorities;
+
 public:
     /// @brief Constructor and Destructor
     ServiceConfig();
@@ -77,12 +108,28 @@ public:
     [[nodiscard]] const std::string& getKafkaBroker() const;
     [[nodiscard]] const std::string& getKafkaGroupId() const;
     [[nodiscard]] const std::string& getKafkaClientId() const;
+    [[nodiscard]] const std::string& getKafkaTransactionalId() const;
+    [[nodiscard]] bool isIdempotenceEnabled() const;
 
     // Kafka setters
     void setKafkaBroker(const std::string& broker);
     void setKafkaGroupId(const std::string& groupId);
     void setKafkaClientId(const std::string& clientId);
 
+    /**
+     * @brief Set the transactional id of the producer
+     * A non-empty id turns on transactions, which also implies idempotence.
+     * It must be unique per producer instance and stable across restarts.
+     * @param transactionalId Transactional id, empty to disable transactions
+     */
+    void setKafkaTransactionalId(const std::string& transactionalId);
+
+    /**
+     * @brief Enable or disable the idempotent producer
+     * @param enable true to let the broker drop duplicates caused by producer retries
+     */
+    void setEnableIdempotence(bool enable);
+
     // Service getters
     [[nodiscard]] const std::string& getServiceName() const;
     [[nodiscard]] const std::string& getServiceVersion() const;
@@ -113,6 +160,173 @@ public:
      */
     void setLogLevel(const std::string& level);
 
+    // Performance getters
+    [[nodiscard]] int getProducerBatchSize() const;
+    [[nodiscard]] int getProducerLingerMs() const;
+    [[nodiscard]] int getProducerShards() const;
+    [[nodiscard]] int getEventHandlerThreads() const;
+    [[nodiscard]] int getEventFanOutThreads() const;
+    [[nodiscard]] int getConsumerPollTimeout() const;
+    [[nodiscard]] int getConsumerMinPollTimeout() const;
+    [[nodiscard]] int getConsumerMaxPollRecords() const;
+    [[nodiscard]] int getConsumerWorkerQueueCapacity() const;
+    [[nodiscard]] int getConsumerQueueHighWatermark() const;
+    [[nodiscard]] int getConsumerQueueLowWatermark() const;
+    [[nodiscard]] DispatchOrdering getConsumerDispatchOrdering() const;
+    [[nodiscard]] int getConsumerCommitEveryRecords() const;
+    [[nodiscard]] int getConsumerCommitIntervalMs() const;
+    [[nodiscard]] int getConsumerMetricsIntervalMs() const;
+    [[nodiscard]] std::size_t getConsumerDedupMaxBytes() const;
+    [[nodiscard]] int getConsumerRetryMaxAttempts() const;
+    [[nodiscard]] int getConsumerRetryInitialBackoffMs() const;
+    [[nodiscard]] int getConsumerRetryMaxBackoffMs() const;
+    [[nodiscard]] std::size_t getConsumerRetryMaxEvents() const;
+    [[nodiscard]] std::size_t getConsumerRetryMaxBytes() const;
+
+    // Backpressure getters
+    [[nodiscard]] std::size_t getProducerMaxInFlightBytes() const;
+    [[nodiscard]] std::size_t getProducerMaxInFlightRecords() const;
+    [[nodiscard]] BackpressurePolicy getProducerBackpressurePolicy() const;
+    [[nodiscard]] int getProducerBlockTimeoutMs() const;
+
+    /**
+     * @brief Get the priority of a topic, used by BackpressurePolicy::eDropLowestPriority
+     * @param topic Topic name
+     * @return The configured priority, 0 if none was set
+     */
+    [[nodiscard]] int getTopicPriority(const std::string& topic) const;
+
+    /**
+     * @brief Bound the data the producer holds before the broker acknowledged it
+     * Records queued in the batch accumulator and records inside the Kafka client both count.
+     * @param maxBytes Maximum key and value bytes
+     * @param maxRecords Maximum number of records
+     */
+    void setProducerInFlightBudget(std::size_t maxBytes, std::size_t maxRecords);
+
+    /**
+     * @brief Set what sendMessage does when the in-flight budget is exhausted
+     * @param policy The backpressure policy
+     * @param blockTimeoutMs How long eBlock waits before refusing the record
+     */
+    void setProducerBackpressurePolicy(BackpressurePolicy policy, int blockTimeoutMs);
+
+    /**
+     * @brief Set the priority of a topic, records of lower priority topics are dropped first
+     * @param topic Topic name
+     * @param priority Priority, higher is more important
+     */
+    void setTopicPriority(const std::string& topic, int priority);
+
+    /**
+     * @brief Set the number of records a producer batch holds before it is sent
+     * @param batchSize Maximum records per topic-partition batch
+     */
+    void setProducerBatchSize(int batchSize);
+
+    /**
+     * @brief Set how long a partially filled producer batch may wait before it is sent
+     * @param lingerMs Linger time in milliseconds, 0 sends on every poll of the sender
+     */
+    void setProducerLingerMs(int lingerMs);
+
+    /**
+     * @brief Set the number of producer instances a ProducerPool spreads publishers over
+     * @param shards Number of shards, must be greater than 0
+     */
+    void setProducerShards(int shards);
+
+    /**
+     * @brief Set the number of threads which handle events
+     * @param threads Number of threads, must be greater than 0
+     */
+    void setEventHandlerThreads(int threads);
+
+    /**
+     * @brief Set the number of threads the handlers of an event are fanned out on
+     * The threads are shared by every event handler thread.
+     * @param threads Number of threads, 0 runs the handlers of an event one after another and
+     *        does not enforce their timeouts
+     */
+    void setEventFanOutThreads(int threads);
+
+    /**
+     * @brief Set the bounds of the adaptive consumer poll timeout
+     * The consumer polls with the short timeout while records flow and backs off towards the
+     * long one while the topics are idle.
+     * @param minTimeoutMs Timeout while records flow in milliseconds, must not be negative
+     * @param maxTimeoutMs Timeout while idle in milliseconds, must not be lower than minTimeoutMs
+     */
+    void setConsumerPollTimeoutBounds(int minTimeoutMs, int maxTimeoutMs);
+
+    /**
+     * @brief Set the most records a single consumer poll returns
+     * @param maxRecords Records per poll, must be greater than 0
+     */
+    void setConsumerMaxPollRecords(int maxRecords);
+
+    /**
+     * @brief Set how many consumed events a handler thread may queue before the consumer waits
+     * @param capacity Queue capacity per handler thread, must be greater than 0
+     */
+    void setConsumerWorkerQueueCapacity(int capacity);
+
+    /**
+     * @brief Set when the consumer pauses and resumes the partitions of a handler thread
+     * Partitions are paused once the queue of their handler thread holds highWatermark events
+     * and resumed once it is down to lowWatermark. The consumer keeps polling while paused.
+     * @param highWatermark Queued events which pause, keep it a poll batch below the queue capacity
+     *                      so a poll never has to wait for queue space
+     * @param lowWatermark Queued events which resume, must be lower than highWatermark
+     */
+    void setConsumerQueueWatermarks(int highWatermark, int lowWatermark);
+
+    /**
+     * @brief Set which records the consumer keeps on the same handler thread
+     * @param ordering ePartition keeps every partition in order, eKey only every key
+     */
+    void setConsumerDispatchOrdering(DispatchOrdering ordering);
+
+    /**
+     * @brief Set how often the consumer commits the offsets of handled records
+     * A commit runs when either limit is reached, whichever comes first.
+     * @param everyRecords Handled records between two commits, must be greater than 0
+     * @param intervalMs Longest time between two commits in milliseconds, must be greater than 0
+     */
+    void setConsumerCommitCadence(int everyRecords, int intervalMs);
+
+    /**
+     * @brief Set how often the consumer publishes a metrics snapshot
+     * Every snapshot asks the brokers for the log end offsets to compute the lag.
+     * @param intervalMs Interval in milliseconds, must be greater than 0
+     */
+    void setConsumerMetricsIntervalMs(int intervalMs);
+
+    /**
+     * @brief Set the memory the consumer spends remembering handled events to skip redeliveries
+     * @param maxBytes Memory bound in bytes, 0 disables deduplication
+     */
+    void setConsumerDedupMaxBytes(std::size_t maxBytes);
+
+    /**
+     * @brief Set how often and how fast failed events are retried before they are dead-lettered
+     * The delay doubles after every failed attempt, starting at initialBackoffMs. Dead-lettering needs
+     * TopicConfig::setDeadLetterEvents and KafkaMessageConsumer::setDeadLetterSink. Without them an
+     * event which ran out of attempts is never skipped: the committed offset of its partition holds at
+     * it until a rebalance or restart consumes it again. That is the default, no event is lost silently.
+     * @param maxAttempts Handler attempts including the first one, must be greater than 0
+     * @param initialBackoffMs Delay before the first retry in milliseconds, must be greater than 0
+     * @param maxBackoffMs Longest delay between two attempts, must not be less than initialBackoffMs
+     */
+    void setConsumerRetryBackoff(int maxAttempts, int initialBackoffMs, int maxBackoffMs);
+
+    /**
+     * @brief Set the memory bound of the retry queue, failed events beyond it are dead-lettered at once
+     * @param maxEvents Events waiting for a retry, must be greater than 0
+     * @param maxBytes Estimated memory of those events in bytes, must be greater than 0
+     */
+    void setConsumerRetryLimits(std::size_t maxEvents, std::size_t maxBytes);
+
     /**
      * @brief Get the topic configuration
      * @return Reference to the TopicConfig object
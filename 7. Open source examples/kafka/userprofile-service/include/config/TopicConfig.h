@@ -48,6 +48,12 @@ public:
      */
     [[nodiscard]] const std::string& getAuditEvents() const;
 
+    /**
+     * @brief Get the topic name for events which kept failing their handlers
+     * @return The dead-letter topic name, empty by default so failed events hold their offsets
+     */
+    [[nodiscard]] const std::string& getDeadLetterEvents() const;
+
     /**
      * @brief Set the topic name for user events
      * @param topic The topic name for user events
@@ -72,12 +78,34 @@ public:
      */
     void setAuditEvents(const std::string& topic);
 
+    /**
+     * @brief Set the topic name for events which kept failing their handlers
+     * @param topic The dead-letter topic name
+     */
+    void setDeadLetterEvents(const std::string& topic);
+
+    /**
+     * @brief Get the number of partitions of each topic
+     * @return The partition count, 1 lets the client choose the partition
+     */
+    [[nodiscard]] int getPartitionCount() const;
+
+    /**
+     * @brief Set the number of partitions of each topic
+     * @param partitionCount The partition count, must be greater than 0
+     */
+    void setPartitionCount(int partitionCount);
+
 private:
     /// @brief Topic names
     std::string mUserEvents;
     std::string mOrderEvents;
     std::string mNotificationEvents;
     std::string mAuditEvents;
+    std::string mDeadLetterEvents;
+
+    /// @brief Topic layout
+    int mPartitionCount = 1;
 };
 
 #endif // TOPIC_CONFIG_H
\ No newline at end of file
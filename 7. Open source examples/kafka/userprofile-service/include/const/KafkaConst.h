@@ -9,6 +9,7 @@
 #define KAFKA_CONST_H
 
 #include <map>
+#include <string>
 
 namespace kafka_const 
 {
@@ -18,6 +19,12 @@ namespace kafka_const
         {"broker2", "localhost:9093"},
         {"broker3", "localhost:9094"}
     };
+
+    // Record header which carries the numeric EventType of a record
+    const std::string kEventTypeHeader = "event-type";
+
+    // Record header which carries a producer assigned unique event identifier
+    const std::string kEventIdHeader = "event-id";
 };
 
 #endif // KAFKA_CONST_H
@@ -9,6 +9,7 @@
 #define USER_H
 
 #include <string>
+#include <string_view>
 
 #include <nlohmann/json.hpp>
 
@@ -22,7 +23,7 @@ public:
     ~User();
 
     std::string toJson();
-    User fromJson(std::string const &jsonStr);
+    User fromJson(std::string_view jsonStr);
     bool isValid();
 
     std::string getUserId() const;
@@ -8,21 +8,31 @@
 #ifndef EVENT_H
 #define EVENT_H
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 
+#include "SharedPayload.h"
 #include "utils.h"
 
 /**
  * @class Event
  * @brief The Event class represents a generic event with a payload.
  *
- * This class provides a way to encapsulate an event with a string payload.
- * It includes methods to set the payload and a default constructor and destructor.
+ * This class provides a way to encapsulate an event with a payload.
+ * The payload is either an owned copy or a view into a shared buffer, such as the consumed
+ * record batch, so consuming a record does not have to copy its value.
+ * The identifier, key and topic work the same way: shareFields() points them into a buffer
+ * such as the poll batch, the setters copy them into one small block the event owns.
+ * Copying an event never copies any of these bytes.
  */
 class Event
 {
 public:
     using EventType = user_profile::utils::event::EventType; ///< Alias for EventType from utils
+    using Clock = std::chrono::steady_clock;                 ///< Clock of the receive time
 
     /**
      * @brief Default constructor for Event class
@@ -40,17 +50,41 @@ public:
      */
     virtual ~Event() = default;
 
+    Event(const Event&) = default;
+    Event& operator=(const Event&) = default;
+    Event(Event&&) = default;            // events are moved through the dispatcher queues
+    Event& operator=(Event&&) = default;
+
     /**
-     * @brief Set payload of the event
+     * @brief Set payload of the event, the bytes are copied
      * @param payload The payload to set
      */
     void setPayload(std::string const &payload);
 
+    /**
+     * @brief Set payload of the event without copying it
+     * @param payload The payload bytes and their owner, normally the record batch or a pooled buffer
+     */
+    void setPayload(SharedPayload payload);
+
     /**
      * @brief Get payload of the event
-     * @return The payload of the event
+     * @return A view of the payload, valid while this event or a copy of it lives
+     */
+    std::string_view getPayload() const;
+
+    /**
+     * @brief Get payload of the event together with its owner, to pass it on without a copy
+     * @return The shared payload
      */
-    std::string const &getPayload() const;
+    SharedPayload const &getSharedPayload() const;
+
+    /**
+     * @brief Replace a shared payload and shared fields by owned copies
+     * A view keeps its whole buffer alive. Events which outlive their poll batch, such as
+     * retried events, call this so they only hold their own bytes.
+     */
+    void ownPayload();
 
     /**
      * @brief Get the type of the event
@@ -64,9 +98,105 @@ public:
      */
     void setType(EventType type);
 
+    /**
+     * @brief Set the identifier the producer gave the event
+     * @param id The event identifier
+     */
+    void setId(std::string_view id);
+
+    /**
+     * @brief Get the identifier the producer gave the event
+     * @return The event identifier, empty if the record had none
+     */
+    std::string_view getId() const;
+
+    /**
+     * @brief Set the key of the record the event was read from
+     * @param key The record key
+     */
+    void setKey(std::string_view key);
+
+    /**
+     * @brief Get the key of the record the event was read from
+     * @return The record key, empty if the record had none
+     */
+    std::string_view getKey() const;
+
+    /**
+     * @brief Set the identifier, key and topic without copying them
+     * @param id The event identifier
+     * @param key The record key
+     * @param topic The topic of the record
+     * @param owner The object which keeps the bytes of all three alive, normally the poll batch
+     */
+    void shareFields(std::string_view id, std::string_view key, std::string_view topic,
+        std::shared_ptr<const void> owner);
+
+    /**
+     * @brief Set where the event was read from
+     * @param topic The topic of the record
+     * @param partition The partition of the record
+     * @param offset The offset of the record
+     */
+    void setSource(std::string_view topic, int32_t partition, int64_t offset);
+
+    /**
+     * @brief Set the partition and offset the event was read from, keeping its topic
+     * @param partition The partition of the record
+     * @param offset The offset of the record
+     */
+    void setPosition(int32_t partition, int64_t offset);
+
+    /**
+     * @brief Get the topic the event was read from
+     */
+    std::string_view getTopic() const;
+
+    /**
+     * @brief Get the partition the event was read from, -1 if it was not read from Kafka
+     */
+    int32_t getPartition() const;
+
+    /**
+     * @brief Get the offset the event was read from, -1 if it was not read from Kafka
+     */
+    int64_t getOffset() const;
+
+    /**
+     * @brief Set when the consumer received the event
+     * @param receivedAt The time the poll returned the record
+     */
+    void setReceivedAt(Clock::time_point receivedAt);
+
+    /**
+     * @brief Get when the consumer received the event
+     * @return The receive time, the epoch of Clock if the event was not consumed
+     */
+    Clock::time_point getReceivedAt() const;
+
 private:
-    std::string mPayload; ///< The payload of the event
+    struct OwnedFields
+    {
+        std::string id;
+        std::string key;
+        std::string topic;
+    };
+
+    /**
+     * @brief Get the owned block of the fields, copying them into a new one if they are shared
+     */
+    OwnedFields& ownFields();
+
+    SharedPayload mPayload; ///< The payload of the event
     EventType mType = EventType::eUnknown;      ///< The type of the event
+    std::shared_ptr<const void> mFieldsOwner; ///< Keeps the bytes of mId, mKey and mTopic alive
+    OwnedFields* mOwnedFields = nullptr;      ///< mFieldsOwner if it is a block of this event
+    std::string_view mId;    ///< The identifier the producer gave the event
+    std::string_view mKey;   ///< The key of the source record
+    std::string_view mTopic; ///< The topic of the source record
+    int32_t mPartition = -1; ///< The partition of the source record
+    int64_t mOffset = -1;    ///< The offset of the source record
+    Clock::time_point mReceivedAt; ///< When the consumer received the source record
 };
 
 #endif // EVENT_H
\ No newline at end of file
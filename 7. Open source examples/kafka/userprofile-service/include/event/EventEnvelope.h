@@ -0,0 +1,114 @@
+/**
+ * @file EventEnvelope.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of EventEnvelope class
+ * * The envelope is the flat binary layout of an event payload: a fixed size header with the
+ * * fields routing and auditing need, followed by the user ID and the payload, read in place.
+ */
+
+#ifndef EVENT_ENVELOPE_H
+#define EVENT_ENVELOPE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "utils.h"
+
+/**
+ * @brief EventEnvelope class
+ * Layout of version 1, every integer little endian:
+ *
+ *   offset  size  field
+ *        0     4  magic "UPEV"
+ *        4     2  version
+ *        6     2  header size, where the user ID starts
+ *        8     2  event type
+ *       10     2  user ID size
+ *       12     4  payload size
+ *       16     8  timestamp, milliseconds since the Unix epoch
+ *       24        user ID, then payload
+ *
+ * The header fields sit at fixed offsets, so reading them costs a few loads and no parsing.
+ * Later versions may only append header fields, so a reader takes any version and skips the
+ * fields it does not know by the header size.
+ * An envelope is a view: it does not copy the bytes and must not outlive them.
+ */
+class EventEnvelope
+{
+public:
+    using EventType = user_profile::utils::event::EventType;
+    using Clock = std::chrono::system_clock;
+
+    static constexpr std::uint16_t kVersion = 1;
+    static constexpr std::size_t kHeaderSize = 24;
+    static constexpr std::size_t kMaxUserIdSize = 0xffff;
+
+    /**
+     * @brief Append an envelope to a buffer
+     * Lets a producer reuse one buffer for every event it encodes.
+     * @param out The buffer
+     * @param type The event type
+     * @param userId The ID of the user the event is about, at most kMaxUserIdSize bytes
+     * @param timestamp When the event happened
+     * @param payload The payload, stored as is
+     * @return false if the user ID or the payload is too large, out is left unchanged then
+     */
+    static bool encodeTo(std::string& out, EventType type, std::string_view userId, Clock::time_point timestamp,
+        std::string_view payload);
+
+    /**
+     * @brief Encode an envelope
+     * @return The envelope, empty if the user ID or the payload is too large
+     */
+    static std::string encode(EventType type, std::string_view userId, Clock::time_point timestamp,
+        std::string_view payload);
+
+    /**
+     * @brief Check the magic only, to tell envelopes from older payloads such as plain JSON
+     */
+    static bool isEnvelope(std::string_view bytes);
+
+    /**
+     * @brief Read an envelope in place
+     * @param bytes The encoded envelope, must outlive the result
+     * @return The envelope, nullopt if the bytes are no envelope or are truncated
+     */
+    static std::optional<EventEnvelope> read(std::string_view bytes);
+
+    /**
+     * @brief Get the envelope version the bytes were written with
+     */
+    std::uint16_t getVersion() const;
+
+    /**
+     * @brief Get the event type
+     */
+    EventType getType() const;
+
+    /**
+     * @brief Get the ID of the user the event is about, a view into the envelope
+     */
+    std::string_view getUserId() const;
+
+    /**
+     * @brief Get when the event happened
+     */
+    Clock::time_point getTimestamp() const;
+
+    /**
+     * @brief Get the payload, a view into the envelope
+     */
+    std::string_view getPayload() const;
+
+private:
+    explicit EventEnvelope(std::string_view bytes);
+
+    std::string_view mBytes; ///< The whole envelope, validated by read()
+};
+
+#endif // EVENT_ENVELOPE_H
@@ -0,0 +1,144 @@
+/**
+ * @file UserEventView.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of UserEventView class
+ * * The view decodes the fields of a user event payload one at a time, on first access, so a
+ * * handler which needs the user ID only does not pay for the username, the email or the dates.
+ */
+
+#ifndef USER_EVENT_VIEW_H
+#define USER_EVENT_VIEW_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class User;
+
+/**
+ * @brief UserEventView class
+ * Reads a user_service.User payload encoded as JSON, as User::toJson writes it, or as protobuf,
+ * see config/proto/userprofile.proto. An EventEnvelope is unwrapped first and its header user ID
+ * answers getUserId() without touching the payload.
+ *
+ * The payload is scanned front to back only as far as the requested field, skipping the values
+ * of the others, and the scan resumes there for the next field. A field is decoded once: JSON
+ * strings without escapes and protobuf strings are views into the payload, JSON strings with
+ * escapes and protobuf timestamps are decoded into the view and cached.
+ *
+ * A field the payload lacks, or holds with another type, reads as empty, like User::fromJson.
+ * A field the payload repeats resolves to its first occurrence, so the view can stop there.
+ * This differs from User::fromJson and ParseFromString, which keep the last occurrence, and
+ * ParseFromString merges repeated Timestamp messages; User::toJson and the producers never
+ * repeat a field. The view does not copy the payload and must not outlive it; it is not
+ * thread safe, one view per thread.
+ */
+class UserEventView
+{
+public:
+    /**
+     * @brief Payload encoding
+     */
+    enum class Encoding
+    {
+        eJson,
+        eProtobuf
+    };
+
+    /**
+     * @brief Constructor for UserEventView class
+     * Nothing is decoded yet. The encoding is JSON if the payload starts with '{' after
+     * whitespace, protobuf otherwise.
+     * @param payload An event payload or an EventEnvelope, must outlive the view
+     */
+    explicit UserEventView(std::string_view payload);
+
+    UserEventView(const UserEventView&) = delete;
+    UserEventView& operator=(const UserEventView&) = delete;
+
+    /**
+     * @brief Get the encoding of the payload
+     */
+    Encoding getEncoding() const;
+
+    /**
+     * @brief Check that the payload scanned so far is well formed
+     * A malformed payload stops the scan, the fields behind the error read as empty.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Get the user ID, valid as long as the view and the payload
+     */
+    std::string_view getUserId();
+
+    /**
+     * @brief Get the username, valid as long as the view and the payload
+     */
+    std::string_view getUserName();
+
+    /**
+     * @brief Get the email, valid as long as the view and the payload
+     */
+    std::string_view getEmail();
+
+    /**
+     * @brief Get the creation date, valid as long as the view and the payload
+     * A protobuf Timestamp reads as RFC 3339 in UTC, as in its JSON mapping.
+     */
+    std::string_view getCreateAt();
+
+    /**
+     * @brief Get the last update date, see getCreateAt()
+     */
+    std::string_view getUpdateAt();
+
+    /**
+     * @brief Decode every field into a User
+     * The scan runs to the end of the payload, check isValid() afterwards.
+     */
+    User toUser();
+
+private:
+    enum Field : std::size_t
+    {
+        eUserId,
+        eEmail,
+        eUserName,
+        eCreateAt,
+        eUpdateAt,
+        eFieldCount
+    };
+
+    enum class State : std::uint8_t
+    {
+        eUnseen,  ///< Not reached by the scan yet
+        eRaw,     ///< Located, raw holds the encoded value
+        eDecoded  ///< value holds the decoded value
+    };
+
+    struct Slot
+    {
+        State state = State::eUnseen;
+        std::string_view raw;   // the encoded value, JSON string contents or protobuf bytes
+        std::string_view value; // the decoded value, into the payload or into decoded
+        std::string decoded;    // owns the value when it had to be unescaped or formatted
+    };
+
+    std::string_view get(Field field);
+    void decode(Field field);
+    bool scanJson();
+    bool scanProtobuf();
+
+    std::string_view mPayload;
+    std::size_t mCursor = 0; // where the scan resumes
+    Encoding mEncoding = Encoding::eJson;
+    bool mDone = false;      // the scan reached the end of the payload or an error
+    bool mValid = true;
+    std::array<Slot, eFieldCount> mSlots;
+};
+
+#endif // USER_EVENT_VIEW_H
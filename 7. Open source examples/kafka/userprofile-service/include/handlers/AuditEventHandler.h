@@ -8,20 +8,36 @@
 #ifndef AUDIT_EVENT_HANDLER_H
 #define AUDIT_EVENT_HANDLER_H
 
+#include <functional>
+#include <string_view>
+
 #include "Handler.h"
 
 /**
  * @brief AuditEventHandler class
  * This class is responsible for handling audit events.
  * It inherits from the Handler class and overrides the handleEvent method.
+ * Every batch becomes one line per event, written to the audit sink in a single call.
  */
 class AuditEventHandler : public Handler
 {
 public:
     /**
-     * @brief Default constructor for AuditEventHandler class
+     * @brief Every event is audited, see StaticHandlerTable
+     */
+    static constexpr user_profile::utils::event::EventTypeMask kEventTypes = user_profile::utils::event::kAllEventTypes;
+
+    /**
+     * @brief Appends audit lines to the audit log
+     * @return true if the lines were stored, false to fail every event of the batch
      */
-    AuditEventHandler() = default;
+    using AuditSink = std::function<bool(std::string_view lines)>;
+
+    /**
+     * @brief Constructor for AuditEventHandler class
+     * @param sink Where the audit lines go, the service log when empty
+     */
+    explicit AuditEventHandler(AuditSink sink = {});
 
     /**
      * @brief Default destructor for AuditEventHandler class
@@ -35,6 +51,16 @@ public:
      * @return true if the event was handled successfully, false otherwise
      */
     virtual bool handleEvent(const Event& event) override;
+
+    /**
+     * @brief Handle a batch of events
+     * @param events The events to handle
+     * @return The indexes of the events which were not handled
+     */
+    virtual std::vector<std::size_t> handleEvents(std::span<const Event> events) override;
+
+private:
+    AuditSink mSink;
 };
 
 #endif // AUDIT_EVENT_HANDLER_H
@@ -8,7 +8,11 @@
 #ifndef HANDLER_H
 #define HANDLER_H
 
-struct Event;
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Event.h"
 
 /**
  * @brief Handler class
@@ -35,6 +39,25 @@ public:
      * @return true if the event was handled successfully, false otherwise
      */
     virtual bool handleEvent(const Event& event) = 0;
+
+    /**
+     * @brief Handle a batch of events
+     * The consumer calls this method once per poll batch of a handler thread, so a handler can
+     * amortize work such as a database transaction over the whole batch.
+     * The default implementation calls handleEvent for every event in order.
+     * @param events The events, in offset order per partition
+     * @return The indexes of the events which were not handled, empty if all were handled
+     */
+    virtual std::vector<std::size_t> handleEvents(std::span<const Event> events)
+    {
+        std::vector<std::size_t> failed;
+        for (std::size_t index = 0; index < events.size(); ++index) {
+            if (!handleEvent(events[index])) {
+                failed.push_back(index);
+            }
+        }
+        return failed;
+    }
 };
 
 #endif // HANDLER_H
\ No newline at end of file
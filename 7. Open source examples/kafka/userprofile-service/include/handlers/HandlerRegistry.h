@@ -0,0 +1,113 @@
+/**
+ * @file HandlerRegistry.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of HandlerRegistry class
+ */
+
+#ifndef HANDLER_REGISTRY_H
+#define HANDLER_REGISTRY_H
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Event.h"
+#include "Handler.h"
+#include "utils.h"
+
+/**
+ * @brief A handler class which declares the events it takes, as StaticHandlerTable expects
+ */
+template <typename HandlerType>
+concept DeclaresEventTypes = std::derived_from<HandlerType, Handler> && requires {
+    { HandlerType::kEventTypes } -> std::convertible_to<user_profile::utils::event::EventTypeMask>;
+};
+
+/**
+ * @brief HandlerRegistry class
+ * Maps every event type to the handlers registered for it, so routing an event is an array
+ * index instead of a call into every handler. Types with the same handlers share a route, and
+ * a batch is handed to the handlers of a route in runs of consecutive events with that route.
+ * When every handler takes every type there is a single route and a batch stays in one piece.
+ * Types beyond the known range are routed like EventType::eUnknown.
+ * The registry is built at startup and only read afterwards, reading needs no lock.
+ */
+class HandlerRegistry
+{
+public:
+    using EventType = Event::EventType;
+    using EventTypeMask = user_profile::utils::event::EventTypeMask;
+    using Handlers = std::vector<std::shared_ptr<Handler>>;
+
+    /**
+     * @brief Default constructor, every type routes to no handler
+     */
+    HandlerRegistry();
+
+    /**
+     * @brief Register a handler for some event types
+     * Handlers of a type are called in registration order.
+     * @param handler The handler, ignored if null
+     * @param types The types the handler receives
+     */
+    void add(std::shared_ptr<Handler> handler, EventTypeMask types = user_profile::utils::event::kAllEventTypes);
+
+    /**
+     * @brief Register a handler for the event types its class declares in kEventTypes
+     * @param handler The handler, ignored if null
+     */
+    template <DeclaresEventTypes HandlerType>
+    void add(std::shared_ptr<HandlerType> handler)
+    {
+        add(std::shared_ptr<Handler>(std::move(handler)), HandlerType::kEventTypes);
+    }
+
+    /**
+     * @brief Get the route of an event type
+     * @param type The event type
+     * @return The route, an index for handlers()
+     */
+    std::size_t routeOf(EventType type) const
+    {
+        const auto index = static_cast<std::size_t>(type);
+        return mRouteOf[index < mRouteOf.size() ? index : 0];
+    }
+
+    /**
+     * @brief Get the handlers of a route
+     * @param route The route from routeOf()
+     * @return The handlers, empty if no handler takes the types of the route
+     */
+    const Handlers& handlers(std::size_t route) const
+    {
+        return mRoutes[route];
+    }
+
+    /**
+     * @brief Get the handlers of an event type
+     * @param type The event type
+     * @return The handlers
+     */
+    const Handlers& handlersFor(EventType type) const
+    {
+        return mRoutes[routeOf(type)];
+    }
+
+    /**
+     * @brief Check whether no handler is registered
+     */
+    bool empty() const;
+
+private:
+    void rebuildRoutes();
+
+    std::array<Handlers, user_profile::utils::event::kEventTypeCount> mByType;
+    std::array<std::uint8_t, user_profile::utils::event::kEventTypeCount> mRouteOf{};
+    std::vector<Handlers> mRoutes; // distinct handler lists, mRoutes[mRouteOf[type]] are those of type
+};
+
+#endif // HANDLER_REGISTRY_H
@@ -18,6 +18,12 @@
 class NotificationEventHandler : public Handler
 {
 public:
+    /**
+     * @brief The events users are notified about, see StaticHandlerTable
+     */
+    static constexpr user_profile::utils::event::EventTypeMask kEventTypes = user_profile::utils::event::eventTypeMask(
+        Event::EventType::eUserCreated, Event::EventType::eUserUpdated, Event::EventType::eUserDeleted);
+
     /**
      * @brief Default constructor for NotificationEventHandler class
      */
@@ -35,6 +41,13 @@ public:
      * @return true if the event was handled successfully, false otherwise
      */
     virtual bool handleEvent(const Event& event) override;
+
+    /**
+     * @brief Handle a batch of events
+     * @param events The events to handle
+     * @return The indexes of the events which were not handled
+     */
+    virtual std::vector<std::size_t> handleEvents(std::span<const Event> events) override;
 };
 
 #endif // NOTIFICATION_EVENT_HANDLER_H
\ No newline at end of file
@@ -18,6 +18,12 @@
 class OrderEventHandler : public Handler
 {
 public:
+    /**
+     * @brief The user changes orders are kept in step with, see StaticHandlerTable
+     */
+    static constexpr user_profile::utils::event::EventTypeMask kEventTypes = user_profile::utils::event::eventTypeMask(
+        Event::EventType::eUserUpdated, Event::EventType::eUserDeleted);
+
     /**
      * @brief Default constructor for OrderEventHandler class
      */
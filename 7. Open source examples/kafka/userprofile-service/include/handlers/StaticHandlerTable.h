@@ -0,0 +1,105 @@
+/**
+ * @file StaticHandlerTable.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration and implementation of StaticHandlerTable class template
+ */
+
+#ifndef STATIC_HANDLER_TABLE_H
+#define STATIC_HANDLER_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include "Event.h"
+#include "utils.h"
+
+/**
+ * @brief StaticHandlerTable class template
+ * The compile-time counterpart of HandlerRegistry for handlers known when the service is
+ * built. Every handler type declares the events it takes as
+ * `static constexpr user_profile::utils::event::EventTypeMask kEventTypes`. The table holds
+ * one function per event type which calls exactly the handlers of that type, in template
+ * argument order, without a virtual call; dispatching is one indirect call. Types beyond the
+ * known range are dispatched like EventType::eUnknown.
+ * @tparam Handlers The handler types, the table keeps references to the handlers
+ */
+template <typename... Handlers>
+class StaticHandlerTable
+{
+public:
+    using EventType = Event::EventType;
+    using EventTypeMask = user_profile::utils::event::EventTypeMask;
+
+    /**
+     * @brief Constructor for StaticHandlerTable class
+     * @param handlers The handlers, they must outlive the table
+     */
+    explicit StaticHandlerTable(Handlers&... handlers)
+        : mHandlers(handlers...)
+    {
+    }
+
+    /**
+     * @brief Hand an event to the handlers of its type
+     * @param event The event
+     * @return true if every handler handled the event, also if no handler takes its type
+     */
+    bool dispatch(const Event& event) const
+    {
+        const auto index = static_cast<std::size_t>(event.getType());
+        return kTable[index < kTable.size() ? index : 0](mHandlers, event);
+    }
+
+    /**
+     * @brief Get the number of handlers of an event type
+     */
+    static constexpr std::size_t handlerCount(EventType type)
+    {
+        return (std::size_t(0) + ... + (accepts<Handlers>(static_cast<std::size_t>(type)) ? 1 : 0));
+    }
+
+private:
+    using Tuple = std::tuple<Handlers&...>;
+    using Entry = bool (*)(const Tuple&, const Event&);
+
+    template <typename HandlerType>
+    static constexpr bool accepts(std::size_t type)
+    {
+        return (HandlerType::kEventTypes & (EventTypeMask(1) << type)) != 0;
+    }
+
+    template <std::size_t Type, typename HandlerType>
+    static bool handleIfAccepted(HandlerType& handler, const Event& event)
+    {
+        if constexpr (accepts<HandlerType>(Type)) {
+            return handler.HandlerType::handleEvent(event); // Qualified, so not a virtual call
+        } else {
+            return true;
+        }
+    }
+
+    template <std::size_t Type>
+    static bool dispatchType(const Tuple& handlers, const Event& event)
+    {
+        // Every handler of the type runs, even after one of them failed
+        return std::apply([&event](Handlers&... handler) {
+            return (true & ... & handleIfAccepted<Type>(handler, event));
+        }, handlers);
+    }
+
+    template <std::size_t... Types>
+    static constexpr std::array<Entry, sizeof...(Types)> makeTable(std::index_sequence<Types...>)
+    {
+        return {&dispatchType<Types>...};
+    }
+
+    static constexpr std::array<Entry, user_profile::utils::event::kEventTypeCount> kTable =
+        makeTable(std::make_index_sequence<user_profile::utils::event::kEventTypeCount>{});
+
+    Tuple mHandlers;
+};
+
+#endif // STATIC_HANDLER_TABLE_H
@@ -0,0 +1,65 @@
+/**
+ * @file AdaptivePoller.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of AdaptivePoller class
+ * * This class picks the timeout of the next consumer poll from the result of the previous one.
+ */
+
+#ifndef ADAPTIVE_POLLER_H
+#define ADAPTIVE_POLLER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief AdaptivePoller class
+ * A poll waits until it has a full batch or its timeout passes. While records flow, a short
+ * timeout hands partial batches over quickly and keeps latency low; full batches return early
+ * anyway. While the topics are idle, every empty poll doubles the timeout up to the long bound,
+ * so an idle consumer wakes up rarely. The first record after an idle period brings the timeout
+ * straight back to the short bound.
+ * This class is only used from the polling thread.
+ */
+class AdaptivePoller
+{
+public:
+    /**
+     * @brief Timeout bounds
+     */
+    struct Options
+    {
+        std::chrono::milliseconds minTimeout{1};
+        std::chrono::milliseconds maxTimeout{100};
+    };
+
+    /**
+     * @brief Constructor for AdaptivePoller class
+     * @param options The timeout bounds, the first poll uses the short one
+     */
+    explicit AdaptivePoller(Options options);
+
+    /**
+     * @brief Get the timeout of the next poll
+     */
+    std::chrono::milliseconds nextTimeout() const;
+
+    /**
+     * @brief Account the result of a poll
+     * @param records The number of records the poll returned
+     */
+    void onPoll(std::size_t records);
+
+    /**
+     * @brief Get the number of polls which returned nothing
+     */
+    std::uint64_t emptyPolls() const;
+
+private:
+    Options mOptions;
+    std::chrono::milliseconds mTimeout;
+    std::uint64_t mEmptyPolls = 0;
+};
+
+#endif // ADAPTIVE_POLLER_H
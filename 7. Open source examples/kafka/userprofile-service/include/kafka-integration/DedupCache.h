@@ -0,0 +1,94 @@
+/**
+ * @file DedupCache.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of DedupCache class
+ * * This class remembers recently handled events so redelivered records skip the handlers.
+ */
+
+#ifndef DEDUP_CACHE_H
+#define DEDUP_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "ConsumerMetrics.h"
+#include "Event.h"
+
+/**
+ * @brief DedupCache class
+ * Kafka delivers at least once: a rebalance or a failed commit hands already handled records
+ * out again. An event is identified by the ID its producer put in the event-id header, or by
+ * its topic, partition and offset when it has none. Identifiers are kept exactly in least
+ * recently used order over lock stripes, each stripe evicting its oldest entries once it holds
+ * its share of the memory bound. Eviction only forgets, so a duplicate older than the cache
+ * reaches the handlers again, which is the at-least-once behaviour without the cache.
+ */
+class DedupCache
+{
+public:
+    using Snapshot = ConsumerMetrics::DedupSnapshot;
+
+    static constexpr std::size_t kStripes = 16; ///< Lock stripes, each gets an equal share of maxBytes
+
+    /**
+     * @brief Constructor for DedupCache class
+     * @param maxBytes Estimated memory the entries may hold
+     */
+    explicit DedupCache(std::size_t maxBytes);
+
+    DedupCache(const DedupCache&) = delete;
+    DedupCache& operator=(const DedupCache&) = delete;
+
+    /**
+     * @brief Remember an event and report whether it was seen before
+     * The event is remembered before it is handled, so a concurrent redelivery of the same ID is
+     * skipped too. Call forget() if the handlers then fail it.
+     * @param event The event
+     * @return true if the event is a duplicate and must not be handled again
+     */
+    bool testAndInsert(const Event& event);
+
+    /**
+     * @brief Forget an event, normally because its handlers failed and a redelivery must be handled
+     * @param event The event
+     */
+    void forget(const Event& event);
+
+    /**
+     * @brief Get the cache counters
+     */
+    Snapshot stats() const;
+
+private:
+    // List node, hash node and bucket overhead per entry on a 64-bit build, on top of the identifier
+    static constexpr std::size_t kEntryOverhead = sizeof(std::string) + sizeof(std::string_view) + 7 * sizeof(void*);
+
+    struct Stripe
+    {
+        mutable std::mutex mutex;
+        std::list<std::string> order; // most recently seen first
+        std::unordered_map<std::string_view, std::list<std::string>::iterator> index; // views into order
+        std::size_t bytes = 0;
+    };
+
+    static std::string idOf(const Event& event);
+
+    Stripe& stripeFor(std::string_view id);
+
+    std::size_t mStripeBytes;
+    std::array<Stripe, kStripes> mStripes;
+
+    std::atomic<std::uint64_t> mHits{0};
+    std::atomic<std::uint64_t> mMisses{0};
+    std::atomic<std::uint64_t> mEvictions{0};
+};
+
+#endif // DEDUP_CACHE_H
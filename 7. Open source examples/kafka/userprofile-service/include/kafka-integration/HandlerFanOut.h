@@ -0,0 +1,164 @@
+/**
+ * @file HandlerFanOut.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of HandlerFanOut class
+ * * This class hands a batch of events to several independent handlers at the same time
+ * * and joins their results, like the par block of the detailed sequence diagram.
+ */
+
+#ifndef HANDLER_FAN_OUT_H
+#define HANDLER_FAN_OUT_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ConsumerMetrics.h"
+#include "Event.h"
+#include "Handler.h"
+#include "HandlerLane.h"
+#include "LatencyHistogram.h"
+#include "WorkStealingPool.h"
+
+/**
+ * @brief HandlerFanOut class
+ * run() keeps one handler on the calling thread and runs the others on a work-stealing pool
+ * shared by every handler thread, so a batch takes as long as its slowest handler instead of
+ * the sum of all of them. A handler with a timeout which overruns it fails the whole batch and
+ * is left to finish in the background; it works on a copy of the batch for that reason. Until
+ * it finished the handler counts as busy: a later batch waits for it up to the timeout and
+ * fails without starting when it is still busy, a retry through handleRetry() is refused.
+ * An isolated handler gets a HandlerLane instead: run() only queues the batch for it and its
+ * failures arrive later through the deferred callback, so it never holds up the batch.
+ * Every handler has its own call, failure, timeout and latency accounting.
+ * Without a pool the shared handlers run one after another on the calling thread, which cannot
+ * give up on them, so their timeouts are not enforced.
+ */
+class HandlerFanOut
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Handlers = std::vector<std::shared_ptr<Handler>>;
+    using Snapshot = ConsumerMetrics::HandlerSnapshot;
+
+    /**
+     * @brief Receives the failures of an isolated handler once its lane handled the batch
+     * @param handler The index of the handler in the handlers given to run()
+     * @param failed The indexes of the events it failed
+     */
+    using Deferred = std::function<void(std::size_t handler, std::vector<std::size_t> failed)>;
+
+    /**
+     * @brief Per handler options
+     */
+    struct Options
+    {
+        std::string name;                     ///< Names the handler in the metrics
+        std::chrono::milliseconds timeout{0}; ///< Longest wait for a batch, 0 waits forever, needs pool threads
+        std::optional<HandlerLane::Options> lane{}; ///< Isolates the handler, the timeout does not apply then
+    };
+
+    HandlerFanOut() = default;
+
+    HandlerFanOut(const HandlerFanOut&) = delete;
+    HandlerFanOut& operator=(const HandlerFanOut&) = delete;
+
+    /**
+     * @brief Set the options and the accounting of a handler, before start()
+     * @param handler The handler, ignored if null
+     * @param options The options
+     */
+    void add(const std::shared_ptr<Handler>& handler, Options options);
+
+    /**
+     * @brief Start the pool the handlers are fanned out on and the lanes of the isolated handlers
+     * @param threads Number of pool threads, 0 runs the shared handlers one after another and
+     *        ignores their timeouts
+     */
+    void start(std::size_t threads);
+
+    /**
+     * @brief Hand a batch to several handlers and wait for the shared ones
+     * Safe to call from several threads at once.
+     * @param handlers The handlers, usually those of a HandlerRegistry route
+     * @param events The events
+     * @param deferred Called once per isolated handler, possibly before run() returns; a batch
+     *        refused by a stopping lane never completes
+     * @return The indexes of the events every handler failed, in handler order; a handler which
+     *         timed out failed every event, an isolated handler reports through deferred instead
+     */
+    std::vector<std::vector<std::size_t>> run(const Handlers& handlers, std::span<const Event> events,
+        const Deferred& deferred = {});
+
+    /**
+     * @brief Hand one retried event to a handler unless the handler is busy
+     * A handler is busy while it still works on a batch it overran, running it next to that
+     * batch would handle the same events twice at once and out of order.
+     * @param handler The handler
+     * @param event The event
+     * @return true if the handler handled the event, false if it failed it or was busy
+     */
+    bool handleRetry(const std::shared_ptr<Handler>& handler, const Event& event);
+
+    /**
+     * @brief Check whether a handler has a lane of its own
+     */
+    bool isolated(const Handler* handler) const;
+
+    /**
+     * @brief Wait until the lanes handled every queued and spilled batch
+     */
+    void drain();
+
+    /**
+     * @brief Handle the batches queued in the lanes and stop them
+     */
+    void stop();
+
+    /**
+     * @brief Get the accounting of every handler, in add() order
+     */
+    std::vector<Snapshot> stats() const;
+
+private:
+    struct Slot
+    {
+        Options options;
+        std::shared_ptr<Handler> handler;
+        std::atomic<std::uint64_t> batches{0};
+        std::atomic<std::uint64_t> events{0};
+        std::atomic<std::uint64_t> failedEvents{0};
+        std::atomic<std::uint64_t> timeouts{0};
+        LatencyHistogram latencyUs;
+        std::mutex overrunMutex;
+        std::condition_variable overrunDone;
+        std::size_t overrunning = 0; // tasks which timed out and still run, guarded by overrunMutex
+        std::unique_ptr<HandlerLane> lane; // last, its workers use the rest of the slot
+    };
+
+    struct Job;
+
+    Slot& slotOf(const Handler* handler);
+    const Slot& slotOf(const Handler* handler) const;
+    static std::vector<std::size_t> handle(Slot& slot, Handler& handler, std::span<const Event> events);
+    static bool awaitIdle(Slot& slot, Clock::time_point deadline);
+    static std::vector<std::size_t> timedOut(Slot& slot, std::size_t events);
+
+    std::vector<std::unique_ptr<Slot>> mSlots;
+    std::unordered_map<const Handler*, Slot*> mSlotOf;
+    Slot mUnnamed; // handlers which were never added
+    std::unique_ptr<WorkStealingPool> mPool; // after the slots, its tasks use them
+};
+
+#endif // HANDLER_FAN_OUT_H
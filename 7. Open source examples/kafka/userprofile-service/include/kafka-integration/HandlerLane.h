@@ -0,0 +1,183 @@
+/**
+ * @file HandlerLane.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of HandlerLane class
+ * * This class gives a single handler its own bounded queue and worker threads, so a handler
+ * * which blocks, such as the audit handler writing to disk, cannot hold up the others.
+ */
+
+#ifndef HANDLER_LANE_H
+#define HANDLER_LANE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Event.h"
+#include "LatencyHistogram.h"
+
+/**
+ * @brief HandlerLane class
+ * submit() copies a batch into the queue and returns, the lane workers hand it to the handler
+ * later and report its failures through the batch callback. Once the queue holds its capacity
+ * the overflow policy decides: eBlock waits for space, eShed drops the batch for this handler,
+ * eSpill writes it to a file in the spill directory. Only the events of a spilled batch leave
+ * memory: the lane reads the file back after the queue ran empty and calls done once the handler
+ * had the batch, so its offsets stay uncommitted until then. The files therefore only matter to
+ * the lane which wrote them; the ones a previous run left behind are removed at the start, the
+ * broker redelivers their records.
+ */
+class HandlerLane
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief What submit() does with a batch the queue has no space for
+     */
+    enum class Overflow
+    {
+        eBlock, ///< Wait for space, the caller and eventually the partition are held up
+        eShed,  ///< Drop the batch for this handler, it counts as handled
+        eSpill  ///< Write the batch to disk, blocks as eBlock if that fails
+    };
+
+    /**
+     * @brief Lane options
+     */
+    struct Options
+    {
+        std::size_t workers = 1;             ///< Worker threads, more than one hands batches over out of order
+        std::size_t queueCapacity = 1000;    ///< Events queued in memory before the overflow policy applies
+        Overflow overflow = Overflow::eBlock;
+        std::filesystem::path spillDirectory; ///< Used by eSpill only, one directory per handler
+    };
+
+    /**
+     * @brief Calls the handler, returns the indexes of the events it failed
+     */
+    using Handle = std::function<std::vector<std::size_t>(std::span<const Event> events)>;
+
+    /**
+     * @brief Receives the failures of a submitted batch, empty if it was shed
+     */
+    using Done = std::function<void(std::vector<std::size_t> failed)>;
+
+    /**
+     * @brief Constructor for HandlerLane class
+     * Removes the batches a previous run left in the spill directory and starts the workers.
+     * @param options The lane options
+     * @param handle Calls the handler
+     */
+    HandlerLane(Options options, Handle handle);
+
+    /**
+     * @brief Destructor for HandlerLane class
+     * Stops the workers, see stop().
+     */
+    ~HandlerLane();
+
+    HandlerLane(const HandlerLane&) = delete;
+    HandlerLane& operator=(const HandlerLane&) = delete;
+
+    /**
+     * @brief Queue a batch for the handler
+     * Safe to call from several threads at once. A batch refused because the lane is stopping
+     * is dropped without calling done, its offsets stay uncommitted.
+     * @param events The events, copied
+     * @param done Called once, from a worker if the batch was queued or before returning otherwise
+     */
+    void submit(std::span<const Event> events, Done done);
+
+    /**
+     * @brief Wait until every queued and every spilled batch was handled
+     */
+    void drain();
+
+    /**
+     * @brief Handle the queued batches and stop the workers
+     * Spilled batches which were not read back yet are removed without calling done.
+     */
+    void stop();
+
+    /**
+     * @brief Get the number of events queued in memory
+     */
+    std::size_t queuedEvents() const;
+
+    /**
+     * @brief Get the number of events waiting in the spill directory
+     */
+    std::size_t spillDepth() const;
+
+    /**
+     * @brief Get the number of events dropped by eShed
+     */
+    std::uint64_t shedEvents() const;
+
+    /**
+     * @brief Get the number of events written to the spill directory
+     */
+    std::uint64_t spilledEvents() const;
+
+    /**
+     * @brief Get how long batches waited in the queue, in microseconds
+     */
+    LatencyHistogram::Snapshot queueUs() const;
+
+private:
+    struct Job
+    {
+        std::vector<Event> events;
+        Done done;
+        Clock::time_point queuedAt;
+    };
+
+    struct SpillFile
+    {
+        std::filesystem::path path;
+        std::size_t events = 0;
+        Done done;
+    };
+
+    bool fitsLocked(std::size_t events) const;
+    std::optional<SpillFile> spill(std::span<const Event> events);
+    void clearSpillDirectory();
+    void workerLoop();
+    void handleSpilled(SpillFile& file);
+
+    Options mOptions;
+    Handle mHandle;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mWork;
+    std::condition_variable mSpace;
+    std::condition_variable mIdle;
+    std::deque<Job> mQueue;
+    std::deque<SpillFile> mSpilled;
+    std::size_t mQueuedEvents = 0;
+    std::size_t mSpillDepth = 0;
+    std::size_t mRunningJobs = 0;   // queued or spilled batches taken by a worker and not done yet
+    std::uint64_t mNextSpill = 0;
+    bool mStopping = false;
+
+    std::atomic<std::uint64_t> mShedEvents{0};
+    std::atomic<std::uint64_t> mSpilledEvents{0};
+    LatencyHistogram mQueueUs;
+
+    std::vector<std::thread> mWorkers; // must be the last member, they start in the constructor
+};
+
+#endif // HANDLER_LANE_H
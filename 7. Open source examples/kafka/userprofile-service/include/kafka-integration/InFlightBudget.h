@@ -0,0 +1,86 @@
+/**
+ * @file InFlightBudget.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of InFlightBudget class
+ * * This class bounds the bytes and records the producer holds before they are acknowledged.
+ */
+
+#ifndef IN_FLIGHT_BUDGET_H
+#define IN_FLIGHT_BUDGET_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "ProducerMetrics.h"
+
+class InFlightBudget
+{
+public:
+    /**
+     * @brief Constructor with the budget limits
+     * @param maxBytes Maximum bytes in flight, a single larger record is still let through alone
+     * @param maxRecords Maximum records in flight
+     */
+    InFlightBudget(std::size_t maxBytes, std::size_t maxRecords);
+
+    InFlightBudget(const InFlightBudget&) = delete;
+    InFlightBudget& operator=(const InFlightBudget&) = delete;
+
+    /**
+     * @brief Reserve budget for one record without waiting
+     * @param bytes The record size
+     * @return true if the budget was reserved
+     */
+    bool tryAcquire(std::size_t bytes);
+
+    /**
+     * @brief Reserve budget for one record, waiting for releases up to a timeout
+     * @param bytes The record size
+     * @param timeout The longest time to wait
+     * @return true if the budget was reserved
+     */
+    bool acquire(std::size_t bytes, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Give back the budget of one record
+     * @param bytes The record size passed to acquire
+     */
+    void release(std::size_t bytes);
+
+    /**
+     * @brief Count records refused because the budget was exhausted
+     */
+    void onRejected() { mRejected.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Count queued records dropped to make room for higher priority records
+     */
+    void onDropped(std::uint64_t records) { mDropped.fetch_add(records, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the current budget usage
+     */
+    ProducerMetrics::BudgetSnapshot usage() const;
+
+private:
+    const std::size_t mMaxBytes;
+    const std::size_t mMaxRecords;
+
+    std::atomic<std::size_t> mBytes{0};
+    std::atomic<std::size_t> mRecords{0};
+    std::atomic<std::uint64_t> mBlocked{0};
+    std::atomic<std::uint64_t> mRejected{0};
+    std::atomic<std::uint64_t> mDropped{0};
+
+    // Only used when a caller has to wait, the fast path is lock-free
+    std::mutex mMutex;
+    std::condition_variable mReleased;
+    std::atomic<std::size_t> mWaiters{0};
+};
+
+#endif // IN_FLIGHT_BUDGET_H
@@ -8,41 +8,261 @@
 #ifndef KAFKA_MESSAGE_CONSUMER_H
 #define KAFKA_MESSAGE_CONSUMER_H
 
-#include <kafka/KafkaConsumer.h>
-
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AdaptivePoller.h"
+#include "ConsumerMetrics.h"
+#include "DedupCache.h"
+#include "Handler.h"
+#include "HandlerFanOut.h"
+#include "HandlerRegistry.h"
+#include "OffsetTracker.h"
+#include "PartitionBackpressure.h"
+#include "PartitionDispatcher.h"
+#include "ReplayDecoder.h"
+#include "RetryScheduler.h"
+#include "ServiceConfig.h"
+#include "User.h"
+#include "bus/IMessageBus.h"
 
 class KafkaMessageConsumer
 {
 public:
-    using KafkaConsumer = KAFKA_API::clients::consumer::KafkaConsumer; // Alias for Kafka consumer
+
+    /**
+     * @brief Stores an event which kept failing its handlers, normally KafkaMessageProducer::sendEvent
+     * with the type and ID of the event, so the dead-letter record keeps its headers
+     * @return true if the event was stored
+     */
+    using DeadLetterSink = std::function<bool(const std::string& topic, const Event& event)>;
+
+    /**
+     * @brief Where a replay starts and how it batches
+     * fromTime wins over fromOffset when set. fromOffset applies to every partition and is
+     * clamped to the log start.
+     */
+    struct ReplayOptions
+    {
+        std::string topic;                                              ///< Empty replays the user events topic
+        std::int64_t fromOffset = 0;
+        std::optional<std::chrono::system_clock::time_point> fromTime;
+        std::size_t batchRecords = 20000;                               ///< Records per repository transaction
+        std::size_t decodeThreads = 4;
+        std::chrono::milliseconds progressInterval{1000};
+    };
+
+    /**
+     * @brief Progress of a running replay
+     */
+    struct ReplayProgress
+    {
+        std::uint64_t records = 0;       ///< Records read so far
+        std::uint64_t bytes = 0;
+        std::uint64_t upserts = 0;       ///< Rows written, after folding the events of a batch per user
+        std::uint64_t removals = 0;
+        std::uint64_t skipped = 0;       ///< Records which were not decodable user events
+        std::uint64_t transactions = 0;
+        std::int64_t remaining = 0;      ///< Records left up to the end offsets taken at the start
+        double recordsPerSec = 0.0;      ///< Since the start of the replay
+        std::chrono::milliseconds elapsed{0};
+        bool done = false;
+    };
+
+    using ReplayProgressCallback = std::function<void(const ReplayProgress& progress)>;
+
+    /**
+     * @brief Writes one replayed batch in one transaction, normally UserRepository::applyBatch
+     * @return true if the batch was committed
+     */
+    using ReplaySink = std::function<bool(const std::vector<User>& upserts, const std::vector<std::string>& removedIds)>;
 
     /**
      * @brief Constructor for KafkaMessageConsumer class
      */
     KafkaMessageConsumer();
 
+    /**
+     * @brief Constructor for KafkaMessageConsumer class
+     * @param config The service configuration, its event handler threads drive the dispatching
+     * @param bus The bus records are consumed from, a KafkaMessageBus or an InProcessMessageBus
+     */
+    KafkaMessageConsumer(const ServiceConfig& config, std::shared_ptr<IMessageBus> bus);
+
     /**
      * @brief Destructor for KafkaMessageConsumer class
      */
     ~KafkaMessageConsumer();
 
+    /**
+     * @brief Register a handler for some event types
+     * Handlers must be registered before initialize() is called, they are called from
+     * several handler threads at once. A handler only receives the events of its types.
+     * The handlers of an event run in parallel, a handler which overruns its timeout fails
+     * the batch and its events are retried. Timeouts need ServiceConfig::setEventFanOutThreads
+     * greater than 0, without fan-out threads a handler is always waited for. A handler with lane
+     * options is isolated: it gets its own queue and threads and the other handlers never wait
+     * for it, only the offsets of the events do.
+     * @param handler The handler
+     * @param types The event types, every consumed event by default
+     * @param options The name, timeout and lane of the handler
+     */
+    void registerHandler(std::shared_ptr<Handler> handler,
+        HandlerRegistry::EventTypeMask types = user_profile::utils::event::kAllEventTypes,
+        HandlerFanOut::Options options = {});
+
+    /**
+     * @brief Register a handler for the event types its class declares in kEventTypes
+     * @param handler The handler
+     * @param options The name, timeout and lane of the handler
+     */
+    template <DeclaresEventTypes HandlerType>
+    void registerHandler(std::shared_ptr<HandlerType> handler, HandlerFanOut::Options options = {})
+    {
+        registerHandler(std::shared_ptr<Handler>(std::move(handler)), HandlerType::kEventTypes, std::move(options));
+    }
+
+    /**
+     * @brief Set where events go once they ran out of retries
+     * The sink receives TopicConfig::getDeadLetterEvents() as topic. Without a sink or a
+     * dead-letter topic such events keep their offsets held: the committed offset of their
+     * partition stops at them until a rebalance or restart consumes them again. Must be set
+     * before initialize().
+     * @param sink The sink
+     */
+    void setDeadLetterSink(DeadLetterSink sink);
+
     /**
      * @brief Initialize the Kafka consumer
-     * This method sets up the Kafka consumer with the necessary configurations.
+     * This method creates a consumer of the configured group on the bus
+     * and subscribes to every configured topic. It fails without a bus.
      * @return true if initialization is successful, false otherwise
      */
     bool initialize();
 
     /**
      * @brief Consume messages from a specified topic
-     * This method consumes messages.
+     * This method polls on the calling thread and hands the records to the handler threads.
+     * The poll timeout adapts between the configured bounds, short while records flow
+     * and long while the topics are idle.
+     * Events a handler fails are retried with backoff on a separate thread and dead-lettered
+     * once they run out of attempts; their partition keeps being consumed meanwhile.
+     * Offsets of handled records are committed asynchronously at the configured cadence.
+     * Partitions whose handler thread falls behind are paused while polling goes on,
+     * so the consumer stays in its group and memory stays bounded.
+     * It returns after stop() once every polled record has been handled and its offset
+     * committed synchronously.
      */
     void consume();
 
+    /**
+     * @brief Rebuild the users table from the event log
+     * Reads the topic from the given position up to its end offsets at the time of the call,
+     * with a consumer of its own which joins no group and commits nothing. Events are decoded
+     * in parallel and written in large transactions; handlers are not called, so replayed
+     * events cause no notifications or other side effects. Can run alongside consume().
+     * @param options Start position and batching
+     * @param sink Writes the users, normally UserRepository::applyBatch
+     * @param onProgress Called every progress interval and once at the end, may be empty
+     * @return true if the end offsets were reached and every batch was committed
+     */
+    bool replay(const ReplayOptions& options, const ReplaySink& sink, const ReplayProgressCallback& onProgress);
+
+    /**
+     * @brief Ask consume() and replay() to return
+     */
+    void stop();
+
+    /**
+     * @brief Get the latest consumer metrics
+     * consume() publishes a new snapshot every configured metrics interval,
+     * reading it never blocks the consumer.
+     * @return The snapshot
+     */
+    std::shared_ptr<const ConsumerMetrics::Snapshot> metricsSnapshot() const;
+
+    /**
+     * @brief Convert a consumed record to an event
+     * The event type and ID are read from the kafka_const::kEventTypeHeader and
+     * kafka_const::kEventIdHeader headers; without a type header the type comes from the
+     * header of an EventEnvelope payload. Nothing is copied: the payload shares the record
+     * value, the ID, key and topic point into the polled batch and keep it alive.
+     * @param record The record
+     * @param batch The polled batch the record belongs to
+     */
+    static Event toEvent(const PolledBatch::Record& record, const std::shared_ptr<const PolledBatch>& batch);
+
 private:
-    std::unique_ptr<KafkaConsumer> mConsumer;
-    bool mRunning = true; // Flag to control the consumer loop
+
+    /**
+     * @brief A handled batch which waits for the lanes of isolated handlers before completing
+     */
+    struct PendingEvents
+    {
+        std::mutex mutex;
+        std::vector<Event> events;                      // set once the handler thread is done with them
+        std::vector<RetryScheduler::Handlers> failedBy;
+        std::size_t remaining = 1;                      // the handler thread, plus one per lane the runs went to
+    };
+
+    void handleEvents(std::vector<Event>& events);
+
+    /**
+     * @brief Record the handler which failed events of a run
+     * @return The number of events which had not failed before
+     */
+    static std::size_t addFailures(std::vector<RetryScheduler::Handlers>& failedBy, std::size_t begin,
+        std::size_t size, const std::shared_ptr<Handler>& handler, const std::vector<std::size_t>& failed);
+
+    /**
+     * @brief Hand the failed events to the retry scheduler and complete the others
+     * @param events The events, the first freshCount were handed to the handlers
+     * @param failedBy The handlers which failed each of the first freshCount events
+     */
+    void completeEvents(std::vector<Event>& events, std::vector<RetryScheduler::Handlers>& failedBy);
+
+    /**
+     * @brief Tell the retry scheduler which handlers handled the events, see RetryScheduler::supersede
+     * @param events The events of a completed batch
+     * @param failedBy The handlers which failed each event, empty if none failed
+     */
+    void supersedeRetries(const std::vector<Event>& events, const std::vector<RetryScheduler::Handlers>& failedBy);
+
+    /**
+     * @brief Move the events which were not handled before to the front, keeping their order
+     * @return The number of events to hand to the handlers
+     */
+    std::size_t skipDuplicates(std::vector<Event>& events);
+    void commitHandled(bool sync);
+
+    void applyBackpressure();
+    void publishMetrics(ConsumerMetrics::Clock::time_point now);
+    void onRebalance(IMessageBus::RebalanceType type, const IMessageBus::TopicPartitions& partitions);
+
+    ServiceConfig mConfig;
+    HandlerRegistry mHandlers;
+    std::shared_ptr<IMessageBus> mBus; // Outlives mConsumer
+    std::unique_ptr<IMessageBus::Consumer> mConsumer;
+    std::unique_ptr<AdaptivePoller> mPoller;
+    ConsumerMetrics mMetrics;
+    ConsumerMetrics::Clock::time_point mLastMetricsPublish;
+    std::unique_ptr<OffsetTracker> mOffsets;
+    std::unique_ptr<DedupCache> mDedup; // null if deduplication is disabled
+    DeadLetterSink mDeadLetterSink;
+    std::unique_ptr<RetryScheduler> mRetries; // after mOffsets, its thread completes offsets
+    HandlerFanOut mFanOut; // after mOffsets, mDedup and mRetries, its lanes complete batches
+    std::unique_ptr<PartitionDispatcher> mDispatcher; // after mMetrics, mOffsets, mDedup, mRetries and mFanOut, its workers use them
+    std::unique_ptr<PartitionBackpressure> mBackpressure;
+    std::atomic<bool> mRunning{true}; // Flag to control the consumer loop
 };
 
-#endif // KAFKA_MESSAGE_CONSUMER_H
\ No newline at end of file
+#endif // KAFKA_MESSAGE_CONSUMER_H
@@ -10,22 +10,38 @@
 #ifndef KAFKA_MESSAGE_PRODUCER_H
 #define KAFKA_MESSAGE_PRODUCER_H
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 
-#include <kafka/KafkaProducer.h>
-#include <kafka/KafkaException.h>
-#include <kafka/ProducerRecord.h>
+#include "Event.h"
+#include "InFlightBudget.h"
+#include "PayloadBufferPool.h"
+#include "ProducerBatchAccumulator.h"
+#include "ProducerMetrics.h"
+#include "ServiceConfig.h"
+#include "bus/IMessageBus.h"
 
 class KafkaMessageProducer
 {
 public:
-    using KafkaProducer = KAFKA_API::clients::producer::KafkaProducer; // Alias for Kafka producer
+    using DeliveryCallback = ProducerBatchAccumulator::DeliveryCallback; // Alias for delivery outcome callback
+    using BackpressurePolicy = ServiceConfig::BackpressurePolicy; // Alias for budget exhaustion policy
 
     /**
      * @brief Constructor for KafkaMessageProducer class
      */
     KafkaMessageProducer();
 
+    /**
+     * @brief Constructor for KafkaMessageProducer class
+     * @param config The service configuration, its producer batch size and linger time drive batching
+     * @param bus The bus records are published to, a KafkaMessageBus or an InProcessMessageBus
+     */
+    KafkaMessageProducer(const ServiceConfig& config, std::shared_ptr<IMessageBus> bus);
+
     /**
      * @brief Destructor for KafkaMessageProducer class
      */
@@ -33,21 +49,61 @@ public:
 
     /**
      * @brief Initialize the Kafka producer
-     * This method sets up the Kafka producer with the necessary configurations.
+     * This method creates the bus producer with the client and transactional ids of ServiceConfig.
+     * It fails without a bus.
+     * Idempotence is enabled when configured or when a transactional id is set.
      * @return true if initialization is successful, false otherwise
      */
     bool initialize();
 
     /**
      * @brief Send a message to a specified topic
-     * This method sends a message to the given Kafka topic.
+     * This method appends the message to the batch of its topic-partition.
+     * The batch is sent when it reaches the producer batch size or its linger time passes.
      * @param topic The topic to which the message will be sent
      * @param key The key associated with the message
      * @param message The message to send
-     * @return true if the message was sent successfully, false otherwise
+     * @return true if the message was queued successfully, false otherwise
      */
     bool sendMessage(const std::string& topic, const std::string& key, const std::string& message);
 
+    /**
+     * @brief Send a shared payload to a specified topic without copying it
+     * The payload is handed to the bus without a copy and its reference is released
+     * from the delivery callback, so the bytes stay valid until the broker acknowledged them.
+     * @param topic The topic to which the message will be sent
+     * @param key The key associated with the message
+     * @param payload The message bytes and their owner
+     * @param onDelivery Optional callback invoked with the delivery outcome, only when this returns true
+     * @return true if the message was queued successfully, false if it was refused, for example
+     *         because the in-flight budget is exhausted under the configured BackpressurePolicy
+     */
+    bool sendMessage(const std::string& topic, const std::string& key, SharedPayload payload,
+        DeliveryCallback onDelivery = {});
+
+    /**
+     * @brief Send an event to a specified topic without copying its payload
+     * Like sendMessage, and the record carries the kafka_const::kEventTypeHeader and
+     * kafka_const::kEventIdHeader headers KafkaMessageConsumer routes and deduplicates by.
+     * @param topic The topic to which the event will be sent
+     * @param key The key associated with the event
+     * @param type The event type
+     * @param eventId The unique event ID, empty to send no ID header
+     * @param payload The event bytes and their owner
+     * @param onDelivery Optional callback invoked with the delivery outcome, only when this returns true
+     * @return true if the event was queued successfully, false if it was refused
+     */
+    bool sendEvent(const std::string& topic, const std::string& key, Event::EventType type,
+        const std::string& eventId, SharedPayload payload, DeliveryCallback onDelivery = {});
+
+    /**
+     * @brief Get a pooled buffer to build a payload in place
+     * Fill the buffer, then pass PayloadBufferPool::share(buffer) to sendMessage.
+     * @param capacity The number of bytes the caller is about to write
+     * @return The pooled buffer
+     */
+    PayloadBufferPtr acquirePayloadBuffer(std::size_t capacity);
+
     /**
      * @brief Flush the producer
      * This method flushes the producer, ensuring that all messages are sent.
@@ -55,8 +111,78 @@ public:
      */
     bool flush();
 
+    /**
+     * @brief Get a copy of the delivery metrics
+     * Per-topic sent, acked, failed and in-flight counters with send-to-ack latency percentiles,
+     * and the usage of the in-flight byte and record budget.
+     * @return The metrics snapshot
+     */
+    ProducerMetrics::Snapshot metricsSnapshot() const;
+
+    /**
+     * @brief Check whether the producer was initialized with a transactional id
+     * @return true if messages must be sent through runInTransaction, from the thread running it
+     */
+    bool isTransactional() const;
+
+    /**
+     * @brief Run an operation which sends several messages as one Kafka transaction
+     * The messages sent by the operation become visible to read_committed consumers together,
+     * or not at all. Transactions are serialized, one operation runs at a time. Only the thread
+     * running the operation can send meanwhile, sendMessage from any other thread returns false,
+     * so an abort never discards records which are not part of the operation.
+     * If the abort fails the producer is created again, which fences the old one.
+     * @param operation Sends the messages, returns false to abort the transaction
+     * @return true if the transaction was committed, false if it was aborted
+     */
+    bool runInTransaction(const std::function<bool()>& operation);
+
 private:
-    std::unique_ptr<KafkaProducer> mProducer; // Unique pointer to Kafka producer instance
+    using Batch = ProducerBatchAccumulator::Batch;
+
+    /**
+     * @brief Send a closed batch through the bus producer
+     * @param batch The batch to send
+     */
+    void sendBatch(Batch&& batch);
+
+    /**
+     * @brief Reserve in-flight budget for a record, applying the backpressure policy
+     * @param topic The topic of the record
+     * @param bytes The key and value size of the record
+     * @return true if the record may be queued
+     */
+    bool admit(const std::string& topic, std::size_t bytes);
+
+    /**
+     * @brief Create the bus producer and register its transactional id
+     * @return false if the bus refused the producer or the registration failed
+     */
+    bool createProducer();
+
+    /**
+     * @brief Queue a record once it passed the transaction and budget checks
+     * @return true if the record was queued
+     */
+    bool send(const std::string& topic, const std::string& key, SharedPayload payload, DeliveryCallback onDelivery,
+        ProducerBatchAccumulator::Headers headers);
+
+    /**
+     * @brief Release the budget of records which will never be sent and report their failure
+     */
+    void failRecords(std::vector<ProducerBatchAccumulator::Record>&& records);
+
+    ServiceConfig mConfig;
+    PayloadBufferPool mBufferPool; // Outlives the buffers through its shared state
+    ProducerMetrics mMetrics; // Declared before mProducer, delivery callbacks write to it until close
+    std::unique_ptr<InFlightBudget> mBudget; // Same, delivery callbacks release into it
+    std::shared_ptr<IMessageBus> mBus; // Outlives mProducer
+    std::unique_ptr<IMessageBus::Producer> mProducer;
+    std::unique_ptr<ProducerBatchAccumulator> mAccumulator; // Destroyed first, it drains into mProducer
+
+    bool mTransactional = false;
+    std::atomic<std::thread::id> mTransactionOwner; // the thread running the open transaction, none outside
+    std::mutex mTransactionMutex;
 };
 
 #endif // KAFKA_MESSAGE_PRODUCER_H
\ No newline at end of file
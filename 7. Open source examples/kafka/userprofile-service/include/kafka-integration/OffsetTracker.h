@@ -0,0 +1,129 @@
+/**
+ * @file OffsetTracker.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of OffsetTracker class
+ * * This class tracks which consumed records have been handled and which offsets are safe to commit.
+ */
+
+#ifndef OFFSET_TRACKER_H
+#define OFFSET_TRACKER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Event.h"
+
+/**
+ * @brief OffsetTracker class
+ * Records are tracked in poll order and completed from the handler threads in any order.
+ * The committable offset of a partition only moves past a record once every earlier record
+ * of that partition has been handled, so a crash never skips an unhandled record.
+ * The types match KAFKA_API::TopicPartition and KAFKA_API::TopicPartitionOffsets.
+ */
+class OffsetTracker
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using TopicPartition = std::pair<std::string, std::int32_t>;
+    using TopicPartitions = std::set<TopicPartition>;
+    using Offsets = std::map<TopicPartition, std::int64_t>; ///< Next offset to consume, as Kafka commits it
+
+    /**
+     * @brief Commit cadence, a commit is due after either limit
+     */
+    struct Options
+    {
+        std::size_t commitEveryRecords = 1000;
+        std::chrono::milliseconds commitInterval{1000};
+    };
+
+    /**
+     * @brief Constructor for OffsetTracker class
+     * @param options The commit cadence
+     */
+    explicit OffsetTracker(Options options);
+
+    /**
+     * @brief Track a polled record, must be called in poll order before the record is dispatched
+     * A record redelivered after a seek is ignored, whether it is still tracked or handled already.
+     */
+    void track(std::string_view topic, std::int32_t partition, std::int64_t offset);
+
+    /**
+     * @brief Mark a record as handled
+     * Records of partitions which are not tracked any more are ignored.
+     */
+    void complete(std::string_view topic, std::int32_t partition, std::int64_t offset);
+
+    /**
+     * @brief Mark a batch of events as handled, taking the lock once
+     * @param events The events, their source topic, partition and offset identify the records
+     */
+    void complete(std::span<const Event> events);
+
+    /**
+     * @brief Check whether the commit cadence asks for a commit
+     * @param now The current time
+     * @return true if records were handled since the last commit and a limit was reached
+     */
+    bool commitDue(Clock::time_point now) const;
+
+    /**
+     * @brief Take the offsets which moved since the last call and restart the cadence
+     * @param now The current time
+     * @return The offsets to commit, empty if no partition moved
+     */
+    Offsets takeCommittable(Clock::time_point now);
+
+    /**
+     * @brief Get the offsets last returned by takeCommittable()
+     * @return The committed offset of every tracked partition which has one
+     */
+    Offsets committed() const;
+
+    /**
+     * @brief Stop tracking partitions, normally because they were revoked
+     * @param partitions The partitions to forget
+     */
+    void forget(const TopicPartitions& partitions);
+
+    /**
+     * @brief Get the number of tracked records which have not been handled yet
+     */
+    std::size_t pendingRecords() const;
+
+private:
+    struct Entry
+    {
+        std::int64_t offset;
+        bool done;
+    };
+
+    struct PartitionState
+    {
+        std::deque<Entry> inFlight;  // in offset order
+        std::int64_t handled = -1;   // next offset after the contiguous handled records
+        std::int64_t committed = -1; // last value returned by takeCommittable()
+    };
+
+    void completeLocked(PartitionState& state, std::int64_t offset);
+
+    Options mOptions;
+    mutable std::mutex mMutex;
+    std::map<TopicPartition, PartitionState> mPartitions;
+    std::size_t mPendingRecords = 0;
+    std::size_t mCompletedSinceCommit = 0;
+    Clock::time_point mLastCommit;
+};
+
+#endif // OFFSET_TRACKER_H
@@ -0,0 +1,97 @@
+/**
+ * @file PartitionBackpressure.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of PartitionBackpressure class
+ * * This class decides which assigned partitions the consumer pauses while handlers fall behind.
+ */
+
+#ifndef PARTITION_BACKPRESSURE_H
+#define PARTITION_BACKPRESSURE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "OffsetTracker.h"
+#include "PartitionDispatcher.h"
+
+/**
+ * @brief PartitionBackpressure class
+ * A handler thread is throttled once its queue reaches the high watermark and released once it
+ * drains to the low watermark; the gap keeps partitions from flapping. With partition ordered
+ * dispatch only the partitions of a throttled thread are paused. With key ordered dispatch any
+ * partition feeds any thread, so every assigned partition is paused.
+ * This class is only used from the polling thread.
+ */
+class PartitionBackpressure
+{
+public:
+    using TopicPartitions = OffsetTracker::TopicPartitions;
+
+    /**
+     * @brief Queue depths which pause and resume a handler thread
+     */
+    struct Options
+    {
+        std::size_t highWatermark = 800;
+        std::size_t lowWatermark = 200;
+    };
+
+    /**
+     * @brief Partitions to pause and to resume after an update
+     */
+    struct Changes
+    {
+        TopicPartitions pause;
+        TopicPartitions resume;
+    };
+
+    /**
+     * @brief Constructor for PartitionBackpressure class
+     * @param options The watermarks
+     * @param dispatcher The dispatcher whose queues are watched, must outlive this object
+     */
+    PartitionBackpressure(Options options, const PartitionDispatcher& dispatcher);
+
+    /**
+     * @brief Add partitions assigned by a rebalance
+     */
+    void assigned(const TopicPartitions& partitions);
+
+    /**
+     * @brief Remove partitions revoked by a rebalance, they are not paused any more
+     */
+    void revoked(const TopicPartitions& partitions);
+
+    /**
+     * @brief Read the queue depths and work out which partitions change state
+     * The returned changes are already applied to paused().
+     * @return The partitions to pause and to resume
+     */
+    Changes update();
+
+    /**
+     * @brief Get the partitions which are currently assigned
+     */
+    const TopicPartitions& assigned() const;
+
+    /**
+     * @brief Get the partitions which are currently paused
+     */
+    const TopicPartitions& paused() const;
+
+    /**
+     * @brief Get how many times a handler thread was throttled
+     */
+    std::size_t throttleCount() const;
+
+private:
+    Options mOptions;
+    const PartitionDispatcher& mDispatcher;
+    std::vector<bool> mThrottled; // per handler thread
+    TopicPartitions mAssigned;
+    TopicPartitions mPaused;
+    std::size_t mThrottleCount = 0;
+};
+
+#endif // PARTITION_BACKPRESSURE_H
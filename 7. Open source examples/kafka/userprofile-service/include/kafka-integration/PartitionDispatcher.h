@@ -0,0 +1,140 @@
+/**
+ * @file PartitionDispatcher.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of PartitionDispatcher class
+ * * This class hands consumed events to a fixed set of handler threads.
+ * * Events of the same partition, or of the same key, always go to the same thread.
+ */
+
+#ifndef PARTITION_DISPATCHER_H
+#define PARTITION_DISPATCHER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Event.h"
+#include "utils.h"
+
+/**
+ * @brief PartitionDispatcher class
+ * Every worker owns a bounded queue. dispatch() blocks while the queue of a target worker is full,
+ * so a slow handler slows the consumer down instead of growing memory. A worker takes all queued
+ * events at once, up to maxBatch, and hands them to the processor as one batch.
+ */
+class PartitionDispatcher
+{
+public:
+    using Ordering = user_profile::utils::consumer::DispatchOrdering;
+
+    /**
+     * @brief Handles a batch of events on a worker thread, in dispatch order
+     */
+    using Processor = std::function<void(std::size_t worker, std::vector<Event>& events)>;
+
+    /**
+     * @brief Dispatch options
+     */
+    struct Options
+    {
+        std::size_t workers = 4;
+        std::size_t queueCapacity = 1000; ///< Events queued per worker before dispatch() waits
+        std::size_t maxBatch = 500;       ///< Events handed to the processor at once
+        Ordering ordering = Ordering::ePartition;
+    };
+
+    /**
+     * @brief Constructor for PartitionDispatcher class
+     * Starts the worker threads.
+     * @param options The dispatch options
+     * @param processor The function which handles a batch of events
+     */
+    PartitionDispatcher(Options options, Processor processor);
+
+    /**
+     * @brief Destructor for PartitionDispatcher class
+     * Handles every queued event and stops the worker threads.
+     */
+    ~PartitionDispatcher();
+
+    PartitionDispatcher(const PartitionDispatcher&) = delete;
+    PartitionDispatcher& operator=(const PartitionDispatcher&) = delete;
+
+    /**
+     * @brief Queue events on their workers
+     * Events are grouped per worker first, so each worker queue is locked once per call.
+     * @param events The events, in offset order per partition; the vector is left empty
+     * @return false if the dispatcher is stopping and the events were dropped
+     */
+    bool dispatch(std::vector<Event>&& events);
+
+    /**
+     * @brief Wait until every dispatched event has been handled
+     */
+    void drain();
+
+    /**
+     * @brief Handle every queued event and stop the worker threads
+     */
+    void stop();
+
+    /**
+     * @brief Get the worker an event is routed to
+     * @param event The event, its topic and partition or its key decide the worker
+     * @return The worker index
+     */
+    std::size_t workerFor(const Event& event) const;
+
+    /**
+     * @brief Get the worker the keyless events of a partition are routed to
+     * With Ordering::eKey, keyed events of the partition may go to any worker.
+     * @param topic The topic
+     * @param partition The partition
+     * @return The worker index
+     */
+    std::size_t workerFor(std::string_view topic, std::int32_t partition) const;
+
+    /**
+     * @brief Get how events are routed to workers
+     */
+    Ordering ordering() const;
+
+    /**
+     * @brief Get the number of events queued on a worker, not counting the batch it handles
+     */
+    std::size_t queueDepth(std::size_t worker) const;
+
+    /**
+     * @brief Get the number of workers
+     */
+    std::size_t workerCount() const;
+
+private:
+    struct Worker
+    {
+        mutable std::mutex mutex;
+        std::condition_variable work;  // wakes the worker thread
+        std::condition_variable space; // wakes dispatch() and drain() callers
+        std::deque<Event> queue;
+        bool busy = false;
+        bool stopping = false;
+        std::thread thread;
+    };
+
+    void workerLoop(Worker& worker, std::size_t index);
+
+    Options mOptions;
+    Processor mProcessor;
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+};
+
+#endif // PARTITION_DISPATCHER_H
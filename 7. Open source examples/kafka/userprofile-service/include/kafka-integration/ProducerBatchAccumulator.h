@@ -0,0 +1,168 @@
+/**
+ * @file ProducerBatchAccumulator.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of ProducerBatchAccumulator class
+ * * This class groups outgoing records by topic and partition before they are sent.
+ * * A batch is handed to the sink when it is full or when its linger time has passed.
+ */
+
+#ifndef PRODUCER_BATCH_ACCUMULATOR_H
+#define PRODUCER_BATCH_ACCUMULATOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "SharedPayload.h"
+
+class ProducerBatchAccumulator
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int kUnassignedPartition = -1; ///< Let the client partitioner decide
+
+    using DeliveryCallback = std::function<void(bool delivered)>; ///< Reports the outcome of one record
+    using Headers = std::vector<std::pair<std::string, std::string>>; ///< Record headers, name and value
+
+    /**
+     * @brief A single record waiting in a batch
+     */
+    struct Record
+    {
+        std::string key;
+        SharedPayload value; // shared, never copied while it waits in the batch
+        Clock::time_point enqueuedAt;
+        DeliveryCallback onDelivery; // optional
+        Headers headers; // optional, sent with the record
+    };
+
+    /**
+     * @brief Records of one topic-partition that are sent together
+     */
+    struct Batch
+    {
+        std::string topic;
+        int partition = kUnassignedPartition;
+        std::vector<Record> records;
+        Clock::time_point createdAt;
+    };
+
+    /**
+     * @brief Batching options
+     * batchSize is the number of records which closes a batch,
+     * linger is the longest time an open batch waits for more records.
+     */
+    struct Options
+    {
+        std::size_t batchSize = 100;
+        std::chrono::milliseconds linger{5};
+        int partitionCount = 1;
+    };
+
+    using BatchSink = std::function<void(Batch&&)>; ///< Called on the sender thread for every closed batch
+
+    /**
+     * @brief Constructor for ProducerBatchAccumulator class
+     * Starts the sender thread which hands closed batches to the sink.
+     * @param options The batching options
+     * @param sink The function which sends a batch
+     */
+    ProducerBatchAccumulator(Options options, BatchSink sink);
+
+    /**
+     * @brief Destructor for ProducerBatchAccumulator class
+     * Sends every pending batch and stops the sender thread.
+     */
+    ~ProducerBatchAccumulator();
+
+    ProducerBatchAccumulator(const ProducerBatchAccumulator&) = delete;
+    ProducerBatchAccumulator& operator=(const ProducerBatchAccumulator&) = delete;
+
+    /**
+     * @brief Append a record to the batch of its topic-partition
+     * @param topic The topic of the record
+     * @param key The key of the record, also used to pick the partition
+     * @param value The value of the record, kept alive until the sink releases it
+     * @param onDelivery Optional callback the sink invokes with the delivery outcome
+     * @param headers Optional headers of the record
+     * @return true if the record was accepted, false if the accumulator is stopping
+     */
+    bool append(const std::string& topic, const std::string& key, SharedPayload value,
+        DeliveryCallback onDelivery = {}, Headers headers = {});
+
+    /**
+     * @brief Send every pending batch regardless of its linger time
+     * This method blocks until the sink has received all records appended before the call.
+     */
+    void flush();
+
+    /**
+     * @brief Drop every record which has not been handed to the sink yet
+     * This method blocks until a batch the sink is currently sending has been handed over.
+     * @return The dropped records, the caller reports their delivery failure
+     */
+    std::vector<Record> discard();
+
+    /**
+     * @brief Drop queued batches of topics with a priority lower than the given one
+     * The lowest priority batches go first, until enough bytes and enough records are freed.
+     * @param priorityOf Returns the priority of a topic
+     * @param priority Only topics with a lower priority are dropped
+     * @param bytesNeeded Key and value bytes to free
+     * @param recordsNeeded Records to free
+     * @return The dropped records, the caller reports their delivery failure
+     */
+    std::vector<Record> evictBelowPriority(const std::function<int(const std::string&)>& priorityOf,
+        int priority, std::size_t bytesNeeded, std::size_t recordsNeeded);
+
+    /**
+     * @brief Get the number of records which have not been handed to the sink yet
+     * @return The number of pending records
+     */
+    std::size_t pendingRecords() const;
+
+    /**
+     * @brief Pick a partition for a key
+     * @param key The record key
+     * @param partitionCount The number of partitions of the topic
+     * @return The partition, or kUnassignedPartition if the topic has a single partition configured
+     */
+    static int partitionFor(std::string_view key, int partitionCount);
+
+private:
+    using BatchKey = std::pair<std::string, int>; // topic, partition
+
+    void senderLoop();
+    void closeBatch(std::map<BatchKey, Batch>::iterator it);
+    void closeExpiredBatches(Clock::time_point now, bool all);
+    std::size_t takeRecords(std::vector<Batch>& batches, std::vector<Record>& records);
+
+    Options mOptions;
+    BatchSink mSink;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mSenderCv;   // wakes the sender thread
+    std::condition_variable mDrainedCv;  // wakes flush() callers
+    std::map<BatchKey, Batch> mOpenBatches;
+    std::deque<Batch> mReadyBatches;
+    std::size_t mPendingRecords = 0;
+    std::uint64_t mEnqueuedBatches = 0; // batches ever moved to mReadyBatches
+    std::uint64_t mSentBatches = 0;     // batches ever handed to the sink
+    bool mStopping = false;
+
+    std::thread mSender; // must be the last member, it starts in the constructor
+};
+
+#endif // PRODUCER_BATCH_ACCUMULATOR_H
@@ -0,0 +1,101 @@
+/**
+ * @file ProducerPool.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of ProducerPool class
+ * * This class spreads publishing threads over several KafkaMessageProducer shards.
+ */
+
+#ifndef PRODUCER_POOL_H
+#define PRODUCER_POOL_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "KafkaMessageProducer.h"
+#include "ShardRouter.h"
+
+/**
+ * @brief ProducerPool class
+ * Every shard owns its own batch accumulator and Kafka client, so publishers on different
+ * shards never contend. A key always maps to the same shard, which keeps per-user ordering;
+ * records without a key use the shard the calling thread is affine to.
+ */
+class ProducerPool
+{
+public:
+    using DeliveryCallback = KafkaMessageProducer::DeliveryCallback;
+
+    /**
+     * @brief Constructor for ProducerPool class
+     * @param config The service configuration, getProducerShards() gives the number of shards.
+     *               The in-flight budget is split evenly between the shards.
+     * @param bus The bus every shard publishes to, each shard has a producer of its own on it
+     */
+    ProducerPool(const ServiceConfig& config, std::shared_ptr<IMessageBus> bus);
+
+    /**
+     * @brief Destructor for ProducerPool class
+     */
+    ~ProducerPool();
+
+    /**
+     * @brief Initialize every shard
+     * Fails for a config with a transactional id, transactions need a single KafkaMessageProducer.
+     * @return true if all shards were initialized
+     */
+    bool initialize();
+
+    /**
+     * @brief Send a message through the shard of its key
+     * @see KafkaMessageProducer::sendMessage
+     */
+    bool sendMessage(const std::string& topic, const std::string& key, const std::string& message);
+
+    /**
+     * @brief Send a shared payload through the shard of its key without copying it
+     * @see KafkaMessageProducer::sendMessage
+     */
+    bool sendMessage(const std::string& topic, const std::string& key, SharedPayload payload,
+        DeliveryCallback onDelivery = {});
+
+    /**
+     * @brief Send an event through the shard of its key without copying it
+     * @see KafkaMessageProducer::sendEvent
+     */
+    bool sendEvent(const std::string& topic, const std::string& key, Event::EventType type,
+        const std::string& eventId, SharedPayload payload, DeliveryCallback onDelivery = {});
+
+    /**
+     * @brief Get the shard which owns a key
+     * @param key The record key, empty for the calling thread's shard
+     * @return The producer shard
+     */
+    KafkaMessageProducer& shardFor(std::string_view key);
+
+    /**
+     * @brief Flush every shard
+     * @return true if all shards were flushed
+     */
+    bool flush();
+
+    /**
+     * @brief Get the metrics of every shard
+     * @return One snapshot per shard, in shard order
+     */
+    std::vector<ProducerMetrics::Snapshot> metricsSnapshot() const;
+
+    /**
+     * @brief Get the number of shards
+     */
+    std::size_t shardCount() const;
+
+private:
+    ShardRouter mRouter;
+    std::vector<std::unique_ptr<KafkaMessageProducer>> mShards;
+    bool mTransactional = false;
+};
+
+#endif // PRODUCER_POOL_H
@@ -0,0 +1,77 @@
+/**
+ * @file ReplayDecoder.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of ReplayDecoder class
+ * * This class turns replayed user events into the final state of every user, decoding in parallel.
+ */
+
+#ifndef REPLAY_DECODER_H
+#define REPLAY_DECODER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Event.h"
+#include "User.h"
+
+/**
+ * @brief ReplayDecoder class
+ * Events are buffered in record order. decode() splits the buffer into contiguous chunks and
+ * parses them on several threads, then folds the results in record order, so only the last
+ * event of a user within the buffer is written. Rebuilding a table from a topic then costs
+ * one row per user and batch instead of one statement per record.
+ * This class is only used from one thread; the parallelism is internal to decode().
+ */
+class ReplayDecoder
+{
+public:
+    /**
+     * @brief Final state of the users of a batch
+     */
+    struct Batch
+    {
+        std::vector<User> upserts;
+        std::vector<std::string> removedIds;
+        std::size_t records = 0; ///< Events folded into the batch
+        std::size_t skipped = 0; ///< Events without a decodable user or of another type
+    };
+
+    /**
+     * @brief Constructor for ReplayDecoder class
+     * @param threads Number of threads decode() parses on, including the calling thread
+     */
+    explicit ReplayDecoder(std::size_t threads);
+
+    /**
+     * @brief Buffer an event, in record order
+     */
+    void add(Event&& event);
+
+    /**
+     * @brief Get the number of buffered events
+     */
+    std::size_t buffered() const;
+
+    /**
+     * @brief Decode the buffered events and clear the buffer
+     * @return The final state of every user touched by the buffered events
+     */
+    Batch decode();
+
+private:
+    struct Decoded
+    {
+        Event::EventType type = Event::EventType::eUnknown;
+        User user;
+    };
+
+    static void decodeRange(const Event* begin, const Event* end, Decoded* out);
+
+    std::size_t mThreads;
+    std::vector<Event> mEvents;
+    std::vector<Decoded> mDecoded; // reused between batches
+};
+
+#endif // REPLAY_DECODER_H
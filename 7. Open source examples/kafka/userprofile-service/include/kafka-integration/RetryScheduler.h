@@ -0,0 +1,212 @@
+/**
+ * @file RetryScheduler.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of RetryScheduler class
+ * * This class retries events whose handlers failed on its own thread and dead-letters them
+ * * once they run out of attempts, so a failing event never holds up its partition.
+ */
+
+#ifndef RETRY_SCHEDULER_H
+#define RETRY_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ConsumerMetrics.h"
+#include "Event.h"
+#include "Handler.h"
+#include "OffsetTracker.h"
+
+/**
+ * @brief RetryScheduler class
+ * Pending retries sit in a hashed timer wheel: scheduling and expiring an event is constant
+ * time however many are waiting. A retry only runs the handlers which failed the event, the
+ * delay doubles after every failed attempt, and after the last attempt the event goes to the
+ * dead-letter sink. Once an event leaves the scheduler, retried or dead-lettered, the
+ * completion callback releases its offset. The partition keeps being consumed meanwhile;
+ * only its committed offset waits for the event. A later event of the same key can therefore
+ * be handled first; a handler which handled it is no longer retried with the older event.
+ * An event the dead-letter sink refuses keeps its offset held and is offered to the sink again
+ * after the longest backoff.
+ */
+class RetryScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Handlers = std::vector<std::shared_ptr<Handler>>;
+    using Snapshot = ConsumerMetrics::RetrySnapshot;
+
+    /**
+     * @brief Takes an event which ran out of attempts
+     * @return true if the event was stored, false holds its offset and retries the sink after the longest backoff
+     */
+    using DeadLetter = std::function<bool(const Event& event, std::size_t attempts)>;
+
+    /**
+     * @brief Called once an event leaves the scheduler, normally to complete its offset
+     */
+    using Completion = std::function<void(const Event& event)>;
+
+    /**
+     * @brief Runs one retry of an event by one handler, normally HandlerFanOut::handleRetry
+     * @return true if the handler handled the event
+     */
+    using Attempt = std::function<bool(const std::shared_ptr<Handler>& handler, const Event& event)>;
+
+    /**
+     * @brief Retry options
+     * maxAttempts counts the first, failed attempt. The pending limits bound the memory of the
+     * queue; an event beyond them is dead-lettered at once. tick is the wheel resolution.
+     */
+    struct Options
+    {
+        std::size_t maxAttempts = 5;
+        std::chrono::milliseconds initialBackoff{100};
+        std::chrono::milliseconds maxBackoff{30000};
+        std::size_t maxPendingEvents = 10000;
+        std::size_t maxPendingBytes = 64 * 1024 * 1024;
+        std::chrono::milliseconds tick{10};
+        std::size_t slots = 512;
+    };
+
+    /**
+     * @brief Constructor for RetryScheduler class
+     * Starts the thread which runs the retries.
+     * @param options The retry options
+     * @param deadLetter The sink for events which ran out of attempts
+     * @param completion The callback for events which left the scheduler
+     * @param attempt Runs a retry, Handler::handleEvent when empty
+     */
+    RetryScheduler(Options options, DeadLetter deadLetter, Completion completion, Attempt attempt = {});
+
+    /**
+     * @brief Destructor for RetryScheduler class
+     * Stops the retry thread, see stop().
+     */
+    ~RetryScheduler();
+
+    RetryScheduler(const RetryScheduler&) = delete;
+    RetryScheduler& operator=(const RetryScheduler&) = delete;
+
+    /**
+     * @brief Queue an event whose handlers failed its first attempt
+     * @param event The event
+     * @param failed The handlers which failed it, only these are retried
+     * @return true if the event was queued, false if the queue was full and it was dead-lettered,
+     *         or held without completion when the dead-letter sink refused it too
+     */
+    bool schedule(Event event, Handlers failed);
+
+    /**
+     * @brief Record the handlers which handled an event, so older pending events of its key skip them
+     * Returns at once while no pending event has a key.
+     * @param event The handled event
+     * @param handlers The handlers the event was routed to
+     * @param failed The handlers which failed it, they did not handle it
+     */
+    void supersede(const Event& event, const Handlers& handlers, const Handlers& failed);
+
+    /**
+     * @brief Check whether a pending event has a key, see supersede()
+     */
+    bool hasPendingKeys() const;
+
+    /**
+     * @brief Drop the pending events of partitions, normally because they were revoked
+     * Waits for a running retry to finish. Dropped events are not completed, so the new owner
+     * of the partition consumes them again.
+     * @param partitions The partitions to drop
+     */
+    void forget(const OffsetTracker::TopicPartitions& partitions);
+
+    /**
+     * @brief Stop the retry thread
+     * Pending events are dropped without completion and are consumed again after a restart.
+     */
+    void stop();
+
+    /**
+     * @brief Get the retry counters
+     */
+    Snapshot stats() const;
+
+private:
+    struct Entry
+    {
+        Event event;
+        Handlers handlers;        // still failing the event
+        std::size_t attempts = 1;
+        std::size_t rounds = 0;   // wheel turns left before the entry is due
+        std::size_t bytes = 0;
+    };
+
+    /**
+     * @brief The newest event of a key a handler handled
+     */
+    struct Handled
+    {
+        const Handler* handler;
+        std::string topic;
+        std::int32_t partition;
+        std::int64_t offset;
+    };
+
+    /**
+     * @brief The pending events of a key and what superseded them
+     */
+    struct KeyState
+    {
+        std::size_t pending = 0;
+        std::vector<Handled> handled;
+    };
+
+    static std::size_t entryBytes(const Entry& entry);
+
+    std::chrono::milliseconds backoff(std::size_t attempts) const;
+    void insertLocked(Entry&& entry, std::chrono::milliseconds delay);
+    void retry(Entry& entry);
+    bool deadLetter(const Entry& entry);
+    void trackLocked(const Entry& entry);
+    void untrackLocked(const Entry& entry);
+    bool dropSupersededLocked(Entry& entry);
+    void timerLoop();
+
+    Options mOptions;
+    DeadLetter mDeadLetter;
+    Completion mCompletion;
+    Attempt mAttempt;
+
+    std::mutex mRunMutex; // held while due entries are outside the wheel, taken before mMutex
+    mutable std::mutex mMutex;
+    std::condition_variable mCv;
+    std::vector<std::vector<Entry>> mSlots;
+    std::size_t mCursor = 0;
+    Clock::time_point mNextTick;
+    std::size_t mPendingEvents = 0;
+    std::size_t mPendingBytes = 0;
+    std::unordered_map<std::string, KeyState> mKeys; // keys of the pending events
+    std::atomic<std::size_t> mPendingKeys{0};         // mKeys.size(), read without the lock
+    bool mStopping = false;
+
+    std::atomic<std::uint64_t> mScheduled{0};
+    std::atomic<std::uint64_t> mRetries{0};
+    std::atomic<std::uint64_t> mRecovered{0};
+    std::atomic<std::uint64_t> mDeadLettered{0};
+    std::atomic<std::uint64_t> mRejected{0};
+    std::atomic<std::uint64_t> mSuperseded{0};
+
+    std::thread mTimer; // must be the last member, it starts in the constructor
+};
+
+#endif // RETRY_SCHEDULER_H
@@ -0,0 +1,81 @@
+/**
+ * @file ShardRouter.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of ShardRouter class
+ * * This class maps record keys and publishing threads to producer shards.
+ */
+
+#ifndef SHARD_ROUTER_H
+#define SHARD_ROUTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+class ShardRouter
+{
+public:
+    /**
+     * @brief Constructor with the number of shards
+     * @param shardCount The number of shards, at least 1
+     */
+    explicit ShardRouter(std::size_t shardCount)
+        : mShardCount(std::max<std::size_t>(shardCount, 1))
+    {
+    }
+
+    /**
+     * @brief Pick the shard of a record
+     * Keyed records always go to the same shard, which keeps per-key ordering.
+     * Records without a key go to the shard the calling thread is affine to.
+     * @param key The record key
+     * @return The shard index
+     */
+    std::size_t shardFor(std::string_view key) const
+    {
+        if (key.empty()) {
+            return shardForThread();
+        }
+        return hashKey(key) % mShardCount;
+    }
+
+    /**
+     * @brief Get the shard the calling thread is affine to
+     * Threads are spread round-robin over the shards on their first call.
+     * @return The shard index
+     */
+    std::size_t shardForThread() const
+    {
+        thread_local const std::size_t slot = sNextThreadSlot.fetch_add(1, std::memory_order_relaxed);
+        return slot % mShardCount;
+    }
+
+    /**
+     * @brief Get the number of shards
+     */
+    std::size_t shardCount() const { return mShardCount; }
+
+    /**
+     * @brief Hash a key, stable across processes and builds (32-bit FNV-1a)
+     * @param key The key
+     * @return The hash
+     */
+    static std::uint32_t hashKey(std::string_view key)
+    {
+        std::uint32_t hash = 2166136261u;
+        for (const char c : key) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+private:
+    std::size_t mShardCount;
+    inline static std::atomic<std::size_t> sNextThreadSlot{0};
+};
+
+#endif // SHARD_ROUTER_H
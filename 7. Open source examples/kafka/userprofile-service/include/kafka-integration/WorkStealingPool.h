@@ -0,0 +1,82 @@
+/**
+ * @file WorkStealingPool.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of WorkStealingPool class
+ * * This class runs short tasks on a fixed set of threads shared by every submitter.
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief WorkStealingPool class
+ * Every thread owns a deque. A task submitted from a pool thread goes to the deque of that
+ * thread, other submitters spread their tasks round-robin. A thread takes work from the front
+ * of its own deque and, once that is empty, steals from the back of the others, so one thread
+ * stuck in a slow task does not strand the tasks queued behind it.
+ * Tasks must not wait for other tasks of the same pool.
+ */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Constructor for WorkStealingPool class
+     * Starts the threads.
+     * @param threads Number of threads, at least one is started
+     */
+    explicit WorkStealingPool(std::size_t threads);
+
+    /**
+     * @brief Destructor for WorkStealingPool class
+     * Runs every queued task and stops the threads.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Queue a task, it runs on one of the pool threads
+     * @param task The task
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Get the number of threads
+     */
+    std::size_t threadCount() const;
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool tryTake(std::size_t self, Task& task);
+    void workerLoop(std::size_t index);
+
+    std::vector<std::unique_ptr<Queue>> mQueues;
+    std::vector<std::thread> mThreads;
+    std::atomic<std::size_t> mNextQueue{0};
+    std::atomic<std::size_t> mPending{0}; // queued tasks, not counting the running ones
+
+    std::mutex mSleepMutex;
+    std::condition_variable mWake;
+    bool mStopping = false;
+};
+
+#endif // WORK_STEALING_POOL_H
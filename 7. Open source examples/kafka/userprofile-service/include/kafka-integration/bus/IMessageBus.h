@@ -0,0 +1,262 @@
+/**
+ * @file IMessageBus.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file contains the interface for a partitioned message bus
+ * * Producers and consumer groups talk to the bus the way they talk to Kafka, so the pipeline
+ * * can run against a broker cluster or against an in-process stand-in.
+ */
+
+#ifndef IMESSAGE_BUS_H
+#define IMESSAGE_BUS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SharedPayload.h"
+#include "bus/PolledBatch.h"
+#include "utils.h"
+
+/**
+ * @brief IMessageBus interface
+ * Topics are split into partitions and every record gets the next offset of its partition.
+ * Consumers of the same group share the partitions of their topics, consumers of different
+ * groups each read every record. Offsets follow the Kafka convention, a committed offset is
+ * the next offset to consume. The types match KAFKA_API::TopicPartition and
+ * KAFKA_API::TopicPartitionOffsets.
+ * Consumers read committed records only: records of an open transaction are held back and
+ * those of an aborted one are skipped. Transaction markers take up an offset, so consecutive
+ * records of a partition do not always have consecutive offsets.
+ * Failures are returned, never thrown.
+ */
+class IMessageBus
+{
+public:
+    using TopicPartition = std::pair<std::string, std::int32_t>;
+    using TopicPartitions = std::set<TopicPartition>;
+    using Offsets = std::map<TopicPartition, std::int64_t>;
+    using Headers = std::vector<std::pair<std::string, std::string>>;
+    using RebalanceType = user_profile::utils::consumer::RebalanceType;
+    using Timestamp = std::chrono::system_clock::time_point;
+
+    /**
+     * @brief A record as published, consumed records come in a PolledBatch
+     */
+    struct Record
+    {
+        std::string topic;
+        std::int32_t partition = -1; ///< -1 on publish picks the partition from the key
+        std::int64_t offset = -1;    ///< Set by the bus
+        std::string key;
+        SharedPayload value;
+        Headers headers;
+        Timestamp timestamp;         ///< Set by the bus
+    };
+
+    /**
+     * @brief Called once a published record was stored or refused
+     */
+    using DeliveryCallback = std::function<void(const Record& record, bool delivered)>;
+
+    /**
+     * @brief Called from Consumer::poll() when the partitions of a consumer change
+     */
+    using RebalanceCallback = std::function<void(RebalanceType type, const TopicPartitions& partitions)>;
+
+    /**
+     * @brief Producer options
+     */
+    struct ProducerOptions
+    {
+        std::string clientId;        ///< Empty uses the one of the bus configuration
+        std::string transactionalId; ///< Makes the producer transactional, unique per producer
+        bool idempotent = false;     ///< Retries never duplicate a record, implied by a transactional id
+    };
+
+    /**
+     * @brief Publishes records, safe to use from several threads
+     */
+    class Producer
+    {
+    public:
+        virtual ~Producer() = default;
+
+        /**
+         * @brief Publish a record
+         * A transactional producer only publishes inside a transaction, the record becomes
+         * visible to consumers when the transaction commits.
+         * @param record The record, its offset is ignored
+         * @param onDelivery Called once the record was stored, may be empty
+         * @return true if the record was accepted, onDelivery is not called otherwise
+         */
+        virtual bool publish(Record record, DeliveryCallback onDelivery) = 0;
+
+        /**
+         * @brief Wait until every accepted record got its delivery callback
+         * @return true if nothing is left undelivered
+         */
+        virtual bool flush() = 0;
+
+        /**
+         * @brief Register the transactional id, before the first transaction
+         * Fences older producers with the same transactional id and aborts their open transaction.
+         * @return false if the producer is not transactional or the registration failed
+         */
+        virtual bool initTransactions() = 0;
+
+        /**
+         * @brief Start a transaction
+         * @return false if a transaction is open or the producer was fenced
+         */
+        virtual bool beginTransaction() = 0;
+
+        /**
+         * @brief Make the records of the open transaction visible, all of them at once
+         * @return false if the commit failed, the transaction must then be aborted
+         */
+        virtual bool commitTransaction() = 0;
+
+        /**
+         * @brief Discard the records of the open transaction
+         * @return false if the abort failed, the producer can not start another transaction
+         */
+        virtual bool abortTransaction() = 0;
+    };
+
+    /**
+     * @brief Member of a consumer group, or a reader of assigned partitions, used from one thread
+     */
+    class Consumer
+    {
+    public:
+        virtual ~Consumer() = default;
+
+        /**
+         * @brief Join the group and share the partitions of the topics with its other members
+         * @param topics The topics to read
+         * @param onRebalance Called from poll() when partitions are assigned or revoked, may be empty
+         */
+        virtual void subscribe(const std::set<std::string>& topics, RebalanceCallback onRebalance) = 0;
+
+        /**
+         * @brief Read partitions without a group, starting at their log start
+         * @param partitions The partitions to read
+         */
+        virtual void assign(const TopicPartitions& partitions) = 0;
+
+        /**
+         * @brief Fetch the next records of the assigned partitions which are not paused
+         * @param timeout How long to wait for a record
+         * @return The records, in offset order per partition; never null, empty if none arrived
+         */
+        virtual std::shared_ptr<const PolledBatch> poll(std::chrono::milliseconds timeout) = 0;
+
+        /**
+         * @brief Move the position of an assigned partition
+         * @param partition The partition
+         * @param offset The offset the next poll reads from
+         */
+        virtual void seek(const TopicPartition& partition, std::int64_t offset) = 0;
+
+        /**
+         * @brief Get the offset the next poll reads from, past skipped transaction markers
+         * @return The position, -1 if the partition is not assigned or the position is unknown
+         */
+        virtual std::int64_t position(const TopicPartition& partition) const = 0;
+
+        /**
+         * @brief Commit offsets for the group and wait for the result
+         * @param offsets The next offset to consume of every partition
+         * @return true if the offsets were committed
+         */
+        virtual bool commit(const Offsets& offsets) = 0;
+
+        /**
+         * @brief Commit offsets for the group without waiting
+         * A failure is logged, the next commit carries higher offsets and supersedes it.
+         * @param offsets The next offset to consume of every partition
+         */
+        virtual void commitAsync(const Offsets& offsets) = 0;
+
+        /**
+         * @brief Get the committed offsets of the group, partitions without a commit are left out
+         */
+        virtual Offsets committed(const TopicPartitions& partitions) const = 0;
+
+        /**
+         * @brief Get the first offset still in the log of every partition
+         */
+        virtual Offsets beginningOffsets(const TopicPartitions& partitions) const = 0;
+
+        /**
+         * @brief Get the end offset of every partition
+         * The end is the first offset of the oldest open transaction if there is one, a consumer
+         * does not read past it.
+         */
+        virtual Offsets endOffsets(const TopicPartitions& partitions) const = 0;
+
+        /**
+         * @brief Get the first offset of every partition with a timestamp at or after a time
+         * @return The offsets, -1 for a partition without such a record
+         */
+        virtual Offsets offsetsForTime(const TopicPartitions& partitions, Timestamp time) const = 0;
+
+        /**
+         * @brief Get the partitions of a topic from the broker metadata
+         * @return The partitions, empty if the topic is unknown or the metadata could not be fetched
+         */
+        virtual TopicPartitions partitionsFor(const std::string& topic) const = 0;
+
+        /**
+         * @brief Stop fetching from partitions, they stay assigned
+         */
+        virtual void pause(const TopicPartitions& partitions) = 0;
+
+        /**
+         * @brief Fetch again from paused partitions
+         */
+        virtual void resume(const TopicPartitions& partitions) = 0;
+
+        /**
+         * @brief Revoke the partitions of this consumer and leave the group
+         */
+        virtual void close() = 0;
+    };
+
+    virtual ~IMessageBus() = default;
+
+    /**
+     * @brief Create a topic, nothing happens if it exists
+     * Publishing to an unknown topic creates it with the default partition count of the bus.
+     * @param topic The topic name
+     * @param partitions The partition count, must be greater than 0
+     * @return true if the topic exists afterwards
+     */
+    virtual bool createTopic(const std::string& topic, std::int32_t partitions) = 0;
+
+    /**
+     * @brief Create a producer
+     * @param options The client and transactional ids
+     * @return The producer, null if it could not be created; it must not outlive the bus
+     */
+    virtual std::unique_ptr<Producer> createProducer(const ProducerOptions& options) = 0;
+
+    /**
+     * @brief Create a consumer
+     * @param groupId The group, its committed offsets are where new members start; empty for a
+     *        consumer which only reads assigned partitions and commits nothing
+     * @param maxPollRecords Most records one poll returns
+     * @return The consumer, null if it could not be created; it must not outlive the bus
+     */
+    virtual std::unique_ptr<Consumer> createConsumer(const std::string& groupId, std::size_t maxPollRecords) = 0;
+};
+
+#endif // IMESSAGE_BUS_H
@@ -0,0 +1,160 @@
+/**
+ * @file InProcessMessageBus.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file contains the declarations for the in-process message bus
+ */
+
+#ifndef IN_PROCESS_MESSAGE_BUS_H
+#define IN_PROCESS_MESSAGE_BUS_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "bus/IMessageBus.h"
+
+/**
+ * @brief InProcessMessageBus class
+ * A broker stand-in for load tests and benchmarks without a cluster. Partitions are in-memory
+ * logs, a record goes to the partition of its key hash like the Kafka default partitioner,
+ * and consumer groups spread partitions round-robin over their members. A partition moves to
+ * its new owner only after the previous owner returned from its revoke callback, so offsets
+ * committed there are where the new owner starts. Consumers without a commit start at the
+ * log start. The latencies model the acknowledgement and the replication before a record
+ * becomes visible to consumers.
+ * Transactions follow Kafka: records of an open transaction stay in the log but are not
+ * fetched, and neither is anything behind them; the commit or abort appends a marker to every
+ * partition the transaction wrote to. initTransactions() fences the previous producer with the
+ * same transactional id and aborts its open transaction.
+ * All topic, group and transaction state is behind one mutex.
+ */
+class InProcessMessageBus : public IMessageBus
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Bus options
+     */
+    struct Options
+    {
+        std::int32_t defaultPartitions = 3;
+        std::chrono::microseconds deliveryLatency{0};   ///< Publish to delivery callback
+        std::chrono::microseconds visibilityLatency{0}; ///< Publish to the record being fetchable
+        std::size_t retentionRecords = 0;               ///< Records kept per partition, 0 keeps all
+    };
+
+    explicit InProcessMessageBus(Options options);
+
+    /**
+     * @brief Destructor for InProcessMessageBus class
+     * Delivery callbacks still waiting for their latency are dropped.
+     */
+    ~InProcessMessageBus() override;
+
+    InProcessMessageBus(const InProcessMessageBus&) = delete;
+    InProcessMessageBus& operator=(const InProcessMessageBus&) = delete;
+
+    bool createTopic(const std::string& topic, std::int32_t partitions) override;
+    std::unique_ptr<Producer> createProducer(const ProducerOptions& options) override;
+    std::unique_ptr<Consumer> createConsumer(const std::string& groupId, std::size_t maxPollRecords) override;
+
+private:
+    class BusProducer;
+    class GroupConsumer;
+
+    using StoredRecords = std::vector<std::shared_ptr<const Record>>;
+
+    struct StoredRecord
+    {
+        std::shared_ptr<Record> record; // shared with the poll batches it was fetched in
+        Clock::time_point visibleAt; // max while its transaction is open
+        bool control = false;        // a transaction marker, never fetched
+        bool aborted = false;        // written by an aborted transaction, never fetched
+    };
+
+    struct Partition
+    {
+        std::deque<StoredRecord> log;
+        std::int64_t startOffset = 0;                 // offset of log.front()
+        std::multiset<std::int64_t> openTransactions; // first offset of every open transaction
+    };
+
+    struct Transaction
+    {
+        std::uint64_t epoch = 0;
+        std::map<TopicPartition, std::vector<std::int64_t>> offsets; // of its records, per partition
+    };
+
+    struct Member
+    {
+        std::set<std::string> topics;
+        RebalanceCallback onRebalance;
+        TopicPartitions assignment;      // as decided by the group, including pending changes
+        TopicPartitions pendingAssigned; // not announced to the member yet
+        TopicPartitions pendingRevoked;  // not announced to the member yet
+        TopicPartitions handingOver;     // revoked, until the revoke callback returned
+        TopicPartitions paused;
+        Offsets positions;               // of the announced partitions
+        std::size_t nextPartition = 0;   // round-robin start of the next fetch
+    };
+
+    struct Group
+    {
+        std::vector<std::shared_ptr<Member>> members; // in join order
+        Offsets committed;
+    };
+
+    struct PendingDelivery
+    {
+        Clock::time_point at;
+        Record record;
+        DeliveryCallback onDelivery;
+    };
+
+    std::vector<Partition>& topicLocked(const std::string& topic);
+    const Partition* partitionLocked(const TopicPartition& partition) const;
+    static std::int64_t stableOffsetLocked(const Partition& partition);
+    std::int64_t appendLocked(Partition& partition, StoredRecord stored);
+    void rebalanceLocked(Group& group);
+    bool handingOverLocked(const Group& group, const TopicPartition& partition) const;
+    void endTransactionLocked(Transaction& transaction, bool commit);
+    void deliveryLoop();
+
+    // Used by BusProducer
+    bool publish(Record record, DeliveryCallback onDelivery, const std::string& transactionalId, std::uint64_t epoch);
+    std::uint64_t registerProducer(const std::string& transactionalId);
+    bool beginTransaction(const std::string& transactionalId, std::uint64_t epoch);
+    bool endTransaction(const std::string& transactionalId, std::uint64_t epoch, bool commit);
+    void flushDeliveries();
+
+    // Used by GroupConsumer
+    void join(const std::string& groupId, const std::shared_ptr<Member>& member, const std::set<std::string>& topics,
+        RebalanceCallback onRebalance);
+    void leave(const std::string& groupId, const std::shared_ptr<Member>& member);
+    void announce(const std::string& groupId, Member& member);
+    StoredRecords fetch(const std::string& groupId, Member& member, std::size_t maxRecords,
+        std::chrono::milliseconds timeout);
+
+    Options mOptions;
+
+    mutable std::mutex mMutex;
+    std::condition_variable mRecordsCv; // records published or a rebalance happened
+    std::map<std::string, std::vector<Partition>> mTopics;
+    std::map<std::string, Group> mGroups;
+    std::map<std::string, std::uint64_t> mProducerEpochs; // by transactional id
+    std::map<std::string, Transaction> mTransactions;     // the open ones, by transactional id
+    std::uint64_t mNextUnkeyed = 0;
+
+    std::mutex mDeliveryMutex;
+    std::condition_variable mDeliveryCv;
+    std::condition_variable mDeliveredCv;    // wakes flushDeliveries()
+    std::deque<PendingDelivery> mDeliveries; // in publish order, the latency is constant
+    std::size_t mDelivering = 0;             // taken off mDeliveries, callback still running
+    bool mStopping = false;
+    std::thread mDeliveryThread; // must be the last member, it starts in the constructor if there is a delivery latency
+};
+
+#endif // IN_PROCESS_MESSAGE_BUS_H
@@ -0,0 +1,47 @@
+/**
+ * @file KafkaMessageBus.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file contains the declarations for the message bus backed by a Kafka cluster
+ */
+
+#ifndef KAFKA_MESSAGE_BUS_H
+#define KAFKA_MESSAGE_BUS_H
+
+#include "ServiceConfig.h"
+#include "bus/IMessageBus.h"
+
+/**
+ * @brief KafkaMessageBus class
+ * Runs producers and consumers on modern-cpp-kafka clients. The brokers, ids and explicit
+ * client settings come from ServiceConfig; brokers fall back to kafka_const::kBrokers.
+ * Consumers read with isolation.level=read_committed and never commit on their own.
+ * Client exceptions are logged and turned into the return values of IMessageBus.
+ */
+class KafkaMessageBus : public IMessageBus
+{
+public:
+    /**
+     * @brief Constructor for KafkaMessageBus class
+     * @param config The service configuration, copied
+     */
+    explicit KafkaMessageBus(const ServiceConfig& config);
+
+    bool createTopic(const std::string& topic, std::int32_t partitions) override;
+    std::unique_ptr<Producer> createProducer(const ProducerOptions& options) override;
+    std::unique_ptr<Consumer> createConsumer(const std::string& groupId, std::size_t maxPollRecords) override;
+
+private:
+    class KafkaProducerAdapter;
+    class KafkaConsumerAdapter;
+
+    /**
+     * @brief Get the bootstrap servers
+     * @return The comma separated brokers, empty if none are configured
+     */
+    std::string brokers() const;
+
+    ServiceConfig mConfig;
+};
+
+#endif // KAFKA_MESSAGE_BUS_H
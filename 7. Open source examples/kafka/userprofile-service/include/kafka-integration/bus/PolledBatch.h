@@ -0,0 +1,99 @@
+/**
+ * @file PolledBatch.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file contains the declaration of the records of one consumer poll
+ */
+
+#ifndef POLLED_BATCH_H
+#define POLLED_BATCH_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "SharedPayload.h"
+
+/**
+ * @brief PolledBatch class
+ * The records of one poll and the arena of everything their fields point to. The topic, key
+ * and headers of a record view the bytes the bus returned, which the batch keeps alive, or
+ * names interned once per batch into a monotonic_buffer_resource with an inline first block.
+ * The bus fills the batch on the polling thread and shares it read-only afterwards, so events
+ * can point into it and the whole batch is released in one step once the last of them is gone.
+ */
+class PolledBatch
+{
+public:
+    using Timestamp = std::chrono::system_clock::time_point;
+    using Header = std::pair<std::string_view, std::string_view>;
+
+    /**
+     * @brief A consumed record, its fields point into the batch it belongs to
+     */
+    struct Record
+    {
+        std::string_view topic;
+        std::int32_t partition = -1;
+        std::int64_t offset = -1;
+        std::string_view key;
+        SharedPayload value;
+        Timestamp timestamp;
+        std::uint32_t firstHeader = 0; ///< Set by add(), read the headers through headers()
+        std::uint32_t headerCount = 0;
+    };
+
+    /**
+     * @brief Constructor for PolledBatch class
+     * @param storage Keeps the bytes alive the records point into, may be empty
+     */
+    explicit PolledBatch(std::shared_ptr<const void> storage = {});
+
+    PolledBatch(const PolledBatch&) = delete;
+    PolledBatch& operator=(const PolledBatch&) = delete;
+
+    /**
+     * @brief Reserve room for the records of the poll
+     */
+    void reserve(std::size_t records);
+
+    /**
+     * @brief Append a record while the bus fills the batch
+     * @param record The record, its fields must point into the storage or the arena
+     * @param headers Its headers, under the same rule; the pairs are copied into the batch
+     */
+    void add(Record record, std::span<const Header> headers = {});
+
+    /**
+     * @brief Get the copy of a string in the arena, for names the client returns as new strings
+     * A batch holds a handful of topic and header names, each is copied once.
+     */
+    std::string_view intern(std::string_view text);
+
+    const std::vector<Record>& records() const;
+
+    /**
+     * @brief Get the headers of a record of this batch
+     */
+    std::span<const Header> headers(const Record& record) const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    std::shared_ptr<const void> mStorage;
+    std::vector<Record> mRecords;
+    std::vector<Header> mHeaders;
+    std::array<std::byte, 512> mBuffer; // first block of the arena, enough for a few names
+    std::pmr::monotonic_buffer_resource mArena;
+    std::pmr::vector<std::string_view> mInterned;
+};
+
+#endif // POLLED_BATCH_H
@@ -8,6 +8,8 @@
 #ifndef LOG_LEVEL_H
 #define LOG_LEVEL_H
 
+#include <string>
+
 namespace logger {
 
 enum class LogLevel {
@@ -24,16 +24,16 @@ public:
     }
 
     // Destructor
-    ~LoggersStream() {
+    ~LoggerStream() {
         std::ostringstream stream;
-        stream << "[" << LogLevel::toString(mLevel) << "] "
+        stream << "[" << toString(mLevel) << "] "
         << "[" << mFunc << ":" << mLine << "] " << mStream.str();
         std::cout << stream.str() << std::endl; // Output to console, can
     }
 
     template <typename T>
     LoggerStream& operator<<(const T& message) {
-        stream << message;
+        mStream << message;
         return *this;
     }
 
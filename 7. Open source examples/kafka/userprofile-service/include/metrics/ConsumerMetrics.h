@@ -0,0 +1,183 @@
+/**
+ * @file ConsumerMetrics.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of ConsumerMetrics class
+ */
+
+#ifndef CONSUMER_METRICS_H
+#define CONSUMER_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Event.h"
+#include "LatencyHistogram.h"
+
+/**
+ * @brief ConsumerMetrics class
+ * This class counts consumed records per pipeline stage and times poll, decode and handling.
+ * Counters and histograms are plain atomics updated on the hot path. The polling thread
+ * periodically turns them into an immutable snapshot with rates, lag and queue depths and
+ * publishes it with an atomic pointer swap, so readers never wait for the consumer.
+ */
+class ConsumerMetrics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Lag of one assigned partition
+     */
+    struct PartitionLag
+    {
+        std::string topic;
+        std::int32_t partition = 0;
+        std::int64_t endOffset = -1; ///< Log end offset, -1 if unknown
+        std::int64_t committed = -1; ///< Committed offset, -1 if unknown
+        std::int64_t lag = -1;       ///< endOffset - committed, -1 if unknown
+    };
+
+    /**
+     * @brief Counters of the deduplication stage
+     */
+    struct DedupSnapshot
+    {
+        std::uint64_t hits = 0;      ///< Events skipped as already handled
+        std::uint64_t misses = 0;    ///< Events passed on to the handlers
+        std::uint64_t evictions = 0; ///< Entries dropped to stay within the memory bound
+        std::size_t entries = 0;
+        std::size_t bytes = 0;       ///< Estimated memory held by the entries
+    };
+
+    /**
+     * @brief Counters of the retry stage
+     */
+    struct RetrySnapshot
+    {
+        std::uint64_t scheduled = 0;    ///< Failed events queued for a retry
+        std::uint64_t retries = 0;      ///< Retry attempts run
+        std::uint64_t recovered = 0;    ///< Events a retry handled
+        std::uint64_t deadLettered = 0; ///< Events handed to the dead-letter sink
+        std::uint64_t rejected = 0;     ///< Failed events dead-lettered at once because the queue was full
+        std::uint64_t superseded = 0;   ///< Retries dropped because a later event of the key was handled
+        std::size_t pendingEvents = 0;
+        std::size_t pendingBytes = 0;   ///< Estimated memory held by the pending events
+    };
+
+    /**
+     * @brief Accounting of one handler, see HandlerFanOut
+     */
+    struct HandlerSnapshot
+    {
+        std::string name;
+        std::uint64_t batches = 0;      ///< Handler calls
+        std::uint64_t events = 0;       ///< Events handed to the handler
+        std::uint64_t failedEvents = 0; ///< Events the handler failed, including those of timed out calls
+        std::uint64_t timeouts = 0;     ///< Calls which overran the handler timeout
+        LatencyHistogram::Snapshot latencyUs; ///< Per call
+        std::uint64_t queueDepth = 0;    ///< Events waiting in the lane of an isolated handler
+        std::uint64_t spillDepth = 0;    ///< Events waiting in the spill directory of that lane
+        std::uint64_t shedEvents = 0;    ///< Events the lane dropped because it was full
+        std::uint64_t spilledEvents = 0; ///< Events the lane wrote to disk because it was full
+        LatencyHistogram::Snapshot queueUs; ///< Per batch wait in the lane
+    };
+
+    /**
+     * @brief Point in time copy of all consumer metrics
+     */
+    struct Snapshot
+    {
+        Clock::time_point takenAt;
+
+        std::uint64_t polledRecords = 0;
+        std::uint64_t polledBytes = 0;
+        std::uint64_t handledRecords = 0;
+        std::uint64_t handledBytes = 0;
+        std::uint64_t failedRecords = 0; ///< Records at least one handler failed
+
+        double polledRecordsPerSec = 0.0;  ///< Since the previous snapshot
+        double polledBytesPerSec = 0.0;
+        double handledRecordsPerSec = 0.0;
+        double handledBytesPerSec = 0.0;
+
+        LatencyHistogram::Snapshot decodeUs;        ///< Record to event conversion, per poll
+        LatencyHistogram::Snapshot queueUs;         ///< Poll to handler start, per record
+        LatencyHistogram::Snapshot handleUs;        ///< Handler time, per handler batch
+        LatencyHistogram::Snapshot pollToHandledUs; ///< Poll to handled, per record
+
+        std::vector<std::size_t> queueDepths; ///< Per handler thread
+        std::vector<PartitionLag> partitions;
+        std::int64_t totalLag = 0;            ///< Sum of the known partition lags
+
+        DedupSnapshot dedup;
+        double dedupHitsPerSec = 0.0;   ///< Since the previous snapshot
+        double dedupMissesPerSec = 0.0;
+
+        RetrySnapshot retry;
+
+        std::vector<HandlerSnapshot> handlers;
+    };
+
+    ConsumerMetrics();
+
+    ConsumerMetrics(const ConsumerMetrics&) = delete;
+    ConsumerMetrics& operator=(const ConsumerMetrics&) = delete;
+
+    /**
+     * @brief Count a poll result
+     * @param records Records returned by the poll
+     * @param bytes Key and value bytes of those records
+     * @param decodeUs Time spent converting the records to events, in microseconds
+     */
+    void onPolled(std::uint64_t records, std::uint64_t bytes, std::uint64_t decodeUs);
+
+    /**
+     * @brief Count a batch handled on a handler thread
+     * @param events The events, their receive time starts the latency measurements
+     * @param failed Number of events a handler failed
+     * @param startedAt When the handlers started on the batch
+     * @param finishedAt When the handlers finished the batch
+     */
+    void onHandled(std::span<const Event> events, std::size_t failed, Clock::time_point startedAt,
+        Clock::time_point finishedAt);
+
+    /**
+     * @brief Build and publish a new snapshot, only called from the polling thread
+     * @param now The current time
+     * @param partitions Lag of the assigned partitions
+     * @param queueDepths Queue depth of every handler thread
+     * @param dedup Counters of the deduplication stage
+     * @param retry Counters of the retry stage
+     * @param handlers Accounting of every handler
+     */
+    void publish(Clock::time_point now, std::vector<PartitionLag> partitions, std::vector<std::size_t> queueDepths,
+        DedupSnapshot dedup, RetrySnapshot retry, std::vector<HandlerSnapshot> handlers);
+
+    /**
+     * @brief Get the latest published snapshot
+     * @return The snapshot, never null; counters are zero until the first publish
+     */
+    std::shared_ptr<const Snapshot> snapshot() const;
+
+private:
+    std::atomic<std::uint64_t> mPolledRecords{0};
+    std::atomic<std::uint64_t> mPolledBytes{0};
+    std::atomic<std::uint64_t> mHandledRecords{0};
+    std::atomic<std::uint64_t> mHandledBytes{0};
+    std::atomic<std::uint64_t> mFailedRecords{0};
+    LatencyHistogram mDecodeUs;
+    LatencyHistogram mQueueUs;
+    LatencyHistogram mHandleUs;
+    LatencyHistogram mPollToHandledUs;
+
+    std::atomic<std::shared_ptr<const Snapshot>> mSnapshot;
+};
+
+#endif // CONSUMER_METRICS_H
@@ -0,0 +1,82 @@
+/**
+ * @file LatencyHistogram.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of LatencyHistogram class
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief LatencyHistogram class
+ * A lock-free histogram with HDR-style log-linear buckets.
+ * Every power of two is split into 16 linear sub-buckets, which keeps the relative error
+ * of a reported percentile around 6% for values up to 2^36 (about 19 hours in microseconds).
+ * Recording is wait-free apart from the max update, so it can sit on any hot path.
+ */
+class LatencyHistogram
+{
+public:
+    /**
+     * @brief Summary of the recorded values
+     */
+    struct Snapshot
+    {
+        std::uint64_t count = 0;
+        std::uint64_t max = 0;
+        double mean = 0.0;
+        std::uint64_t p50 = 0;
+        std::uint64_t p90 = 0;
+        std::uint64_t p99 = 0;
+        std::uint64_t p999 = 0;
+    };
+
+    LatencyHistogram() = default;
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one value
+     * @param value The value, usually a latency in microseconds
+     */
+    void record(std::uint64_t value);
+
+    /**
+     * @brief Summarize the recorded values
+     * Concurrent records may or may not be part of the result.
+     * @return The snapshot
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Get the value at a percentile
+     * @param percentile The percentile in range [0, 100]
+     * @return The highest value equivalent to the bucket holding the percentile
+     */
+    std::uint64_t valueAtPercentile(double percentile) const;
+
+private:
+    static constexpr unsigned kSubBucketBits = 5;                        // 32 values below the first exponent
+    static constexpr std::uint64_t kSubBucketCount = 1u << kSubBucketBits;
+    static constexpr std::uint64_t kHalfSubBucketCount = kSubBucketCount / 2;
+    static constexpr unsigned kMaxValueBits = 36;
+    static constexpr std::size_t kBucketCount =
+        kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kHalfSubBucketCount;
+
+    static std::size_t bucketIndex(std::uint64_t value);
+    static std::uint64_t bucketUpperBound(std::size_t index);
+
+    std::array<std::atomic<std::uint64_t>, kBucketCount> mBuckets{};
+    std::atomic<std::uint64_t> mCount{0};
+    std::atomic<std::uint64_t> mSum{0};
+    std::atomic<std::uint64_t> mMax{0};
+};
+
+#endif // LATENCY_HISTOGRAM_H
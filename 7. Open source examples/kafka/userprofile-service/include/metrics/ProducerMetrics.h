@@ -0,0 +1,134 @@
+/**
+ * @file ProducerMetrics.h
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is declaration of ProducerMetrics class
+ */
+
+#ifndef PRODUCER_METRICS_H
+#define PRODUCER_METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LatencyHistogram.h"
+
+/**
+ * @brief ProducerMetrics class
+ * This class keeps per-topic delivery counters and send-to-ack latency histograms.
+ * Counters are plain atomics; the topic table is only locked to register a new topic,
+ * which happens once per topic, and to look a topic up once per sent batch.
+ */
+class ProducerMetrics
+{
+public:
+    /**
+     * @brief Counters of a single topic
+     * sent counts records the Kafka client accepted, refused the ones it did not accept,
+     * acked and failed count delivery reports.
+     */
+    struct TopicCounters
+    {
+        std::atomic<std::uint64_t> sent{0};
+        std::atomic<std::uint64_t> refused{0};
+        std::atomic<std::uint64_t> acked{0};
+        std::atomic<std::uint64_t> failed{0};
+        std::atomic<std::int64_t> inFlight{0};
+        std::atomic<std::int64_t> lastAckedOffset{-1};
+        LatencyHistogram ackLatencyUs; ///< From sendMessage to delivery report, in microseconds
+    };
+
+    /**
+     * @brief Point in time copy of one topic counters
+     */
+    struct TopicSnapshot
+    {
+        std::string topic;
+        std::uint64_t sent = 0;
+        std::uint64_t refused = 0;
+        std::uint64_t acked = 0;
+        std::uint64_t failed = 0;
+        std::int64_t inFlight = 0;
+        std::int64_t lastAckedOffset = -1;
+        LatencyHistogram::Snapshot ackLatencyUs;
+    };
+
+    /**
+     * @brief Point in time copy of the in-flight budget usage
+     */
+    struct BudgetSnapshot
+    {
+        std::size_t bytes = 0;
+        std::size_t records = 0;
+        std::size_t maxBytes = 0;
+        std::size_t maxRecords = 0;
+        std::uint64_t blocked = 0;   ///< Sends which had to wait for budget
+        std::uint64_t rejected = 0;  ///< Sends refused because the budget stayed exhausted
+        std::uint64_t dropped = 0;   ///< Queued records dropped for higher priority topics
+    };
+
+    /**
+     * @brief Point in time copy of all producer metrics
+     */
+    struct Snapshot
+    {
+        std::vector<TopicSnapshot> topics;
+        std::uint64_t queuedRecords = 0; ///< Records still waiting in the batch accumulator
+        BudgetSnapshot budget;
+    };
+
+    ProducerMetrics() = default;
+
+    ProducerMetrics(const ProducerMetrics&) = delete;
+    ProducerMetrics& operator=(const ProducerMetrics&) = delete;
+
+    /**
+     * @brief Get the counters of a topic, registering the topic on first use
+     * The returned reference stays valid for the lifetime of this object.
+     * @param topic The topic name
+     * @return The topic counters
+     */
+    TopicCounters& topic(const std::string& topic);
+
+    /**
+     * @brief Count records handed to the Kafka client
+     * Called before the records are handed over, so a delivery report never finds them uncounted.
+     */
+    static void onSent(TopicCounters& counters, std::uint64_t records);
+
+    /**
+     * @brief Move records the Kafka client did not accept from sent to refused
+     * No delivery report follows for them.
+     */
+    static void onRefused(TopicCounters& counters, std::uint64_t records);
+
+    /**
+     * @brief Count a successful delivery report
+     * @param latencyUs Time from sendMessage to the report, in microseconds
+     * @param offset The offset the broker assigned to the record
+     */
+    static void onAcked(TopicCounters& counters, std::uint64_t latencyUs, std::int64_t offset);
+
+    /**
+     * @brief Count a failed delivery report
+     */
+    static void onFailed(TopicCounters& counters);
+
+    /**
+     * @brief Copy all counters
+     * @return The snapshot, topics are sorted by name
+     */
+    Snapshot snapshot() const;
+
+private:
+    mutable std::shared_mutex mMutex;
+    std::unordered_map<std::string, std::unique_ptr<TopicCounters>> mTopics;
+};
+
+#endif // PRODUCER_METRICS_H
@@ -0,0 +1,38 @@
+/*
+* File: IOutboxStore.h
+* Author: trung.la
+* Date: 10-16-2026
+* Description: This file contains the interface of the table the outbox relay drains
+*/
+
+#ifndef I_OUTBOX_STORE_H
+#define I_OUTBOX_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "OutboxMessage.h"
+
+class IOutboxStore
+{
+public:
+    virtual ~IOutboxStore() = default;
+
+    /**
+     * @brief Read the oldest outbox rows
+     * @param limit Maximum number of rows
+     * @return The rows ordered by id, std::nullopt if the outbox could not be read
+     */
+    virtual std::optional<std::vector<OutboxMessage>> fetchOutbox(std::size_t limit) = 0;
+
+    /**
+     * @brief Delete published outbox rows in one transaction
+     * @param ids The ids of the rows to delete
+     * @return true if the transaction was committed
+     */
+    virtual bool removeOutbox(const std::vector<std::int64_t>& ids) = 0;
+};
+
+#endif // I_OUTBOX_STORE_H
@@ -0,0 +1,31 @@
+/*
+* File: OutboxMessage.h
+* Author: trung.la
+* Date: 10-16-2026
+* Description: This file is declaration of the outbox row written together with a user change
+*/
+
+#ifndef OUTBOX_MESSAGE_H
+#define OUTBOX_MESSAGE_H
+
+#include <cstdint>
+#include <string>
+
+#include "utils.h"
+
+/**
+ * @brief OutboxMessage struct
+ * An event waiting in the Outbox table until the relay has published it.
+ */
+struct OutboxMessage
+{
+    std::int64_t id = 0;   ///< Assigned by the database, ordered by insertion
+    std::string topic;     ///< Destination topic
+    std::string key;       ///< Message key, usually the user id
+    std::string payload;   ///< Serialized event
+    user_profile::utils::event::EventType type =
+        user_profile::utils::event::EventType::eUnknown; ///< Sent in the event-type header
+    std::string eventId;   ///< Sent in the event-id header, empty for none
+};
+
+#endif // OUTBOX_MESSAGE_H
@@ -8,17 +8,22 @@
 #ifndef USER_REPOSITORY_H
 #define USER_REPOSITORY_H
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
 #include "connection/IDatabaseConnection.h"
+#include "IOutboxStore.h"
+#include "OutboxMessage.h"
 #include "utils.h"
 
 class User;
 
-class UserRepository
+class UserRepository : public IOutboxStore
 {
 public:
     using ConnectionType = user_profile::utils::database::ConnectionType;
@@ -26,7 +31,7 @@ public:
     using DatabaseConnectionWPtr = std::weak_ptr<IDatabaseConnection>;
 
     UserRepository();
-    ~UserRepository();
+    ~UserRepository() override;
 
     void selectConnection(ConnectionType type);
     ConnectionType getCurrentConnectionType() const;
@@ -34,6 +39,32 @@ public:
     void createTable();
     void insert(const User& user);
     void update(const User& user);
+
+    /**
+     * @brief Insert a user and its event in the same transaction
+     * Either both rows are committed or none, so the event cannot be lost between the two.
+     * @return true if the transaction was committed
+     */
+    bool insert(const User& user, const OutboxMessage& event);
+
+    /**
+     * @brief Update a user and store its event in the same transaction
+     * @return true if the transaction was committed
+     */
+    bool update(const User& user, const OutboxMessage& event);
+
+    std::optional<std::vector<OutboxMessage>> fetchOutbox(std::size_t limit) override;
+    bool removeOutbox(const std::vector<std::int64_t>& ids) override;
+
+    /**
+     * @brief Write many users in one transaction, used to rebuild the table from the event log
+     * Existing rows are overwritten, missing rows are inserted.
+     * @param upserts The users to insert or overwrite
+     * @param removedIds The ids of the users to delete, applied after the upserts
+     * @return true if the transaction was committed
+     */
+    bool applyBatch(const std::vector<User>& upserts, const std::vector<std::string>& removedIds);
+
     void remove(const User& user);
     std::vector<User> getAll();
     std::optional<User> findById(const std::string& userId);
@@ -41,6 +72,9 @@ public:
     std::optional<User> findByEmail(const std::string& email);
 
 private:
+    bool writeWithOutbox(const std::string& sql, const OutboxMessage& event);
+
+    std::mutex m_mutex; // A connection runs one transaction at a time, the outbox relay shares it
     std::unordered_map<ConnectionType, DatabaseConnectionPtr> m_connections;
     DatabaseConnectionWPtr m_currentConnection;
     ConnectionType m_currentConnectionType;
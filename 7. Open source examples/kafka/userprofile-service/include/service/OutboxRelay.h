@@ -0,0 +1,80 @@
+/*
+* File: OutboxRelay.h
+* Author: trung.la
+* Date: 10-16-2026
+* Description: This is declaration of the relay which publishes outbox rows to Kafka
+*/
+
+#ifndef OUTBOX_RELAY_H
+#define OUTBOX_RELAY_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+class IOutboxStore;
+class KafkaMessageProducer;
+
+/**
+ * @brief OutboxRelay class
+ * This class drains the Outbox table written by UserRepository into KafkaMessageProducer.
+ * Rows are read in large batches in id order and deleted once the broker acknowledged them, so
+ * an event is never lost if the service stops between the database commit and the publish.
+ * A round stops sending at the first row refused or reported failed, and only the acknowledged
+ * rows in front of the first unacknowledged one are deleted. The next round sends everything
+ * from that row on again, delivery is at-least-once and the last copy of each event on the
+ * broker is in outbox order.
+ */
+class OutboxRelay
+{
+public:
+    /**
+     * @brief Relay options
+     */
+    struct Options
+    {
+        std::size_t batchSize = 500;                  ///< Rows read and published per round
+        std::chrono::milliseconds idleInterval{100};  ///< Pause after a round which found no row
+        std::chrono::milliseconds ackTimeout{30000};  ///< Longest wait for the delivery reports of a round
+    };
+
+    OutboxRelay(IOutboxStore& outbox, KafkaMessageProducer& producer);
+    OutboxRelay(IOutboxStore& outbox, KafkaMessageProducer& producer, Options options);
+    ~OutboxRelay();
+
+    OutboxRelay(const OutboxRelay&) = delete;
+    OutboxRelay& operator=(const OutboxRelay&) = delete;
+
+    /**
+     * @brief Start the relay thread
+     */
+    void start();
+
+    /**
+     * @brief Stop the relay thread, the current round is finished first
+     */
+    void stop();
+
+    /**
+     * @brief Publish one batch of outbox rows and delete the acknowledged prefix
+     * @return The number of rows deleted, 0 if the outbox could not be read or the rows not deleted
+     */
+    std::size_t relayOnce();
+
+private:
+    void run();
+
+    IOutboxStore& mOutbox;
+    KafkaMessageProducer& mProducer;
+    Options mOptions;
+
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::atomic<bool> mRunning{false};
+    std::thread mThread;
+};
+
+#endif // OUTBOX_RELAY_H
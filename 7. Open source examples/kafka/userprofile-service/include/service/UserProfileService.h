@@ -8,13 +8,50 @@
 #ifndef USER_PROFILE_SERVICE_H
 #define USER_PROFILE_SERVICE_H
 
+#include <memory>
+
+#include "KafkaMessageProducer.h"
+#include "OutboxRelay.h"
+#include "ServiceConfig.h"
+#include "UserRepository.h"
+
+class IMessageBus;
+
+/**
+ * @brief UserProfileService class
+ * Owns the repository and the producer its outbox rows are published with. The outbox relay
+ * runs between start() and stop(), so an event committed with its user reaches the broker.
+ */
 class UserProfileService
 {
 public:
     UserProfileService();
+
+    /**
+     * @brief Constructor for UserProfileService class
+     * @param config The service configuration, copied
+     * @param bus The bus the outbox rows are published to
+     */
+    UserProfileService(const ServiceConfig& config, std::shared_ptr<IMessageBus> bus);
     ~UserProfileService();
 
-    void start();
+    /**
+     * @brief Create the tables, initialize the producer and start the outbox relay
+     * @return true if the relay runs
+     */
+    bool start();
+
+    /**
+     * @brief Stop the outbox relay and flush what it queued
+     */
     void stop();
+
+    UserRepository& getRepository();
+
+private:
+    ServiceConfig mConfig;
+    UserRepository mRepository;
+    KafkaMessageProducer mProducer;
+    OutboxRelay mRelay; // last, it uses the repository and the producer
 };
 #endif // USER_PROFILE_SERVICE_H
@@ -8,6 +8,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace user_profile
@@ -37,8 +38,58 @@ enum class EventType : uint16_t
     eUserDeleted = 3
 };
 
+// Number of EventType values, handler dispatch tables are indexed by the type
+constexpr size_t kEventTypeCount = 4;
+
+// One bit per EventType, selects the events a handler receives
+using EventTypeMask = uint32_t;
+
+constexpr EventTypeMask kAllEventTypes = ~EventTypeMask(0);
+
+static_assert(kEventTypeCount <= 32, "EventTypeMask has one bit per event type");
+
+/**
+ * @brief Build the mask of some event types
+ * @param types The event types
+ * @return The mask with the bit of every type set
+ */
+template <typename... Types>
+constexpr EventTypeMask eventTypeMask(Types... types)
+{
+    return (EventTypeMask(0) | ... | (EventTypeMask(1) << static_cast<uint16_t>(types)));
+}
+
 } // user_profile::utils::event
 
+namespace producer
+{
+
+enum class BackpressurePolicy : uint16_t
+{
+    eBlock = 0,              // Wait for budget up to a timeout
+    eFailFast = 1,           // Refuse the record immediately
+    eDropLowestPriority = 2  // Drop queued records of lower priority topics, refuse if none or if transactional
+};
+
+} // user_profile::utils::producer
+
+namespace consumer
+{
+
+enum class DispatchOrdering : uint16_t
+{
+    ePartition = 0, // One worker per partition, records are handled in offset order
+    eKey = 1        // One worker per key, more parallelism but offsets complete out of order
+};
+
+enum class RebalanceType : uint16_t
+{
+    eAssigned = 0, // Partitions were handed to this member
+    eRevoked = 1   // Partitions are taken away, commit their offsets now
+};
+
+} // user_profile::utils::consumer
+
 } // user_profile::utils
 
 } // user_profile
@@ -0,0 +1,70 @@
+/**
+ * @file PayloadBufferPool.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of PayloadBufferPool class
+ */
+
+#include "PayloadBufferPool.h"
+
+PayloadBufferPool::PayloadBufferPool()
+    : PayloadBufferPool(Options{})
+{
+}
+
+PayloadBufferPool::PayloadBufferPool(Options options)
+    : mState(std::make_shared<State>())
+{
+    mState->options = options;
+}
+
+PayloadBufferPtr PayloadBufferPool::acquire(std::size_t capacity)
+{
+    std::unique_ptr<PayloadBuffer> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mState->mutex);
+        if (!mState->freeList.empty()) {
+            buffer = std::move(mState->freeList.back());
+            mState->freeList.pop_back();
+        }
+    }
+
+    if (buffer) {
+        buffer->data().reserve(capacity);
+    } else {
+        buffer = std::make_unique<PayloadBuffer>(capacity);
+    }
+
+    // The deleter keeps the pool state alive, so buffers may outlive the pool itself
+    return PayloadBufferPtr(buffer.release(), [state = mState](PayloadBuffer* released) {
+        std::unique_ptr<PayloadBuffer> owned(released);
+        if (owned->data().capacity() > state->options.maxPooledCapacity) {
+            return;
+        }
+
+        owned->data().clear();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->freeList.size() < state->options.maxPooledBuffers) {
+            state->freeList.push_back(std::move(owned));
+        }
+    });
+}
+
+SharedPayload PayloadBufferPool::copyOf(std::string_view bytes)
+{
+    auto buffer = acquire(bytes.size());
+    buffer->data().assign(bytes.data(), bytes.size());
+    return share(std::move(buffer));
+}
+
+SharedPayload PayloadBufferPool::share(PayloadBufferPtr buffer)
+{
+    const std::string_view view = buffer ? buffer->view() : std::string_view{};
+    return SharedPayload(view, std::move(buffer));
+}
+
+std::size_t PayloadBufferPool::pooledBuffers() const
+{
+    std::lock_guard<std::mutex> lock(mState->mutex);
+    return mState->freeList.size();
+}
@@ -7,7 +7,35 @@
 
 #include "ServiceConfig.h"
 
+#include <stdexcept>
+
 ServiceConfig::ServiceConfig()
+    : mProducerBatchSize(100)
+    , mProducerLingerMs(5)
+    , mProducerShards(4)
+    , mConsumerPollTimeout(100)
+    , mConsumerMinPollTimeout(1)
+    , mConsumerMaxPollRecords(500)
+    , mEventHandlerThreads(4)
+    , mEventFanOutThreads(4)
+    , mConsumerWorkerQueueCapacity(1000)
+    , mConsumerQueueHighWatermark(800)
+    , mConsumerQueueLowWatermark(200)
+    , mConsumerDispatchOrdering(DispatchOrdering::ePartition)
+    , mConsumerCommitEveryRecords(1000)
+    , mConsumerCommitIntervalMs(1000)
+    , mConsumerMetricsIntervalMs(5000)
+    , mConsumerDedupMaxBytes(16 * 1024 * 1024)
+    , mConsumerRetryMaxAttempts(5)
+    , mConsumerRetryInitialBackoffMs(100)
+    , mConsumerRetryMaxBackoffMs(30000)
+    , mConsumerRetryMaxEvents(10000)
+    , mConsumerRetryMaxBytes(64 * 1024 * 1024)
+    , mEnableIdempotence(false)
+    , mProducerMaxInFlightBytes(64 * 1024 * 1024)
+    , mProducerMaxInFlightRecords(100000)
+    , mProducerBackpressurePolicy(BackpressurePolicy::eBlock)
+    , mProducerBlockTimeoutMs(1000)
 {
 }
 
@@ -51,6 +79,16 @@ const std::string& ServiceConfig::getKafkaClientId() const
     return mKafkaClientId;
 }
 
+const std::string& ServiceConfig::getKafkaTransactionalId() const
+{
+    return mKafkaTransactionalId;
+}
+
+bool ServiceConfig::isIdempotenceEnabled() const
+{
+    return mEnableIdempotence;
+}
+
 void ServiceConfig::setKafkaBroker(const std::string& broker)
 {
     mKafkaBroker = broker;
@@ -66,6 +104,16 @@ void ServiceConfig::setKafkaClientId(const std::string& clientId)
     mKafkaClientId = clientId;
 }
 
+void ServiceConfig::setKafkaTransactionalId(const std::string& transactionalId)
+{
+    mKafkaTransactionalId = transactionalId;
+}
+
+void ServiceConfig::setEnableIdempotence(bool enable)
+{
+    mEnableIdempotence = enable;
+}
+
 void ServiceConfig::setServiceName(const std::string& serviceName)
 {
     if (serviceName.empty()) {
@@ -113,6 +161,287 @@ void ServiceConfig::setLogLevel(const std::string& logLevel)
     // TODO: Add validation for log level (e.g., check against a list of valid log levels)
 }
 
+int ServiceConfig::getProducerBatchSize() const
+{
+    return mProducerBatchSize;
+}
+
+int ServiceConfig::getProducerLingerMs() const
+{
+    return mProducerLingerMs;
+}
+
+int ServiceConfig::getProducerShards() const
+{
+    return mProducerShards;
+}
+
+int ServiceConfig::getEventHandlerThreads() const
+{
+    return mEventHandlerThreads;
+}
+
+int ServiceConfig::getEventFanOutThreads() const
+{
+    return mEventFanOutThreads;
+}
+
+void ServiceConfig::setProducerBatchSize(int batchSize)
+{
+    if (batchSize <= 0) {
+        throw std::out_of_range("Producer batch size must be greater than 0");
+    }
+    mProducerBatchSize = batchSize;
+}
+
+void ServiceConfig::setProducerLingerMs(int lingerMs)
+{
+    if (lingerMs < 0) {
+        throw std::out_of_range("Producer linger time cannot be negative");
+    }
+    mProducerLingerMs = lingerMs;
+}
+
+void ServiceConfig::setProducerShards(int shards)
+{
+    if (shards <= 0) {
+        throw std::out_of_range("Producer shards must be greater than 0");
+    }
+    mProducerShards = shards;
+}
+
+void ServiceConfig::setEventHandlerThreads(int threads)
+{
+    if (threads <= 0) {
+        throw std::out_of_range("Event handler threads must be greater than 0");
+    }
+    mEventHandlerThreads = threads;
+}
+
+void ServiceConfig::setEventFanOutThreads(int threads)
+{
+    if (threads < 0) {
+        throw std::out_of_range("Event fan-out threads cannot be negative");
+    }
+    mEventFanOutThreads = threads;
+}
+
+int ServiceConfig::getConsumerPollTimeout() const
+{
+    return mConsumerPollTimeout;
+}
+
+int ServiceConfig::getConsumerMinPollTimeout() const
+{
+    return mConsumerMinPollTimeout;
+}
+
+int ServiceConfig::getConsumerMaxPollRecords() const
+{
+    return mConsumerMaxPollRecords;
+}
+
+int ServiceConfig::getConsumerWorkerQueueCapacity() const
+{
+    return mConsumerWorkerQueueCapacity;
+}
+
+int ServiceConfig::getConsumerQueueHighWatermark() const
+{
+    return mConsumerQueueHighWatermark;
+}
+
+int ServiceConfig::getConsumerQueueLowWatermark() const
+{
+    return mConsumerQueueLowWatermark;
+}
+
+ServiceConfig::DispatchOrdering ServiceConfig::getConsumerDispatchOrdering() const
+{
+    return mConsumerDispatchOrdering;
+}
+
+int ServiceConfig::getConsumerCommitEveryRecords() const
+{
+    return mConsumerCommitEveryRecords;
+}
+
+int ServiceConfig::getConsumerCommitIntervalMs() const
+{
+    return mConsumerCommitIntervalMs;
+}
+
+void ServiceConfig::setConsumerPollTimeoutBounds(int minTimeoutMs, int maxTimeoutMs)
+{
+    if (minTimeoutMs < 0 || maxTimeoutMs < minTimeoutMs) {
+        throw std::out_of_range("Consumer poll timeouts must satisfy 0 <= min <= max");
+    }
+    mConsumerMinPollTimeout = minTimeoutMs;
+    mConsumerPollTimeout = maxTimeoutMs;
+}
+
+void ServiceConfig::setConsumerMaxPollRecords(int maxRecords)
+{
+    if (maxRecords <= 0) {
+        throw std::out_of_range("Consumer max poll records must be greater than 0");
+    }
+    mConsumerMaxPollRecords = maxRecords;
+}
+
+int ServiceConfig::getConsumerMetricsIntervalMs() const
+{
+    return mConsumerMetricsIntervalMs;
+}
+
+std::size_t ServiceConfig::getConsumerDedupMaxBytes() const
+{
+    return mConsumerDedupMaxBytes;
+}
+
+int ServiceConfig::getConsumerRetryMaxAttempts() const
+{
+    return mConsumerRetryMaxAttempts;
+}
+
+int ServiceConfig::getConsumerRetryInitialBackoffMs() const
+{
+    return mConsumerRetryInitialBackoffMs;
+}
+
+int ServiceConfig::getConsumerRetryMaxBackoffMs() const
+{
+    return mConsumerRetryMaxBackoffMs;
+}
+
+std::size_t ServiceConfig::getConsumerRetryMaxEvents() const
+{
+    return mConsumerRetryMaxEvents;
+}
+
+std::size_t ServiceConfig::getConsumerRetryMaxBytes() const
+{
+    return mConsumerRetryMaxBytes;
+}
+
+void ServiceConfig::setConsumerWorkerQueueCapacity(int capacity)
+{
+    if (capacity <= 0) {
+        throw std::out_of_range("Consumer worker queue capacity must be greater than 0");
+    }
+    mConsumerWorkerQueueCapacity = capacity;
+}
+
+void ServiceConfig::setConsumerQueueWatermarks(int highWatermark, int lowWatermark)
+{
+    if (lowWatermark < 0 || highWatermark <= lowWatermark) {
+        throw std::out_of_range("Consumer queue watermarks must satisfy 0 <= low < high");
+    }
+    mConsumerQueueHighWatermark = highWatermark;
+    mConsumerQueueLowWatermark = lowWatermark;
+}
+
+void ServiceConfig::setConsumerDispatchOrdering(DispatchOrdering ordering)
+{
+    mConsumerDispatchOrdering = ordering;
+}
+
+void ServiceConfig::setConsumerCommitCadence(int everyRecords, int intervalMs)
+{
+    if (everyRecords <= 0 || intervalMs <= 0) {
+        throw std::out_of_range("Consumer commit cadence must be greater than 0");
+    }
+    mConsumerCommitEveryRecords = everyRecords;
+    mConsumerCommitIntervalMs = intervalMs;
+}
+
+void ServiceConfig::setConsumerMetricsIntervalMs(int intervalMs)
+{
+    if (intervalMs <= 0) {
+        throw std::out_of_range("Consumer metrics interval must be greater than 0");
+    }
+    mConsumerMetricsIntervalMs = intervalMs;
+}
+
+void ServiceConfig::setConsumerDedupMaxBytes(std::size_t maxBytes)
+{
+    mConsumerDedupMaxBytes = maxBytes;
+}
+
+void ServiceConfig::setConsumerRetryBackoff(int maxAttempts, int initialBackoffMs, int maxBackoffMs)
+{
+    if (maxAttempts <= 0 || initialBackoffMs <= 0 || maxBackoffMs < initialBackoffMs) {
+        throw std::out_of_range("Consumer retry backoff must satisfy attempts > 0 and 0 < initial <= max");
+    }
+    mConsumerRetryMaxAttempts = maxAttempts;
+    mConsumerRetryInitialBackoffMs = initialBackoffMs;
+    mConsumerRetryMaxBackoffMs = maxBackoffMs;
+}
+
+void ServiceConfig::setConsumerRetryLimits(std::size_t maxEvents, std::size_t maxBytes)
+{
+    if (maxEvents == 0 || maxBytes == 0) {
+        throw std::out_of_range("Consumer retry limits must be greater than 0");
+    }
+    mConsumerRetryMaxEvents = maxEvents;
+    mConsumerRetryMaxBytes = maxBytes;
+}
+
+std::size_t ServiceConfig::getProducerMaxInFlightBytes() const
+{
+    return mProducerMaxInFlightBytes;
+}
+
+std::size_t ServiceConfig::getProducerMaxInFlightRecords() const
+{
+    return mProducerMaxInFlightRecords;
+}
+
+ServiceConfig::BackpressurePolicy ServiceConfig::getProducerBackpressurePolicy() const
+{
+    return mProducerBackpressurePolicy;
+}
+
+int ServiceConfig::getProducerBlockTimeoutMs() const
+{
+    return mProducerBlockTimeoutMs;
+}
+
+int ServiceConfig::getTopicPriority(const std::string& topic) const
+{
+    auto it = mTopicPriorities.find(topic);
+    if (it != mTopicPriorities.end()) {
+        return it->second;
+    } else {
+        return 0; // Topics without a priority are all equal
+    }
+}
+
+void ServiceConfig::setProducerInFlightBudget(std::size_t maxBytes, std::size_t maxRecords)
+{
+    if (maxBytes == 0 || maxRecords == 0) {
+        throw std::out_of_range("Producer in-flight budget must be greater than 0");
+    }
+    mProducerMaxInFlightBytes = maxBytes;
+    mProducerMaxInFlightRecords = maxRecords;
+}
+
+void ServiceConfig::setProducerBackpressurePolicy(BackpressurePolicy policy, int blockTimeoutMs)
+{
+    if (blockTimeoutMs < 0) {
+        throw std::out_of_range("Producer block timeout cannot be negative");
+    }
+    mProducerBackpressurePolicy = policy;
+    mProducerBlockTimeoutMs = blockTimeoutMs;
+}
+
+void ServiceConfig::setTopicPriority(const std::string& topic, int priority)
+{
+    if (topic.empty()) {
+        throw std::invalid_argument("Topic name cannot be empty");
+    }
+    mTopicPriorities[topic] = priority;
+}
+
 TopicConfig& ServiceConfig::getTopicConfig()
 {
     return mTopicConfig;
@@ -7,6 +7,8 @@
 
 #include "TopicConfig.h"
 
+#include <stdexcept>
+
 TopicConfig::TopicConfig()
 {
 }
@@ -35,6 +37,11 @@ const std::string& TopicConfig::getAuditEvents() const
     return mAuditEvents;
 }
 
+const std::string& TopicConfig::getDeadLetterEvents() const
+{
+    return mDeadLetterEvents;
+}
+
 void TopicConfig::setUserEvents(const std::string& topic)
 {
     if (topic.empty())
@@ -94,4 +101,27 @@ void TopicConfig::setAuditEvents(const std::string& topic)
             // TODO: Log a warning that the topic name is already set
         }
     }
+}
+
+void TopicConfig::setDeadLetterEvents(const std::string& topic)
+{
+    if (topic.empty())
+    {
+        throw std::invalid_argument("Topic name cannot be empty");
+    }
+    mDeadLetterEvents = topic;
+}
+
+int TopicConfig::getPartitionCount() const
+{
+    return mPartitionCount;
+}
+
+void TopicConfig::setPartitionCount(int partitionCount)
+{
+    if (partitionCount <= 0)
+    {
+        throw std::out_of_range("Partition count must be greater than 0");
+    }
+    mPartitionCount = partitionCount;
 }
\ No newline at end of file
@@ -7,6 +7,16 @@
 
 #include "User.h"
 
+namespace
+{
+    // A field missing or holding another type, null included, reads as empty
+    std::string stringField(const nlohmann::json& object, const char* key)
+    {
+        const auto it = object.find(key);
+        return it != object.end() && it->is_string() ? it->get<std::string>() : std::string();
+    }
+}
+
 User::User()
 {
 }
@@ -23,12 +33,27 @@ User::~User()
 
 std::string User::toJson()
 {
-    return "";
+    json object = {
+        {"user_id", m_userId},
+        {"username", m_userName},
+        {"email", m_email},
+        {"created_at", m_createAt},
+        {"updated_at", m_updateAt}
+    };
+    return object.dump();
 }
 
-User User::fromJson(std::string const &jsonStr)
+User User::fromJson(std::string_view jsonStr)
 {
-    return User();
+    // Parse without exceptions, a malformed payload gives a user without id
+    const json object = json::parse(jsonStr, nullptr, false);
+    if (object.is_discarded() || !object.is_object())
+    {
+        return User();
+    }
+
+    return User(stringField(object, "user_id"), stringField(object, "username"), stringField(object, "email"),
+        stringField(object, "created_at"), stringField(object, "updated_at"));
 }
 
 bool User::isValid()
@@ -14,14 +14,32 @@ Event::Event(EventType type)
 
 void Event::setPayload(std::string const &payload)
 {
-    mPayload = payload;
+    mPayload = SharedPayload::fromString(payload);
 }
 
-std::string const &Event::getPayload() const
+void Event::setPayload(SharedPayload payload)
+{
+    mPayload = std::move(payload);
+}
+
+std::string_view Event::getPayload() const
+{
+    return mPayload.view();
+}
+
+SharedPayload const &Event::getSharedPayload() const
 {
     return mPayload;
 }
 
+void Event::ownPayload()
+{
+    mPayload = SharedPayload::fromString(std::string(mPayload.view()));
+    if (mFieldsOwner != nullptr && mOwnedFields == nullptr) {
+        ownFields();
+    }
+}
+
 user_profile::utils::event::EventType Event::getType() const
 {
     return mType;
@@ -30,4 +48,91 @@ user_profile::utils::event::EventType Event::getType() const
 void Event::setType(EventType type)
 {
     mType = type;
+}
+
+void Event::setId(std::string_view id)
+{
+    auto& fields = ownFields();
+    fields.id = id;
+    mId = fields.id;
+}
+
+std::string_view Event::getId() const
+{
+    return mId;
+}
+
+void Event::setKey(std::string_view key)
+{
+    auto& fields = ownFields();
+    fields.key = key;
+    mKey = fields.key;
+}
+
+std::string_view Event::getKey() const
+{
+    return mKey;
+}
+
+void Event::shareFields(std::string_view id, std::string_view key, std::string_view topic,
+    std::shared_ptr<const void> owner)
+{
+    mFieldsOwner = std::move(owner);
+    mOwnedFields = nullptr;
+    mId = id;
+    mKey = key;
+    mTopic = topic;
+}
+
+void Event::setSource(std::string_view topic, int32_t partition, int64_t offset)
+{
+    auto& fields = ownFields();
+    fields.topic = topic;
+    mTopic = fields.topic;
+    setPosition(partition, offset);
+}
+
+void Event::setPosition(int32_t partition, int64_t offset)
+{
+    mPartition = partition;
+    mOffset = offset;
+}
+
+std::string_view Event::getTopic() const
+{
+    return mTopic;
+}
+
+int32_t Event::getPartition() const
+{
+    return mPartition;
+}
+
+int64_t Event::getOffset() const
+{
+    return mOffset;
+}
+
+void Event::setReceivedAt(Clock::time_point receivedAt)
+{
+    mReceivedAt = receivedAt;
+}
+
+Event::Clock::time_point Event::getReceivedAt() const
+{
+    return mReceivedAt;
+}
+
+Event::OwnedFields& Event::ownFields()
+{
+    // Copies share the block, so it is only written in place while this event is its sole owner
+    if (mOwnedFields == nullptr || mFieldsOwner.use_count() != 1) {
+        auto fields = std::make_shared<OwnedFields>(OwnedFields{std::string(mId), std::string(mKey), std::string(mTopic)});
+        mOwnedFields = fields.get();
+        mId = fields->id;
+        mKey = fields->key;
+        mTopic = fields->topic;
+        mFieldsOwner = std::move(fields);
+    }
+    return *mOwnedFields;
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file EventEnvelope.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of EventEnvelope class
+ */
+
+#include "EventEnvelope.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace
+{
+    constexpr char kMagic[4] = {'U', 'P', 'E', 'V'};
+
+    constexpr std::size_t kVersionOffset = 4;
+    constexpr std::size_t kHeaderSizeOffset = 6;
+    constexpr std::size_t kTypeOffset = 8;
+    constexpr std::size_t kUserIdSizeOffset = 10;
+    constexpr std::size_t kPayloadSizeOffset = 12;
+    constexpr std::size_t kTimestampOffset = 16;
+
+    // Byte by byte, so the layout does not depend on the host byte order or alignment
+    template <typename T>
+    T load(std::string_view bytes, std::size_t offset)
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            value |= std::uint64_t(static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+        }
+        return static_cast<T>(value);
+    }
+
+    template <typename T>
+    void store(char* out, T value)
+    {
+        const auto bits = static_cast<std::uint64_t>(value);
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            out[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+        }
+    }
+}
+
+bool EventEnvelope::encodeTo(std::string& out, EventType type, std::string_view userId, Clock::time_point timestamp,
+    std::string_view payload)
+{
+    if (userId.size() > kMaxUserIdSize || payload.size() > std::numeric_limits<std::uint32_t>::max()) {
+        return false;
+    }
+
+    const std::size_t begin = out.size();
+    out.resize(begin + kHeaderSize);
+    char* header = out.data() + begin;
+    std::copy(std::begin(kMagic), std::end(kMagic), header);
+    store(header + kVersionOffset, kVersion);
+    store(header + kHeaderSizeOffset, static_cast<std::uint16_t>(kHeaderSize));
+    store(header + kTypeOffset, static_cast<std::uint16_t>(type));
+    store(header + kUserIdSizeOffset, static_cast<std::uint16_t>(userId.size()));
+    store(header + kPayloadSizeOffset, static_cast<std::uint32_t>(payload.size()));
+    store(header + kTimestampOffset, static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count()));
+    out.append(userId);
+    out.append(payload);
+    return true;
+}
+
+std::string EventEnvelope::encode(EventType type, std::string_view userId, Clock::time_point timestamp,
+    std::string_view payload)
+{
+    std::string out;
+    out.reserve(kHeaderSize + userId.size() + payload.size());
+    if (!encodeTo(out, type, userId, timestamp, payload)) {
+        return {};
+    }
+    return out;
+}
+
+bool EventEnvelope::isEnvelope(std::string_view bytes)
+{
+    return bytes.size() >= sizeof(kMagic) && bytes.compare(0, sizeof(kMagic), kMagic, sizeof(kMagic)) == 0;
+}
+
+std::optional<EventEnvelope> EventEnvelope::read(std::string_view bytes)
+{
+    if (bytes.size() < kHeaderSize || !isEnvelope(bytes)) {
+        return std::nullopt;
+    }
+    const std::size_t headerSize = load<std::uint16_t>(bytes, kHeaderSizeOffset);
+    const std::size_t userIdSize = load<std::uint16_t>(bytes, kUserIdSizeOffset);
+    const std::size_t payloadSize = load<std::uint32_t>(bytes, kPayloadSizeOffset);
+    if (load<std::uint16_t>(bytes, kVersionOffset) == 0 || headerSize < kHeaderSize
+        || bytes.size() < headerSize + userIdSize + payloadSize) {
+        return std::nullopt;
+    }
+    return EventEnvelope(bytes.substr(0, headerSize + userIdSize + payloadSize));
+}
+
+EventEnvelope::EventEnvelope(std::string_view bytes)
+    : mBytes(bytes)
+{
+}
+
+std::uint16_t EventEnvelope::getVersion() const
+{
+    return load<std::uint16_t>(mBytes, kVersionOffset);
+}
+
+EventEnvelope::EventType EventEnvelope::getType() const
+{
+    return static_cast<EventType>(load<std::uint16_t>(mBytes, kTypeOffset));
+}
+
+std::string_view EventEnvelope::getUserId() const
+{
+    return mBytes.substr(load<std::uint16_t>(mBytes, kHeaderSizeOffset), load<std::uint16_t>(mBytes, kUserIdSizeOffset));
+}
+
+EventEnvelope::Clock::time_point EventEnvelope::getTimestamp() const
+{
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+        std::chrono::milliseconds(load<std::int64_t>(mBytes, kTimestampOffset))));
+}
+
+std::string_view EventEnvelope::getPayload() const
+{
+    const std::size_t userIdEnd = std::size_t(load<std::uint16_t>(mBytes, kHeaderSizeOffset))
+        + load<std::uint16_t>(mBytes, kUserIdSizeOffset);
+    return mBytes.substr(userIdEnd);
+}
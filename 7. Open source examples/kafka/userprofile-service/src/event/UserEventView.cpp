@@ -0,0 +1,515 @@
+/**
+ * @file UserEventView.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of UserEventView class
+ */
+
+#include "UserEventView.h"
+
+#include <chrono>
+
+#include "EventEnvelope.h"
+#include "User.h"
+
+namespace
+{
+    // JSON keys as User::toJson writes them, in the order of UserEventView::Field
+    constexpr std::string_view kJsonKeys[] = {"user_id", "email", "username", "created_at", "updated_at"};
+
+    // Protobuf wire types, see https://protobuf.dev/programming-guides/encoding
+    constexpr std::uint64_t kVarint = 0;
+    constexpr std::uint64_t kFixed64 = 1;
+    constexpr std::uint64_t kLengthDelimited = 2;
+    constexpr std::uint64_t kFixed32 = 5;
+
+    // google.protobuf.Timestamp field numbers
+    constexpr std::uint64_t kSecondsField = 1;
+    constexpr std::uint64_t kNanosField = 2;
+
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    void skipSpace(std::string_view bytes, std::size_t& pos)
+    {
+        while (pos < bytes.size() && isSpace(bytes[pos])) {
+            ++pos;
+        }
+    }
+
+    /**
+     * @brief Scan a JSON string, pos is on the opening quote and ends behind the closing one
+     * @return false if the string is not terminated
+     */
+    bool scanString(std::string_view bytes, std::size_t& pos, std::string_view& contents)
+    {
+        const std::size_t begin = ++pos;
+        while (pos < bytes.size()) {
+            if (bytes[pos] == '\\') {
+                pos += 2;
+            } else if (bytes[pos] == '"') {
+                contents = bytes.substr(begin, pos - begin);
+                ++pos;
+                return true;
+            } else {
+                ++pos;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Skip a JSON value without decoding it
+     */
+    bool skipValue(std::string_view bytes, std::size_t& pos)
+    {
+        if (pos >= bytes.size()) {
+            return false;
+        }
+
+        std::string_view ignored;
+        if (bytes[pos] == '"') {
+            return scanString(bytes, pos, ignored);
+        }
+
+        if (bytes[pos] == '{' || bytes[pos] == '[') {
+            std::size_t depth = 0;
+            while (pos < bytes.size()) {
+                const char c = bytes[pos];
+                if (c == '"') {
+                    if (!scanString(bytes, pos, ignored)) {
+                        return false;
+                    }
+                    continue;
+                }
+                ++pos;
+                if (c == '{' || c == '[') {
+                    ++depth;
+                } else if ((c == '}' || c == ']') && --depth == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // A number, true, false or null
+        const std::size_t begin = pos;
+        while (pos < bytes.size() && bytes[pos] != ',' && bytes[pos] != '}' && bytes[pos] != ']'
+            && !isSpace(bytes[pos])) {
+            ++pos;
+        }
+        return pos > begin;
+    }
+
+    void appendUtf8(std::string& out, std::uint32_t code)
+    {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xc0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xe0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        } else {
+            out.push_back(static_cast<char>(0xf0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        }
+    }
+
+    bool readHex4(std::string_view in, std::size_t pos, std::uint32_t& code)
+    {
+        if (pos + 4 > in.size()) {
+            return false;
+        }
+        code = 0;
+        for (std::size_t i = pos; i < pos + 4; ++i) {
+            const char c = in[i];
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= static_cast<std::uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= static_cast<std::uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= static_cast<std::uint32_t>(c - 'A' + 10);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Unescape the contents of a JSON string
+     */
+    bool unescape(std::string_view in, std::string& out)
+    {
+        out.reserve(in.size());
+        for (std::size_t pos = 0; pos < in.size(); ++pos) {
+            if (in[pos] != '\\') {
+                out.push_back(in[pos]);
+                continue;
+            }
+            if (++pos >= in.size()) {
+                return false;
+            }
+            switch (in[pos]) {
+            case '"': out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '/': out.push_back('/'); break;
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'u': {
+                std::uint32_t code = 0;
+                if (!readHex4(in, pos + 1, code)) {
+                    return false;
+                }
+                pos += 4;
+                if (code >= 0xd800 && code < 0xdc00) {
+                    // A high surrogate, the low one follows as another \u escape
+                    std::uint32_t low = 0;
+                    if (pos + 2 >= in.size() || in[pos + 1] != '\\' || in[pos + 2] != 'u'
+                        || !readHex4(in, pos + 3, low) || low < 0xdc00 || low >= 0xe000) {
+                        return false;
+                    }
+                    pos += 6;
+                    code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                } else if (code >= 0xdc00 && code < 0xe000) {
+                    return false;
+                }
+                appendUtf8(out, code);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readVarint(std::string_view bytes, std::size_t& pos, std::uint64_t& value)
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64 && pos < bytes.size(); shift += 7) {
+            const auto byte = static_cast<unsigned char>(bytes[pos++]);
+            value |= std::uint64_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Skip the value of a protobuf field, pos is behind its tag
+     * @param bytes The message
+     * @param pos Where the value starts, ends behind it
+     * @param wireType The wire type from the tag
+     * @param contents Receives the bytes of a length delimited value
+     */
+    bool skipField(std::string_view bytes, std::size_t& pos, std::uint64_t wireType, std::string_view& contents)
+    {
+        std::uint64_t value = 0;
+        switch (wireType) {
+        case kVarint:
+            return readVarint(bytes, pos, value);
+        case kFixed64:
+        case kFixed32: {
+            const std::size_t size = wireType == kFixed64 ? 8 : 4;
+            if (bytes.size() - pos < size) {
+                return false;
+            }
+            pos += size;
+            return true;
+        }
+        case kLengthDelimited:
+            if (!readVarint(bytes, pos, value) || value > bytes.size() - pos) {
+                return false;
+            }
+            contents = bytes.substr(pos, static_cast<std::size_t>(value));
+            pos += static_cast<std::size_t>(value);
+            return true;
+        default:
+            return false; // Groups are not used by proto3
+        }
+    }
+
+    /**
+     * @brief Append a non negative number zero padded to width digits
+     */
+    void appendDigits(std::string& out, std::int64_t value, std::size_t width)
+    {
+        const std::size_t end = out.size() + width;
+        out.resize(end, '0');
+        for (std::size_t pos = end; value > 0 && pos > end - width; value /= 10) {
+            out[--pos] = static_cast<char>('0' + value % 10);
+        }
+    }
+
+    /**
+     * @brief Format an encoded google.protobuf.Timestamp as RFC 3339 in UTC
+     */
+    bool formatTimestamp(std::string_view message, std::string& out)
+    {
+        std::int64_t seconds = 0;
+        std::int64_t nanos = 0;
+        std::size_t pos = 0;
+        while (pos < message.size()) {
+            std::uint64_t tag = 0;
+            if (!readVarint(message, pos, tag)) {
+                return false;
+            }
+            if ((tag & 7) == kVarint && ((tag >> 3) == kSecondsField || (tag >> 3) == kNanosField)) {
+                std::uint64_t value = 0;
+                if (!readVarint(message, pos, value)) {
+                    return false;
+                }
+                if ((tag >> 3) == kSecondsField) {
+                    seconds = static_cast<std::int64_t>(value);
+                } else {
+                    nanos = static_cast<std::int32_t>(value);
+                }
+                continue;
+            }
+            std::string_view ignored;
+            if (!skipField(message, pos, tag & 7, ignored)) {
+                return false;
+            }
+        }
+
+        // The range google.protobuf.Timestamp allows, 0001-01-01 to 9999-12-31
+        constexpr std::int64_t kMinSeconds = -62135596800;
+        constexpr std::int64_t kMaxSeconds = 253402300799;
+        if (seconds < kMinSeconds || seconds > kMaxSeconds || nanos < 0 || nanos > 999999999) {
+            return false;
+        }
+
+        using namespace std::chrono;
+        const sys_seconds time{std::chrono::seconds(seconds)};
+        const auto day = floor<days>(time);
+        const year_month_day date{day};
+        const hh_mm_ss clock{time - day};
+
+        out.clear();
+        out.reserve(30);
+        appendDigits(out, static_cast<int>(date.year()), 4);
+        out.push_back('-');
+        appendDigits(out, static_cast<unsigned>(date.month()), 2);
+        out.push_back('-');
+        appendDigits(out, static_cast<unsigned>(date.day()), 2);
+        out.push_back('T');
+        appendDigits(out, clock.hours().count(), 2);
+        out.push_back(':');
+        appendDigits(out, clock.minutes().count(), 2);
+        out.push_back(':');
+        appendDigits(out, clock.seconds().count(), 2);
+        // As few fraction digits as the JSON mapping writes: none, 3, 6 or 9
+        if (nanos != 0) {
+            out.push_back('.');
+            if (nanos % 1000000 == 0) {
+                appendDigits(out, nanos / 1000000, 3);
+            } else if (nanos % 1000 == 0) {
+                appendDigits(out, nanos / 1000, 6);
+            } else {
+                appendDigits(out, nanos, 9);
+            }
+        }
+        out.push_back('Z');
+        return true;
+    }
+}
+
+UserEventView::UserEventView(std::string_view payload)
+    : mPayload(payload)
+{
+    if (const auto envelope = EventEnvelope::read(payload)) {
+        mPayload = envelope->getPayload();
+        auto& userId = mSlots[eUserId];
+        userId.state = State::eDecoded;
+        userId.value = envelope->getUserId();
+    }
+
+    skipSpace(mPayload, mCursor);
+    if (mCursor < mPayload.size() && mPayload[mCursor] == '{') {
+        mEncoding = Encoding::eJson;
+        ++mCursor;
+        skipSpace(mPayload, mCursor);
+        if (mCursor < mPayload.size() && mPayload[mCursor] == '}') {
+            mDone = true;
+        }
+    } else {
+        // Protobuf has no framing to check, an empty payload is an empty message
+        mEncoding = Encoding::eProtobuf;
+        mCursor = 0;
+    }
+}
+
+UserEventView::Encoding UserEventView::getEncoding() const
+{
+    return mEncoding;
+}
+
+bool UserEventView::isValid() const
+{
+    return mValid;
+}
+
+std::string_view UserEventView::getUserId()
+{
+    return get(eUserId);
+}
+
+std::string_view UserEventView::getUserName()
+{
+    return get(eUserName);
+}
+
+std::string_view UserEventView::getEmail()
+{
+    return get(eEmail);
+}
+
+std::string_view UserEventView::getCreateAt()
+{
+    return get(eCreateAt);
+}
+
+std::string_view UserEventView::getUpdateAt()
+{
+    return get(eUpdateAt);
+}
+
+User UserEventView::toUser()
+{
+    while (!mDone) {
+        mDone = !(mEncoding == Encoding::eJson ? scanJson() : scanProtobuf());
+    }
+    return User(std::string(getUserId()), std::string(getUserName()), std::string(getEmail()),
+        std::string(getCreateAt()), std::string(getUpdateAt()));
+}
+
+std::string_view UserEventView::get(Field field)
+{
+    auto& slot = mSlots[field];
+    while (slot.state == State::eUnseen && !mDone) {
+        mDone = !(mEncoding == Encoding::eJson ? scanJson() : scanProtobuf());
+    }
+    if (slot.state == State::eRaw) {
+        decode(field);
+    }
+    return slot.value;
+}
+
+void UserEventView::decode(Field field)
+{
+    auto& slot = mSlots[field];
+    slot.state = State::eDecoded;
+    if (mEncoding == Encoding::eProtobuf) {
+        if (field == eCreateAt || field == eUpdateAt) {
+            if (formatTimestamp(slot.raw, slot.decoded)) {
+                slot.value = slot.decoded;
+            } else {
+                mValid = false;
+            }
+        } else {
+            slot.value = slot.raw;
+        }
+        return;
+    }
+
+    if (slot.raw.find('\\') == std::string_view::npos) {
+        slot.value = slot.raw;
+    } else if (unescape(slot.raw, slot.decoded)) {
+        slot.value = slot.decoded;
+    } else {
+        slot.decoded.clear();
+        mValid = false;
+    }
+}
+
+bool UserEventView::scanJson()
+{
+    // The cursor is on the key of the next member
+    std::string_view key;
+    if (mCursor >= mPayload.size() || mPayload[mCursor] != '"' || !scanString(mPayload, mCursor, key)) {
+        mValid = false;
+        return false;
+    }
+    skipSpace(mPayload, mCursor);
+    if (mCursor >= mPayload.size() || mPayload[mCursor] != ':') {
+        mValid = false;
+        return false;
+    }
+    ++mCursor;
+    skipSpace(mPayload, mCursor);
+
+    std::size_t field = eFieldCount;
+    for (std::size_t index = 0; index < eFieldCount; ++index) {
+        if (key == kJsonKeys[index]) {
+            field = index;
+            break;
+        }
+    }
+
+    if (field != eFieldCount && mCursor < mPayload.size() && mPayload[mCursor] == '"') {
+        std::string_view contents;
+        if (!scanString(mPayload, mCursor, contents)) {
+            mValid = false;
+            return false;
+        }
+        auto& slot = mSlots[field];
+        if (slot.state == State::eUnseen) {
+            slot.state = State::eRaw;
+            slot.raw = contents;
+        }
+    } else if (!skipValue(mPayload, mCursor)) {
+        mValid = false;
+        return false;
+    }
+
+    skipSpace(mPayload, mCursor);
+    if (mCursor < mPayload.size() && mPayload[mCursor] == ',') {
+        ++mCursor;
+        skipSpace(mPayload, mCursor);
+        return true;
+    }
+    if (mCursor < mPayload.size() && mPayload[mCursor] == '}') {
+        ++mCursor;
+        return false;
+    }
+    mValid = false;
+    return false;
+}
+
+bool UserEventView::scanProtobuf()
+{
+    if (mCursor >= mPayload.size()) {
+        return false;
+    }
+
+    std::uint64_t tag = 0;
+    std::string_view contents;
+    if (!readVarint(mPayload, mCursor, tag) || (tag >> 3) == 0 || !skipField(mPayload, mCursor, tag & 7, contents)) {
+        mValid = false;
+        return false;
+    }
+
+    // user_service.User numbers its fields 1 to 5 in the order of Field, all length delimited
+    const std::uint64_t number = tag >> 3;
+    if ((tag & 7) == kLengthDelimited && number <= eFieldCount) {
+        auto& slot = mSlots[static_cast<std::size_t>(number - 1)];
+        if (slot.state == State::eUnseen) {
+            slot.state = State::eRaw;
+            slot.raw = contents;
+        }
+    }
+    return mCursor < mPayload.size();
+}
@@ -8,12 +8,60 @@
 #include "AuditEventHandler.h"
 
 #include "Event.h"
+#include "EventEnvelope.h"
+#include "logger/LoggerStream.h"
+
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <utility>
+
+AuditEventHandler::AuditEventHandler(AuditSink sink)
+    : mSink(std::move(sink))
+{
+}
 
 bool AuditEventHandler::handleEvent(const Event& event)
 {
-    // Implement the logic to handle audit events here
-    // For example, log the event or perform some action based on the event type
-    // This is a placeholder implementation
-    // Return true to indicate that the event was handled successfully
-    return true;
+    return handleEvents(std::span<const Event>(&event, 1)).empty();
+}
+
+std::vector<std::size_t> AuditEventHandler::handleEvents(std::span<const Event> events)
+{
+    // Audit entries of the whole batch are appended in a single write instead of one per event
+    std::size_t bytes = 0;
+    for (const auto& event : events) {
+        bytes += event.getPayload().size() + 1;
+    }
+
+    std::string entries;
+    entries.reserve(bytes);
+    for (const auto& event : events) {
+        // An envelope is audited from its header alone, the payload is neither parsed nor copied
+        if (const auto envelope = EventEnvelope::read(event.getPayload())) {
+            entries.append(std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                envelope->getTimestamp().time_since_epoch()).count()));
+            entries.push_back(' ');
+            entries.append(std::to_string(static_cast<std::uint16_t>(envelope->getType())));
+            entries.push_back(' ');
+            entries.append(envelope->getUserId());
+            entries.push_back(' ');
+            entries.append(std::to_string(envelope->getPayload().size()));
+        } else {
+            entries.append(event.getPayload());
+        }
+        entries.push_back('\n');
+    }
+
+    if (!mSink) {
+        LOG(logger::LogLevel::Info) << "Audit:\n" << entries;
+        return {};
+    }
+    if (!mSink(entries)) {
+        // Nothing of the batch is known to be stored, every event is retried
+        std::vector<std::size_t> failed(events.size());
+        std::iota(failed.begin(), failed.end(), std::size_t(0));
+        return failed;
+    }
+    return {};
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+/**
+ * @file HandlerRegistry.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of HandlerRegistry class
+ */
+
+#include "HandlerRegistry.h"
+
+#include <algorithm>
+
+HandlerRegistry::HandlerRegistry()
+    : mRoutes(1)
+{
+}
+
+void HandlerRegistry::add(std::shared_ptr<Handler> handler, EventTypeMask types)
+{
+    if (handler == nullptr) {
+        return;
+    }
+    for (std::size_t type = 0; type < mByType.size(); ++type) {
+        if ((types & (EventTypeMask(1) << type)) != 0) {
+            mByType[type].push_back(handler);
+        }
+    }
+    rebuildRoutes();
+}
+
+bool HandlerRegistry::empty() const
+{
+    return std::all_of(mByType.begin(), mByType.end(), [](const Handlers& handlers) { return handlers.empty(); });
+}
+
+void HandlerRegistry::rebuildRoutes()
+{
+    // Only runs at startup, a linear search over at most kEventTypeCount routes is enough
+    mRoutes.clear();
+    for (std::size_t type = 0; type < mByType.size(); ++type) {
+        auto route = std::find(mRoutes.begin(), mRoutes.end(), mByType[type]);
+        if (route == mRoutes.end()) {
+            route = mRoutes.insert(mRoutes.end(), mByType[type]);
+        }
+        mRouteOf[type] = static_cast<std::uint8_t>(route - mRoutes.begin());
+    }
+}
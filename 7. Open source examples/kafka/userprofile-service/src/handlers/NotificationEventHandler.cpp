@@ -9,6 +9,29 @@
 
 #include "Event.h"
 
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    struct KeyAndType
+    {
+        std::string_view key;
+        Event::EventType type;
+
+        bool operator==(const KeyAndType&) const = default;
+    };
+
+    struct KeyAndTypeHash
+    {
+        std::size_t operator()(const KeyAndType& value) const
+        {
+            return std::hash<std::string_view>{}(value.key) ^ static_cast<std::size_t>(value.type);
+        }
+    };
+}
+
 bool NotificationEventHandler::handleEvent(const Event& event)
 {
     // Implement the logic to handle notification events here
@@ -16,4 +39,27 @@ bool NotificationEventHandler::handleEvent(const Event& event)
     // This is just a placeholder implementation
     // Return true to indicate that the event was handled successfully
     return true;
+}
+
+std::vector<std::size_t> NotificationEventHandler::handleEvents(std::span<const Event> events)
+{
+    // A user is notified once per batch and event type, about the latest event of that type;
+    // a creation followed by a deletion still sends both notifications
+    std::unordered_map<KeyAndType, std::size_t, KeyAndTypeHash> latest;
+    latest.reserve(events.size());
+    for (std::size_t index = 0; index < events.size(); ++index) {
+        latest[KeyAndType{events[index].getKey(), events[index].getType()}] = index;
+    }
+
+    std::vector<std::size_t> failed;
+    for (std::size_t index = 0; index < events.size(); ++index) {
+        const auto& key = events[index].getKey();
+        if (!key.empty() && latest[KeyAndType{key, events[index].getType()}] != index) {
+            continue; // Superseded by a later event of the same user and type
+        }
+        if (!handleEvent(events[index])) {
+            failed.push_back(index);
+        }
+    }
+    return failed;
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+/**
+ * @file AdaptivePoller.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of AdaptivePoller class
+ */
+
+#include "AdaptivePoller.h"
+
+#include <algorithm>
+
+AdaptivePoller::AdaptivePoller(Options options)
+    : mOptions(options)
+{
+    mOptions.minTimeout = std::max(mOptions.minTimeout, std::chrono::milliseconds(0));
+    mOptions.maxTimeout = std::max(mOptions.maxTimeout, mOptions.minTimeout);
+    mTimeout = mOptions.minTimeout;
+}
+
+std::chrono::milliseconds AdaptivePoller::nextTimeout() const
+{
+    return mTimeout;
+}
+
+void AdaptivePoller::onPoll(std::size_t records)
+{
+    if (records > 0) {
+        mTimeout = mOptions.minTimeout;
+        return;
+    }
+
+    ++mEmptyPolls;
+    const auto doubled = std::max(mTimeout * 2, std::chrono::milliseconds(1));
+    mTimeout = std::min(doubled, mOptions.maxTimeout);
+}
+
+std::uint64_t AdaptivePoller::emptyPolls() const
+{
+    return mEmptyPolls;
+}
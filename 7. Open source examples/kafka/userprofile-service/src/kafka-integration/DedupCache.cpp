@@ -0,0 +1,98 @@
+/**
+ * @file DedupCache.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of DedupCache class
+ */
+
+#include "DedupCache.h"
+
+#include "ShardRouter.h"
+
+DedupCache::DedupCache(std::size_t maxBytes)
+    : mStripeBytes(maxBytes / kStripes)
+{
+}
+
+bool DedupCache::testAndInsert(const Event& event)
+{
+    std::string id = idOf(event);
+    Stripe& stripe = stripeFor(id);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+
+    if (auto it = stripe.index.find(id); it != stripe.index.end()) {
+        stripe.order.splice(stripe.order.begin(), stripe.order, it->second);
+        mHits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    mMisses.fetch_add(1, std::memory_order_relaxed);
+
+    const std::size_t entryBytes = id.size() + kEntryOverhead;
+    if (entryBytes > mStripeBytes) {
+        return false; // Too large to ever fit, handled without being remembered
+    }
+    while (stripe.bytes + entryBytes > mStripeBytes) {
+        const std::string& oldest = stripe.order.back();
+        stripe.bytes -= oldest.size() + kEntryOverhead;
+        stripe.index.erase(oldest);
+        stripe.order.pop_back();
+        mEvictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    stripe.order.push_front(std::move(id));
+    stripe.index.emplace(stripe.order.front(), stripe.order.begin());
+    stripe.bytes += entryBytes;
+    return false;
+}
+
+void DedupCache::forget(const Event& event)
+{
+    const std::string id = idOf(event);
+    Stripe& stripe = stripeFor(id);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+
+    auto it = stripe.index.find(id);
+    if (it == stripe.index.end()) {
+        return;
+    }
+    const auto entry = it->second;
+    stripe.bytes -= entry->size() + kEntryOverhead;
+    stripe.index.erase(it);
+    stripe.order.erase(entry);
+}
+
+DedupCache::Snapshot DedupCache::stats() const
+{
+    Snapshot snapshot;
+    snapshot.hits = mHits.load(std::memory_order_relaxed);
+    snapshot.misses = mMisses.load(std::memory_order_relaxed);
+    snapshot.evictions = mEvictions.load(std::memory_order_relaxed);
+    for (const auto& stripe : mStripes) {
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        snapshot.entries += stripe.index.size();
+        snapshot.bytes += stripe.bytes;
+    }
+    return snapshot;
+}
+
+std::string DedupCache::idOf(const Event& event)
+{
+    // The prefix keeps producer IDs and record positions apart
+    if (!event.getId().empty()) {
+        std::string id = "i:";
+        id += event.getId();
+        return id;
+    }
+    std::string id = "o:";
+    id += event.getTopic();
+    id += '/';
+    id += std::to_string(event.getPartition());
+    id += '@';
+    id += std::to_string(event.getOffset());
+    return id;
+}
+
+DedupCache::Stripe& DedupCache::stripeFor(std::string_view id)
+{
+    return mStripes[ShardRouter::hashKey(id) % kStripes];
+}
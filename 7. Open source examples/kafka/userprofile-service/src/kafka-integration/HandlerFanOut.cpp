@@ -0,0 +1,308 @@
+/**
+ * @file HandlerFanOut.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of HandlerFanOut class
+ */
+
+#include "HandlerFanOut.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <optional>
+
+/**
+ * @brief State of one run() shared with its pool tasks
+ * A task of a handler which timed out may finish after run() returned, so the state is
+ * reference counted and the batch such a task reads is a copy owned here.
+ */
+struct HandlerFanOut::Job
+{
+    std::mutex mutex;
+    std::condition_variable done;
+    std::vector<Event> events;                    // copy of the batch, only if a handler has a timeout
+    std::vector<std::vector<std::size_t>> failed;
+    std::vector<bool> finished;                   // the result of the handler is in failed
+};
+
+void HandlerFanOut::add(const std::shared_ptr<Handler>& handler, Options options)
+{
+    if (handler == nullptr) {
+        return;
+    }
+    auto& slot = mSlotOf[handler.get()];
+    if (slot == nullptr) {
+        mSlots.push_back(std::make_unique<Slot>());
+        slot = mSlots.back().get();
+    }
+    slot->options = std::move(options);
+    slot->handler = handler;
+}
+
+void HandlerFanOut::start(std::size_t threads)
+{
+    if (threads > 0 && mPool == nullptr) {
+        mPool = std::make_unique<WorkStealingPool>(threads);
+    }
+    for (auto& slot : mSlots) {
+        if (!slot->options.lane.has_value() || slot->lane != nullptr) {
+            continue;
+        }
+        Slot* owner = slot.get();
+        slot->lane = std::make_unique<HandlerLane>(*slot->options.lane,
+            [owner](std::span<const Event> events) { return handle(*owner, *owner->handler, events); });
+    }
+}
+
+std::vector<std::vector<std::size_t>> HandlerFanOut::run(const Handlers& handlers, std::span<const Event> events,
+    const Deferred& deferred)
+{
+    std::vector<std::vector<std::size_t>> failed(handlers.size());
+    std::vector<Slot*> slots(handlers.size());
+    std::size_t shared = 0;
+    bool timed = false;
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        slots[i] = &slotOf(handlers[i].get());
+        if (slots[i]->lane == nullptr) {
+            ++shared;
+            timed = timed || slots[i]->options.timeout.count() > 0;
+            continue;
+        }
+        // Queued before the shared handlers start, so the lane works alongside them
+        slots[i]->lane->submit(events, [slot = slots[i], i, deferred](std::vector<std::size_t> result) {
+            slot->failedEvents.fetch_add(result.size(), std::memory_order_relaxed);
+            if (deferred) {
+                deferred(i, std::move(result));
+            }
+        });
+    }
+
+    // A lone handler runs on the calling thread unless it has a timeout the pool can enforce
+    if (mPool == nullptr || shared == 0 || (shared == 1 && !timed)) {
+        const auto startedAt = Clock::now();
+        for (std::size_t i = 0; i < handlers.size(); ++i) {
+            if (slots[i]->lane != nullptr) {
+                continue;
+            }
+            const auto timeout = slots[i]->options.timeout;
+            if (timeout.count() > 0 && !awaitIdle(*slots[i], startedAt + timeout)) {
+                failed[i] = timedOut(*slots[i], events.size()); // Still busy with a batch it overran
+                continue;
+            }
+            failed[i] = handle(*slots[i], *handlers[i], events);
+            slots[i]->failedEvents.fetch_add(failed[i].size(), std::memory_order_relaxed);
+        }
+        return failed;
+    }
+
+    // The calling thread takes a handler it can wait for as long as it takes, the pool the others
+    std::optional<std::size_t> local;
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        if (slots[i]->lane == nullptr && slots[i]->options.timeout.count() == 0 && !local.has_value()) {
+            local = i;
+        }
+    }
+
+    auto job = std::make_shared<Job>();
+    job->failed.resize(handlers.size());
+    job->finished.resize(handlers.size());
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        job->finished[i] = slots[i]->lane != nullptr; // isolated handlers report through deferred
+    }
+    if (timed) {
+        job->events.assign(events.begin(), events.end());
+    }
+
+    std::vector<bool> overran(handlers.size(), false);
+    const auto startedAt = Clock::now();
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        // A handler still busy with a batch it overran gets this one once it finished, within its
+        // timeout; it never runs two batches of the same events at once. Nothing was submitted
+        // yet, so job needs no lock here
+        const auto timeout = slots[i]->options.timeout;
+        if (slots[i]->lane == nullptr && timeout.count() > 0 && !awaitIdle(*slots[i], startedAt + timeout)) {
+            job->failed[i] = timedOut(*slots[i], events.size());
+            job->finished[i] = true;
+            overran[i] = true;
+        }
+    }
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        if (local == i || job->finished[i]) {
+            continue;
+        }
+        // Untimed handlers are always waited for, they can read the caller's batch
+        const auto batch = slots[i]->options.timeout.count() > 0 ? std::span<const Event>(job->events) : events;
+        mPool->submit([job, i, batch, slot = slots[i], handler = handlers[i]] {
+            auto result = handle(*slot, *handler, batch);
+            bool late = false;
+            {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                late = job->finished[i];
+                if (!late) {
+                    job->failed[i] = std::move(result);
+                    job->finished[i] = true;
+                }
+                job->done.notify_all();
+            }
+            if (late) {
+                // run() counted this task as overrunning when it gave up on it
+                std::lock_guard<std::mutex> lock(slot->overrunMutex);
+                --slot->overrunning;
+                slot->overrunDone.notify_all();
+            }
+        });
+    }
+    if (local.has_value()) {
+        failed[*local] = handle(*slots[*local], *handlers[*local], events);
+    }
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    while (true) {
+        bool waiting = false;
+        std::optional<Clock::time_point> deadline;
+        const auto now = Clock::now();
+        for (std::size_t i = 0; i < handlers.size(); ++i) {
+            if (local == i || job->finished[i]) {
+                continue;
+            }
+            const auto timeout = slots[i]->options.timeout;
+            if (timeout.count() > 0 && now >= startedAt + timeout) {
+                // Overran, the late result is dropped and the whole batch counts as failed. The
+                // handler is busy until its task finished, before the batch is retried
+                job->failed[i] = timedOut(*slots[i], events.size());
+                job->finished[i] = true;
+                overran[i] = true;
+                std::lock_guard<std::mutex> overrun(slots[i]->overrunMutex);
+                ++slots[i]->overrunning;
+                continue;
+            }
+            waiting = true;
+            if (timeout.count() > 0) {
+                deadline = std::min(deadline.value_or(Clock::time_point::max()), startedAt + timeout);
+            }
+        }
+        if (!waiting) {
+            break;
+        }
+        if (deadline.has_value()) {
+            job->done.wait_until(lock, *deadline);
+        } else {
+            job->done.wait(lock);
+        }
+    }
+
+    for (std::size_t i = 0; i < handlers.size(); ++i) {
+        if (slots[i]->lane != nullptr) {
+            continue;
+        }
+        if (local != i) {
+            failed[i] = std::move(job->failed[i]);
+        }
+        if (!overran[i]) {
+            slots[i]->failedEvents.fetch_add(failed[i].size(), std::memory_order_relaxed);
+        }
+    }
+    return failed;
+}
+
+bool HandlerFanOut::handleRetry(const std::shared_ptr<Handler>& handler, const Event& event)
+{
+    Slot& slot = slotOf(handler.get());
+    {
+        std::lock_guard<std::mutex> lock(slot.overrunMutex);
+        if (slot.overrunning > 0) {
+            return false; // Busy with a batch it overran, the next attempt comes after a backoff
+        }
+    }
+    return handler->handleEvent(event);
+}
+
+bool HandlerFanOut::isolated(const Handler* handler) const
+{
+    return slotOf(handler).lane != nullptr;
+}
+
+void HandlerFanOut::drain()
+{
+    for (auto& slot : mSlots) {
+        if (slot->lane != nullptr) {
+            slot->lane->drain();
+        }
+    }
+}
+
+void HandlerFanOut::stop()
+{
+    for (auto& slot : mSlots) {
+        if (slot->lane != nullptr) {
+            slot->lane->stop();
+        }
+    }
+}
+
+std::vector<HandlerFanOut::Snapshot> HandlerFanOut::stats() const
+{
+    std::vector<Snapshot> stats;
+    stats.reserve(mSlots.size());
+    for (const auto& slot : mSlots) {
+        Snapshot snapshot;
+        snapshot.name = slot->options.name;
+        snapshot.batches = slot->batches.load(std::memory_order_relaxed);
+        snapshot.events = slot->events.load(std::memory_order_relaxed);
+        snapshot.failedEvents = slot->failedEvents.load(std::memory_order_relaxed);
+        snapshot.timeouts = slot->timeouts.load(std::memory_order_relaxed);
+        snapshot.latencyUs = slot->latencyUs.snapshot();
+        if (slot->lane != nullptr) {
+            snapshot.queueDepth = slot->lane->queuedEvents();
+            snapshot.spillDepth = slot->lane->spillDepth();
+            snapshot.shedEvents = slot->lane->shedEvents();
+            snapshot.spilledEvents = slot->lane->spilledEvents();
+            snapshot.queueUs = slot->lane->queueUs();
+        }
+        stats.push_back(std::move(snapshot));
+    }
+    return stats;
+}
+
+HandlerFanOut::Slot& HandlerFanOut::slotOf(const Handler* handler)
+{
+    // Only written before start(), reading needs no lock
+    const auto it = mSlotOf.find(handler);
+    return it != mSlotOf.end() ? *it->second : mUnnamed;
+}
+
+const HandlerFanOut::Slot& HandlerFanOut::slotOf(const Handler* handler) const
+{
+    const auto it = mSlotOf.find(handler);
+    return it != mSlotOf.end() ? *it->second : mUnnamed;
+}
+
+std::vector<std::size_t> HandlerFanOut::handle(Slot& slot, Handler& handler, std::span<const Event> events)
+{
+    const auto startedAt = Clock::now();
+    auto failed = handler.handleEvents(events);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startedAt);
+
+    // Failures are counted by run(), the result of a handler which timed out is dropped
+    slot.batches.fetch_add(1, std::memory_order_relaxed);
+    slot.events.fetch_add(events.size(), std::memory_order_relaxed);
+    slot.latencyUs.record(static_cast<std::uint64_t>(elapsed.count()));
+    return failed;
+}
+
+bool HandlerFanOut::awaitIdle(Slot& slot, Clock::time_point deadline)
+{
+    std::unique_lock<std::mutex> lock(slot.overrunMutex);
+    return slot.overrunDone.wait_until(lock, deadline, [&slot] { return slot.overrunning == 0; });
+}
+
+std::vector<std::size_t> HandlerFanOut::timedOut(Slot& slot, std::size_t events)
+{
+    std::vector<std::size_t> failed(events);
+    std::iota(failed.begin(), failed.end(), std::size_t(0));
+    slot.timeouts.fetch_add(1, std::memory_order_relaxed);
+    slot.failedEvents.fetch_add(events, std::memory_order_relaxed);
+    return failed;
+}
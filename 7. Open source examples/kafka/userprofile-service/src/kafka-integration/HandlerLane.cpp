@@ -0,0 +1,373 @@
+/**
+ * @file HandlerLane.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of HandlerLane class
+ */
+
+#include "HandlerLane.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "logger/LoggerStream.h"
+
+namespace
+{
+    // Spill files only live as long as the lane which wrote them, fields are in host byte order
+    constexpr std::uint32_t kSpillMagic = 0x4c505355; // "USPL"
+    constexpr std::uint32_t kSpillVersion = 1;
+    constexpr const char* kSpillExtension = ".spill";
+
+    template <typename T>
+    void put(std::string& out, T value)
+    {
+        const auto* bytes = reinterpret_cast<const char*>(&value);
+        out.append(bytes, sizeof(value));
+    }
+
+    void putBytes(std::string& out, std::string_view bytes)
+    {
+        put(out, static_cast<std::uint32_t>(bytes.size()));
+        out.append(bytes);
+    }
+
+    template <typename T>
+    bool get(std::string_view& in, T& value)
+    {
+        if (in.size() < sizeof(value)) {
+            return false;
+        }
+        std::memcpy(&value, in.data(), sizeof(value));
+        in.remove_prefix(sizeof(value));
+        return true;
+    }
+
+    bool getBytes(std::string_view& in, std::string_view& bytes)
+    {
+        std::uint32_t size = 0;
+        if (!get(in, size) || in.size() < size) {
+            return false;
+        }
+        bytes = in.substr(0, size);
+        in.remove_prefix(size);
+        return true;
+    }
+
+    std::string encodeSpill(std::span<const Event> events)
+    {
+        std::string out;
+        put(out, kSpillMagic);
+        put(out, kSpillVersion);
+        put(out, static_cast<std::uint32_t>(events.size()));
+        for (const auto& event : events) {
+            put(out, static_cast<std::uint8_t>(event.getType()));
+            put(out, event.getPartition());
+            put(out, event.getOffset());
+            putBytes(out, event.getId());
+            putBytes(out, event.getKey());
+            putBytes(out, event.getTopic());
+            putBytes(out, event.getPayload());
+        }
+        return out;
+    }
+
+    std::optional<std::vector<Event>> decodeSpill(std::string_view in)
+    {
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        std::uint32_t count = 0;
+        if (!get(in, magic) || magic != kSpillMagic || !get(in, version) || version != kSpillVersion
+            || !get(in, count)) {
+            return std::nullopt;
+        }
+
+        std::vector<Event> events;
+        events.reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            std::uint8_t type = 0;
+            std::int32_t partition = -1;
+            std::int64_t offset = -1;
+            std::string_view id, key, topic, payload;
+            if (!get(in, type) || !get(in, partition) || !get(in, offset) || !getBytes(in, id)
+                || !getBytes(in, key) || !getBytes(in, topic) || !getBytes(in, payload)) {
+                return std::nullopt;
+            }
+            Event& event = events.emplace_back(static_cast<Event::EventType>(type));
+            event.setId(id);
+            event.setKey(key);
+            event.setSource(topic, partition, offset);
+            event.setPayload(SharedPayload::fromString(std::string(payload)));
+        }
+        return events;
+    }
+
+}
+
+HandlerLane::HandlerLane(Options options, Handle handle)
+    : mOptions(std::move(options))
+    , mHandle(std::move(handle))
+{
+    mOptions.workers = std::max<std::size_t>(mOptions.workers, 1);
+    mOptions.queueCapacity = std::max<std::size_t>(mOptions.queueCapacity, 1);
+    if (mOptions.overflow == Overflow::eSpill) {
+        clearSpillDirectory();
+    }
+
+    mWorkers.reserve(mOptions.workers);
+    for (std::size_t index = 0; index < mOptions.workers; ++index) {
+        mWorkers.emplace_back(&HandlerLane::workerLoop, this);
+    }
+}
+
+HandlerLane::~HandlerLane()
+{
+    stop();
+}
+
+void HandlerLane::submit(std::span<const Event> events, Done done)
+{
+    if (events.empty()) {
+        done({});
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    // Once something is spilled later batches follow it to disk, so the handler sees them in order
+    const bool spilling = mOptions.overflow == Overflow::eSpill && !mOptions.spillDirectory.empty();
+    if (!mStopping && !(spilling && !mSpilled.empty()) && fitsLocked(events.size())) {
+        mQueue.push_back(Job{std::vector<Event>(events.begin(), events.end()), std::move(done), Clock::now()});
+        mQueuedEvents += events.size();
+        lock.unlock();
+        mWork.notify_one();
+        return;
+    }
+
+    if (mOptions.overflow == Overflow::eShed && !mStopping) {
+        lock.unlock();
+        mShedEvents.fetch_add(events.size(), std::memory_order_relaxed);
+        done({});
+        return;
+    }
+
+    if (spilling && !mStopping) {
+        lock.unlock();
+        if (auto file = spill(events)) {
+            // done is called once the batch was read back and handled, the offsets wait until then
+            file->done = std::move(done);
+            mSpilledEvents.fetch_add(events.size(), std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> relock(mMutex);
+                mSpillDepth += file->events;
+                mSpilled.push_back(std::move(*file));
+            }
+            mWork.notify_one();
+            return;
+        }
+        LOG(logger::LogLevel::Warning) << "Cannot spill a batch to " << mOptions.spillDirectory.string()
+                                       << ", it waits for space in the queue";
+        lock.lock();
+    }
+
+    mSpace.wait(lock, [this, &events] { return mStopping || fitsLocked(events.size()); });
+    if (mStopping) {
+        return; // Never handled, the offsets of the batch are not committed
+    }
+    mQueue.push_back(Job{std::vector<Event>(events.begin(), events.end()), std::move(done), Clock::now()});
+    mQueuedEvents += events.size();
+    lock.unlock();
+    mWork.notify_one();
+}
+
+void HandlerLane::drain()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mIdle.wait(lock, [this] { return mQueue.empty() && mSpilled.empty() && mRunningJobs == 0; });
+}
+
+void HandlerLane::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWork.notify_all();
+    mSpace.notify_all();
+    for (auto& worker : mWorkers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // Their offsets were never committed, the broker redelivers them
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto& file : mSpilled) {
+        std::error_code error;
+        std::filesystem::remove(file.path, error);
+    }
+    mSpilled.clear();
+    mSpillDepth = 0;
+}
+
+std::size_t HandlerLane::queuedEvents() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mQueuedEvents;
+}
+
+std::size_t HandlerLane::spillDepth() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mSpillDepth;
+}
+
+std::uint64_t HandlerLane::shedEvents() const
+{
+    return mShedEvents.load(std::memory_order_relaxed);
+}
+
+std::uint64_t HandlerLane::spilledEvents() const
+{
+    return mSpilledEvents.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot HandlerLane::queueUs() const
+{
+    return mQueueUs.snapshot();
+}
+
+bool HandlerLane::fitsLocked(std::size_t events) const
+{
+    // A batch larger than the whole capacity still goes into an empty queue
+    return mQueue.empty() || mQueuedEvents + events <= mOptions.queueCapacity;
+}
+
+std::optional<HandlerLane::SpillFile> HandlerLane::spill(std::span<const Event> events)
+{
+    std::uint64_t sequence = 0;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        sequence = mNextSpill++;
+    }
+
+    // Zero padded, so the file names sort in spill order
+    std::string name = std::to_string(sequence);
+    name.insert(0, 20 - std::min<std::size_t>(name.size(), 20), '0');
+    const auto path = mOptions.spillDirectory / (name + kSpillExtension);
+    const auto partial = mOptions.spillDirectory / (name + ".tmp");
+
+    const std::string bytes = encodeSpill(events);
+    {
+        std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+        if (!out.write(bytes.data(), static_cast<std::streamsize>(bytes.size())) || !out.flush()) {
+            std::error_code error;
+            std::filesystem::remove(partial, error);
+            return std::nullopt;
+        }
+    }
+    // A crash never leaves a half written file behind under the final name
+    std::error_code error;
+    std::filesystem::rename(partial, path, error);
+    if (error) {
+        std::filesystem::remove(partial, error);
+        return std::nullopt;
+    }
+    return SpillFile{path, events.size(), {}};
+}
+
+void HandlerLane::clearSpillDirectory()
+{
+    if (mOptions.spillDirectory.empty()) {
+        return;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(mOptions.spillDirectory, error);
+    if (error) {
+        LOG(logger::LogLevel::Error) << "Cannot create the spill directory " << mOptions.spillDirectory.string()
+                                     << ", the lane blocks instead of spilling: " << error.message();
+        mOptions.spillDirectory.clear();
+        return;
+    }
+
+    // Left by a run which stopped before handling them; their offsets were not committed either
+    std::size_t removed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(mOptions.spillDirectory, error)) {
+        const auto extension = entry.path().extension();
+        if (entry.is_regular_file() && (extension == kSpillExtension || extension == ".tmp")) {
+            std::error_code removeError;
+            removed += std::filesystem::remove(entry.path(), removeError) ? 1 : 0;
+        }
+    }
+    if (removed > 0) {
+        LOG(logger::LogLevel::Warning) << "Removed " << removed << " spill files of a previous run from "
+                                       << mOptions.spillDirectory.string() << ", the broker redelivers them";
+    }
+}
+
+void HandlerLane::workerLoop()
+{
+    while (true) {
+        std::optional<Job> job;
+        std::optional<SpillFile> file;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWork.wait(lock, [this] { return mStopping || !mQueue.empty() || !mSpilled.empty(); });
+            if (!mQueue.empty()) {
+                // Queued batches are older than every spilled one, they go first
+                job = std::move(mQueue.front());
+                mQueue.pop_front();
+                mQueuedEvents -= job->events.size();
+                ++mRunningJobs;
+            } else if (mStopping) {
+                break; // stop() removes the spilled batches, they are redelivered
+            } else {
+                file = std::move(mSpilled.front());
+                mSpilled.pop_front();
+                ++mRunningJobs;
+            }
+        }
+        mSpace.notify_all();
+
+        if (file.has_value()) {
+            handleSpilled(*file);
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mSpillDepth -= std::min(mSpillDepth, file->events);
+                --mRunningJobs;
+            }
+            mIdle.notify_all();
+            continue;
+        }
+
+        mQueueUs.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - job->queuedAt).count()));
+        job->done(mHandle(job->events));
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mRunningJobs;
+        }
+        mIdle.notify_all();
+    }
+}
+
+void HandlerLane::handleSpilled(SpillFile& file)
+{
+    std::string bytes;
+    {
+        std::ifstream in(file.path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::error_code error;
+    std::filesystem::remove(file.path, error);
+
+    const auto events = decodeSpill(bytes);
+    if (!events.has_value()) {
+        // done is never called, the offsets of the batch stay uncommitted and the broker redelivers it
+        LOG(logger::LogLevel::Error) << "Cannot read back the spilled batch " << file.path.string()
+                                     << ", its " << file.events << " events are not handled";
+        return;
+    }
+    file.done(mHandle(*events));
+}
@@ -0,0 +1,74 @@
+/**
+ * @file InFlightBudget.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of InFlightBudget class
+ */
+
+#include "InFlightBudget.h"
+
+InFlightBudget::InFlightBudget(std::size_t maxBytes, std::size_t maxRecords)
+    : mMaxBytes(maxBytes)
+    , mMaxRecords(maxRecords)
+{
+}
+
+bool InFlightBudget::tryAcquire(std::size_t bytes)
+{
+    if (mRecords.fetch_add(1) >= mMaxRecords) {
+        mRecords.fetch_sub(1);
+        return false;
+    }
+
+    const std::size_t used = mBytes.fetch_add(bytes);
+    if (used != 0 && used + bytes > mMaxBytes) {
+        // Roll back without the mutex, acquire() calls this while holding it
+        mBytes.fetch_sub(bytes);
+        mRecords.fetch_sub(1);
+        if (mWaiters.load() > 0) {
+            mReleased.notify_all();
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool InFlightBudget::acquire(std::size_t bytes, std::chrono::milliseconds timeout)
+{
+    if (tryAcquire(bytes)) {
+        return true;
+    }
+
+    mBlocked.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(mMutex);
+    ++mWaiters;
+    const bool acquired = mReleased.wait_for(lock, timeout, [this, bytes] { return tryAcquire(bytes); });
+    --mWaiters;
+    return acquired;
+}
+
+void InFlightBudget::release(std::size_t bytes)
+{
+    mBytes.fetch_sub(bytes);
+    mRecords.fetch_sub(1);
+
+    // Waiters register under the mutex before checking the budget, so none can miss this
+    if (mWaiters.load() > 0) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mReleased.notify_all();
+    }
+}
+
+ProducerMetrics::BudgetSnapshot InFlightBudget::usage() const
+{
+    ProducerMetrics::BudgetSnapshot snapshot;
+    snapshot.bytes = mBytes.load(std::memory_order_relaxed);
+    snapshot.records = mRecords.load(std::memory_order_relaxed);
+    snapshot.maxBytes = mMaxBytes;
+    snapshot.maxRecords = mMaxRecords;
+    snapshot.blocked = mBlocked.load(std::memory_order_relaxed);
+    snapshot.rejected = mRejected.load(std::memory_order_relaxed);
+    snapshot.dropped = mDropped.load(std::memory_order_relaxed);
+    return snapshot;
+}
@@ -9,52 +9,583 @@
 
  #include "const/KafkaConst.h"
 
+#include <algorithm>
+#include <charconv>
+
+#include "EventEnvelope.h"
+#include "logger/LoggerStream.h"
+
 KafkaMessageConsumer::KafkaMessageConsumer()
 {
 }
 
+KafkaMessageConsumer::KafkaMessageConsumer(const ServiceConfig& config, std::shared_ptr<IMessageBus> bus)
+    : mConfig(config)
+    , mBus(std::move(bus))
+{
+}
+
 KafkaMessageConsumer::~KafkaMessageConsumer()
 {
 }
 
+void KafkaMessageConsumer::registerHandler(std::shared_ptr<Handler> handler, HandlerRegistry::EventTypeMask types,
+    HandlerFanOut::Options options)
+{
+    mFanOut.add(handler, std::move(options));
+    mHandlers.add(std::move(handler), types);
+}
+
+void KafkaMessageConsumer::setDeadLetterSink(DeadLetterSink sink)
+{
+    mDeadLetterSink = std::move(sink);
+}
+
 bool KafkaMessageConsumer::initialize()
-{    
-    // TODO: implement the actual initialization logic with ServiceConfig and TopicConfig
-    // For now, we will use a hardcoded broker for demonstration purposes
-    if (kafka_const::kBrokers.empty()) {
-        return false; // No brokers configured
+{
+    std::set<std::string> topics;
+    const TopicConfig& topicConfig = mConfig.getTopicConfig();
+    for (const auto& topic : {topicConfig.getUserEvents(), topicConfig.getOrderEvents(),
+             topicConfig.getNotificationEvents(), topicConfig.getAuditEvents()}) {
+        if (!topic.empty()) {
+            topics.insert(topic);
+        }
+    }
+    if (topics.empty()) {
+        return false; // Nothing to consume
     }
 
-    auto broker = kafka_const::kBrokers.find("broker1");
-    if (broker == kafka_const::kBrokers.end()) {
-        return false; // Broker not found
+    if (mBus == nullptr) {
+        LOG(logger::LogLevel::Error) << "Cannot initialize the consumer without a message bus";
+        return false;
     }
 
-    const KAFKA_API::Properties properties({{"bootstrap.servers", broker->second}});
-    mConsumer = std::make_unique<KAFKA_API::clients::consumer::KafkaConsumer>(properties);
-    if (!mConsumer) {
-        return false; // Failed to create consumer
-    } else {
-        return true; // Consumer created successfully
+    AdaptivePoller::Options pollOptions;
+    pollOptions.minTimeout = std::chrono::milliseconds(mConfig.getConsumerMinPollTimeout());
+    pollOptions.maxTimeout = std::chrono::milliseconds(mConfig.getConsumerPollTimeout());
+    mPoller = std::make_unique<AdaptivePoller>(pollOptions);
+
+    OffsetTracker::Options commitOptions;
+    commitOptions.commitEveryRecords = static_cast<std::size_t>(mConfig.getConsumerCommitEveryRecords());
+    commitOptions.commitInterval = std::chrono::milliseconds(mConfig.getConsumerCommitIntervalMs());
+    mOffsets = std::make_unique<OffsetTracker>(commitOptions);
+
+    if (mConfig.getConsumerDedupMaxBytes() > 0) {
+        mDedup = std::make_unique<DedupCache>(mConfig.getConsumerDedupMaxBytes());
+    }
+
+    if (!mDeadLetterSink || mConfig.getTopicConfig().getDeadLetterEvents().empty()) {
+        LOG(logger::LogLevel::Warning) << "No dead-letter topic and sink, events which run out of retries "
+                                          "hold the committed offset of their partition";
     }
 
+    RetryScheduler::Options retryOptions;
+    retryOptions.maxAttempts = static_cast<std::size_t>(mConfig.getConsumerRetryMaxAttempts());
+    retryOptions.initialBackoff = std::chrono::milliseconds(mConfig.getConsumerRetryInitialBackoffMs());
+    retryOptions.maxBackoff = std::chrono::milliseconds(mConfig.getConsumerRetryMaxBackoffMs());
+    retryOptions.maxPendingEvents = mConfig.getConsumerRetryMaxEvents();
+    retryOptions.maxPendingBytes = mConfig.getConsumerRetryMaxBytes();
+    mRetries = std::make_unique<RetryScheduler>(retryOptions,
+        [this](const Event& event, std::size_t) {
+            const std::string& topic = mConfig.getTopicConfig().getDeadLetterEvents();
+            if (!mDeadLetterSink || topic.empty()) {
+                return false; // Fails closed, the scheduler logs it and holds the offset
+            }
+            return mDeadLetterSink(topic, event);
+        },
+        [this](const Event& event) { mOffsets->complete(event.getTopic(), event.getPartition(), event.getOffset()); },
+        [this](const std::shared_ptr<Handler>& handler, const Event& event) {
+            return mFanOut.handleRetry(handler, event);
+        });
+
+    mConsumer = mBus->createConsumer(mConfig.getKafkaGroupId(),
+        static_cast<std::size_t>(mConfig.getConsumerMaxPollRecords()));
+    if (mConsumer == nullptr) {
+        return false; // Failed to create consumer, the bus logged why
+    }
+    mConsumer->subscribe(topics, [this](auto type, const auto& partitions) { onRebalance(type, partitions); });
+
+    mFanOut.start(static_cast<std::size_t>(mConfig.getEventFanOutThreads()));
+
+    PartitionDispatcher::Options options;
+    options.workers = static_cast<std::size_t>(mConfig.getEventHandlerThreads());
+    options.queueCapacity = static_cast<std::size_t>(mConfig.getConsumerWorkerQueueCapacity());
+    options.ordering = mConfig.getConsumerDispatchOrdering();
+    mDispatcher = std::make_unique<PartitionDispatcher>(options,
+        [this](std::size_t, std::vector<Event>& events) { handleEvents(events); });
+
+    PartitionBackpressure::Options watermarks;
+    watermarks.highWatermark = static_cast<std::size_t>(mConfig.getConsumerQueueHighWatermark());
+    watermarks.lowWatermark = static_cast<std::size_t>(mConfig.getConsumerQueueLowWatermark());
+    mBackpressure = std::make_unique<PartitionBackpressure>(watermarks, *mDispatcher);
+
+    return true;
 }
 
 void KafkaMessageConsumer::consume()
 {
-     while (mRunning) {
-        // Poll messages from Kafka brokers
-        auto records = mConsumer->poll(std::chrono::milliseconds(100));
+    if (mConsumer == nullptr || mDispatcher == nullptr) {
+        return; // Consumer is not initialized
+    }
+
+    std::vector<Event> events;
+    while (mRunning.load(std::memory_order_acquire)) {
+        // Poll messages from Kafka brokers, the events share the batch instead of copying their payloads
+        const auto batch = mConsumer->poll(mPoller->nextTimeout());
+        mPoller->onPoll(batch->size());
+        const auto polledAt = ConsumerMetrics::Clock::now();
+
+        std::uint64_t bytes = 0;
+        events.reserve(batch->size());
+        for (const auto& record : batch->records()) {
+            events.push_back(toEvent(record, batch));
+            mOffsets->track(record.topic, record.partition, record.offset);
+            events.back().setReceivedAt(polledAt);
+            bytes += record.key.size() + record.value.size();
+        }
+        const auto decodedAt = ConsumerMetrics::Clock::now();
+        mMetrics.onPolled(events.size(), bytes,
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(decodedAt - polledAt).count()));
+
+        // Only blocks if a poll overshoots the queue capacity of a handler thread
+        mDispatcher->dispatch(std::move(events));
+        applyBackpressure();
+
+        const auto now = OffsetTracker::Clock::now();
+        if (mOffsets->commitDue(now)) {
+            commitHandled(false);
+        }
+        if (now - mLastMetricsPublish >= std::chrono::milliseconds(mConfig.getConsumerMetricsIntervalMs())) {
+            publishMetrics(now);
+        }
+    }
+
+    // Every polled record is handled and committed before the consumer leaves the group;
+    // events still waiting for a retry hold their offsets back and are consumed again
+    mDispatcher->stop();
+    mFanOut.stop();
+    mRetries->stop();
+    commitHandled(true);
+
+    mConsumer->close();
+}
+
+void KafkaMessageConsumer::stop()
+{
+    mRunning.store(false, std::memory_order_release);
+}
+
+std::shared_ptr<const ConsumerMetrics::Snapshot> KafkaMessageConsumer::metricsSnapshot() const
+{
+    return mMetrics.snapshot();
+}
 
-        for (const auto& record: records) {
-            if (!record.error()) {
-                // Handle the record
+Event KafkaMessageConsumer::toEvent(const PolledBatch::Record& record, const std::shared_ptr<const PolledBatch>& batch)
+{
+    auto type = Event::EventType::eUnknown;
+    std::string_view id;
+    for (const auto& [name, value] : batch->headers(record)) {
+        if (name == kafka_const::kEventTypeHeader) {
+            std::uint16_t number = 0;
+            if (std::from_chars(value.data(), value.data() + value.size(), number).ec == std::errc()) {
+                type = static_cast<Event::EventType>(number);
+            }
+        } else if (name == kafka_const::kEventIdHeader) {
+            id = value;
+        }
+    }
+
+    if (type == Event::EventType::eUnknown) {
+        // Records without the header route by the type in the envelope header, nothing is parsed
+        if (const auto envelope = EventEnvelope::read(record.value.view())) {
+            type = envelope->getType();
+        }
+    }
+
+    Event event(type);
+    event.setPayload(record.value);
+    event.shareFields(id, record.key, record.topic, batch);
+    event.setPosition(record.partition, record.offset);
+    return event;
+}
+
+void KafkaMessageConsumer::handleEvents(std::vector<Event>& events)
+{
+    const std::size_t freshCount = mDedup != nullptr ? skipDuplicates(events) : events.size();
+    const std::span<const Event> fresh(events.data(), freshCount);
+
+    std::vector<RetryScheduler::Handlers> failedBy; // only sized once a handler fails
+    std::shared_ptr<PendingEvents> pending;         // only made once an isolated handler takes a run
+    if (!fresh.empty()) {
+        const auto startedAt = ConsumerMetrics::Clock::now();
+        std::size_t failedCount = 0;
+        // Consecutive events with the same handlers go to them as one run, in order;
+        // the handlers of a run work on it in parallel
+        for (std::size_t begin = 0; begin < fresh.size();) {
+            const std::size_t route = mHandlers.routeOf(fresh[begin].getType());
+            std::size_t end = begin + 1;
+            while (end < fresh.size() && mHandlers.routeOf(fresh[end].getType()) == route) {
+                ++end;
+            }
+            const auto run = fresh.subspan(begin, end - begin);
+
+            const auto& routeHandlers = mHandlers.handlers(route);
+            HandlerFanOut::Deferred deferred;
+            const std::size_t isolated = static_cast<std::size_t>(std::count_if(routeHandlers.begin(),
+                routeHandlers.end(), [this](const auto& handler) { return mFanOut.isolated(handler.get()); }));
+            if (isolated > 0) {
+                if (pending == nullptr) {
+                    pending = std::make_shared<PendingEvents>();
+                    pending->failedBy = std::move(failedBy);
+                    pending->failedBy.resize(fresh.size());
+                }
+                {
+                    std::lock_guard<std::mutex> lock(pending->mutex);
+                    pending->remaining += isolated;
+                }
+                // The lanes of isolated handlers report after this run, possibly after the whole batch
+                deferred = [this, pending, begin, size = run.size(), handlers = &routeHandlers](std::size_t h,
+                               std::vector<std::size_t> failed) {
+                    std::unique_lock<std::mutex> lock(pending->mutex);
+                    addFailures(pending->failedBy, begin, size, (*handlers)[h], failed);
+                    if (--pending->remaining == 0) {
+                        lock.unlock();
+                        completeEvents(pending->events, pending->failedBy);
+                    }
+                };
+            }
+
+            const auto failedPerHandler = mFanOut.run(routeHandlers, run, deferred);
+            std::unique_lock<std::mutex> lock;
+            if (pending != nullptr) {
+                lock = std::unique_lock<std::mutex>(pending->mutex);
+            }
+            auto& runFailedBy = pending != nullptr ? pending->failedBy : failedBy;
+            for (std::size_t h = 0; h < routeHandlers.size(); ++h) {
+                if (!failedPerHandler[h].empty() && runFailedBy.empty()) {
+                    runFailedBy.resize(fresh.size());
+                }
+                failedCount += addFailures(runFailedBy, begin, run.size(), routeHandlers[h], failedPerHandler[h]);
+            }
+            begin = end;
+        }
+        mMetrics.onHandled(fresh, failedCount, startedAt, ConsumerMetrics::Clock::now());
+    }
+
+    if (pending != nullptr) {
+        // Whoever finishes last, this thread or a lane, completes the batch
+        std::unique_lock<std::mutex> lock(pending->mutex);
+        pending->events = std::move(events);
+        if (--pending->remaining > 0) {
+            return;
+        }
+        lock.unlock();
+        completeEvents(pending->events, pending->failedBy);
+        return;
+    }
+    if (failedBy.empty()) {
+        // Duplicates were handled before, their offsets move on with the rest
+        mOffsets->complete(std::span<const Event>(events));
+        supersedeRetries(events, failedBy);
+        return;
+    }
+    completeEvents(events, failedBy);
+}
+
+std::size_t KafkaMessageConsumer::addFailures(std::vector<RetryScheduler::Handlers>& failedBy, std::size_t begin,
+    std::size_t size, const std::shared_ptr<Handler>& handler, const std::vector<std::size_t>& failed)
+{
+    std::size_t newlyFailed = 0;
+    for (const auto index : failed) {
+        if (index >= size) {
+            continue;
+        }
+        auto& handlers = failedBy[begin + index];
+        if (handlers.empty()) {
+            ++newlyFailed;
+        }
+        if (handlers.empty() || handlers.back() != handler) {
+            handlers.push_back(handler);
+        }
+    }
+    return newlyFailed;
+}
+
+void KafkaMessageConsumer::completeEvents(std::vector<Event>& events, std::vector<RetryScheduler::Handlers>& failedBy)
+{
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        if (i >= failedBy.size() || failedBy[i].empty()) {
+            mOffsets->complete(events[i].getTopic(), events[i].getPartition(), events[i].getOffset());
+            continue;
+        }
+        if (mDedup != nullptr) {
+            mDedup->forget(events[i]); // A redelivery must reach the handlers again
+        }
+        // The scheduler completes the offset once the event is retried, superseded or dead-lettered
+        mRetries->schedule(events[i], failedBy[i]);
+    }
+    // After scheduling, so a later event of the same key this batch handled supersedes a failed one
+    supersedeRetries(events, failedBy);
+}
+
+void KafkaMessageConsumer::supersedeRetries(const std::vector<Event>& events,
+    const std::vector<RetryScheduler::Handlers>& failedBy)
+{
+    if (!mRetries->hasPendingKeys()) {
+        return;
+    }
+    static const RetryScheduler::Handlers kNone;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        mRetries->supersede(events[i], mHandlers.handlersFor(events[i].getType()),
+            i < failedBy.size() ? failedBy[i] : kNone);
+    }
+}
+
+std::size_t KafkaMessageConsumer::skipDuplicates(std::vector<Event>& events)
+{
+    std::size_t fresh = 0;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        if (mDedup->testAndInsert(events[i])) {
+            continue;
+        }
+        // Everything between fresh and i is a duplicate, so swapping keeps the fresh events in order
+        if (fresh != i) {
+            std::swap(events[fresh], events[i]);
+        }
+        ++fresh;
+    }
+    return fresh;
+}
+
+bool KafkaMessageConsumer::replay(const ReplayOptions& options, const ReplaySink& sink,
+    const ReplayProgressCallback& onProgress)
+{
+    const std::string topic = options.topic.empty() ? mConfig.getTopicConfig().getUserEvents() : options.topic;
+    if (topic.empty() || !sink || mBus == nullptr) {
+        return false; // Nothing to replay, nowhere to write to or nothing to read from
+    }
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    ReplayProgress progress;
+    ReplayDecoder decoder(options.decodeThreads);
+
+    auto report = [&](bool done) {
+        progress.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startedAt);
+        const double seconds = std::chrono::duration<double>(progress.elapsed).count();
+        progress.recordsPerSec = seconds > 0.0 ? static_cast<double>(progress.records) / seconds : 0.0;
+        progress.done = done;
+        if (onProgress) {
+            onProgress(progress);
+        }
+    };
+
+    auto flush = [&]() {
+        if (decoder.buffered() == 0) {
+            return true;
+        }
+        const auto batch = decoder.decode();
+        if (!sink(batch.upserts, batch.removedIds)) {
+            return false;
+        }
+        progress.upserts += batch.upserts.size();
+        progress.removals += batch.removedIds.size();
+        progress.skipped += batch.skipped;
+        ++progress.transactions;
+        return true;
+    };
+
+    // Large fetches, every record ends up in a batch anyway; no group, nothing is committed
+    const auto consumer = mBus->createConsumer("", std::max<std::size_t>(options.batchRecords, 1));
+    if (consumer == nullptr) {
+        report(false);
+        return false;
+    }
+
+    // The topic layout comes from the broker metadata, the configured partition count may be stale
+    const auto partitions = consumer->partitionsFor(topic);
+    if (partitions.empty()) {
+        LOG(logger::LogLevel::Error) << "Cannot replay " << topic << ", the broker knows no partitions of it";
+        report(false);
+        return false;
+    }
+    consumer->assign(partitions);
+
+    const auto beginOffsets = consumer->beginningOffsets(partitions);
+    const auto endOffsets = consumer->endOffsets(partitions);
+    IMessageBus::Offsets startOffsets;
+    if (options.fromTime.has_value()) {
+        startOffsets = consumer->offsetsForTime(partitions, *options.fromTime);
+    }
+
+    // Seek every partition and pause the ones which have nothing to replay
+    IMessageBus::TopicPartitions caughtUp;
+    for (const auto& topicPartition : partitions) {
+        const auto end = endOffsets.count(topicPartition) != 0 ? endOffsets.at(topicPartition) : 0;
+        std::int64_t start = options.fromOffset;
+        if (options.fromTime.has_value()) {
+            auto it = startOffsets.find(topicPartition);
+            start = it != startOffsets.end() && it->second >= 0 ? it->second : end; // No record that late
+        }
+        if (auto it = beginOffsets.find(topicPartition); it != beginOffsets.end()) {
+            start = std::max(start, it->second);
+        }
+        start = std::min(start, end);
+
+        progress.remaining += end - start;
+        if (start < end) {
+            consumer->seek(topicPartition, start);
+        } else {
+            caughtUp.insert(topicPartition);
+        }
+    }
+    if (!caughtUp.empty()) {
+        consumer->pause(caughtUp);
+    }
+
+    auto lastReport = std::chrono::steady_clock::now();
+    while (caughtUp.size() < partitions.size() && mRunning.load(std::memory_order_acquire)) {
+        const auto batch = consumer->poll(std::chrono::milliseconds(100));
+
+        for (const auto& record : batch->records()) {
+            if (record.offset >= endOffsets.at({std::string(record.topic), record.partition})) {
+                continue; // Produced after the replay started, consume() picks it up
+            }
+            ++progress.records;
+            progress.bytes += record.key.size() + record.value.size();
+            decoder.add(toEvent(record, batch));
+        }
+
+        // The position, not the last record, tells when a partition is done: transaction markers and
+        // aborted records sit in front of the end offset without ever being returned
+        IMessageBus::TopicPartitions reached;
+        progress.remaining = 0;
+        for (const auto& topicPartition : partitions) {
+            if (caughtUp.count(topicPartition) != 0) {
+                continue;
+            }
+            const auto end = endOffsets.at(topicPartition);
+            const auto position = consumer->position(topicPartition);
+            if (position >= end) {
+                caughtUp.insert(topicPartition);
+                reached.insert(topicPartition);
             } else {
-                // Handle the error
+                progress.remaining += end - std::max<std::int64_t>(position, 0);
             }
         }
+        if (!reached.empty()) {
+            consumer->pause(reached);
+        }
+
+        if (decoder.buffered() >= options.batchRecords && !flush()) {
+            LOG(logger::LogLevel::Error) << "Replay of " << topic << " stopped, the sink failed to write a batch";
+            report(false);
+            return false;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastReport >= options.progressInterval) {
+            lastReport = now;
+            report(false);
+        }
     }
 
-    // No explicit close is needed, RAII will take care of it
-    mConsumer->close();
-}
\ No newline at end of file
+    const bool completed = caughtUp.size() == partitions.size();
+    if (!flush()) {
+        LOG(logger::LogLevel::Error) << "Replay of " << topic << " stopped, the sink failed to write the last batch";
+        report(false);
+        return false;
+    }
+    report(completed);
+    consumer->close();
+    return completed;
+}
+
+void KafkaMessageConsumer::commitHandled(bool sync)
+{
+    const auto offsets = mOffsets->takeCommittable(OffsetTracker::Clock::now());
+    if (offsets.empty()) {
+        return; // An empty commit would commit the current positions instead
+    }
+
+    if (sync) {
+        if (!mConsumer->commit(offsets)) {
+            LOG(logger::LogLevel::Error) << "Failed to commit the handled offsets, they are consumed again";
+        }
+    } else {
+        // A failed commit is superseded by the next one, which carries higher offsets
+        mConsumer->commitAsync(offsets);
+    }
+}
+
+void KafkaMessageConsumer::applyBackpressure()
+{
+    const auto changes = mBackpressure->update();
+    if (!changes.pause.empty()) {
+        mConsumer->pause(changes.pause);
+    }
+    if (!changes.resume.empty()) {
+        mConsumer->resume(changes.resume);
+    }
+}
+
+void KafkaMessageConsumer::publishMetrics(ConsumerMetrics::Clock::time_point now)
+{
+    mLastMetricsPublish = now;
+
+    std::vector<ConsumerMetrics::PartitionLag> partitions;
+    const auto& assigned = mBackpressure->assigned();
+    if (!assigned.empty()) {
+        const auto committed = mOffsets->committed();
+        // Empty if the request failed, the lag is unknown until the next snapshot
+        const auto endOffsets = mConsumer->endOffsets(assigned);
+
+        // Nothing committed by this member yet for some partitions, ask the group coordinator
+        IMessageBus::TopicPartitions unknown;
+        for (const auto& topicPartition : assigned) {
+            if (committed.count(topicPartition) == 0) {
+                unknown.insert(topicPartition);
+            }
+        }
+        const auto groupCommitted = unknown.empty() ? IMessageBus::Offsets{} : mConsumer->committed(unknown);
+
+        partitions.reserve(assigned.size());
+        for (const auto& topicPartition : assigned) {
+            ConsumerMetrics::PartitionLag lag;
+            lag.topic = topicPartition.first;
+            lag.partition = topicPartition.second;
+            if (auto it = endOffsets.find(topicPartition); it != endOffsets.end()) {
+                lag.endOffset = it->second;
+            }
+            if (auto it = committed.find(topicPartition); it != committed.end()) {
+                lag.committed = it->second;
+            } else if (auto it = groupCommitted.find(topicPartition); it != groupCommitted.end()) {
+                lag.committed = it->second;
+            }
+            partitions.push_back(std::move(lag));
+        }
+    }
+
+    std::vector<std::size_t> queueDepths(mDispatcher->workerCount());
+    for (std::size_t worker = 0; worker < queueDepths.size(); ++worker) {
+        queueDepths[worker] = mDispatcher->queueDepth(worker);
+    }
+
+    mMetrics.publish(now, std::move(partitions), std::move(queueDepths),
+        mDedup != nullptr ? mDedup->stats() : ConsumerMetrics::DedupSnapshot{}, mRetries->stats(), mFanOut.stats());
+}
+
+void KafkaMessageConsumer::onRebalance(IMessageBus::RebalanceType type, const IMessageBus::TopicPartitions& partitions)
+{
+    if (type == IMessageBus::RebalanceType::eAssigned) {
+        mBackpressure->assigned(partitions);
+        return;
+    }
+
+    // Runs inside poll(), so nothing is being dispatched; hand the new owner a clean offset
+    mDispatcher->drain();
+    mFanOut.drain();
+    mRetries->forget(partitions);
+    commitHandled(true);
+    mOffsets->forget(partitions);
+    mBackpressure->revoked(partitions);
+}
@@ -9,70 +9,293 @@
 
 #include "KafkaMessageProducer.h"
 
-#include "KafkaConst.h"
+#include <string>
+
+#include "const/KafkaConst.h"
+#include "logger/LoggerStream.h"
 
 KafkaMessageProducer::KafkaMessageProducer()
 {
 }
 
+KafkaMessageProducer::KafkaMessageProducer(const ServiceConfig& config, std::shared_ptr<IMessageBus> bus)
+    : mConfig(config)
+    , mBus(std::move(bus))
+{
+}
+
 KafkaMessageProducer::~KafkaMessageProducer()
 {
 }
 
 bool KafkaMessageProducer::initialize()
 {
-    // TODO: implement the actual initialization logic with ServiceConfig and TopicConfig
-    // For now, we will use a hardcoded broker for demonstration purposes
-    if (kafka_const::kBrokers.empty()) {
-        return false; // No brokers configured
+    if (mBus == nullptr) {
+        LOG(logger::LogLevel::Error) << "Cannot initialize the producer without a message bus";
+        return false;
     }
 
-    auto broker = kafka_const::kBrokers.find("broker1");
-    if (broker == kafka_const::kBrokers.end()) {
-        return false; // Broker not found
+    if (!createProducer()) {
+        return false;
     }
+    mTransactional = !mConfig.getKafkaTransactionalId().empty();
 
-    const KAFKA_API::Properties properties({{"bootstrap.servers", broker->second}});
-    mProducer = std::make_unique<KAFKA_API::clients::producer::KafkaProducer>(properties);
-    if (!mProducer) {
-        return false; // Failed to create producer
-    }
+    mBudget = std::make_unique<InFlightBudget>(mConfig.getProducerMaxInFlightBytes(),
+        mConfig.getProducerMaxInFlightRecords());
+
+    ProducerBatchAccumulator::Options batching;
+    batching.batchSize = static_cast<std::size_t>(mConfig.getProducerBatchSize());
+    batching.linger = std::chrono::milliseconds(mConfig.getProducerLingerMs());
+    batching.partitionCount = mConfig.getTopicConfig().getPartitionCount();
+    mAccumulator = std::make_unique<ProducerBatchAccumulator>(batching,
+        [this](Batch&& batch) { sendBatch(std::move(batch)); });
 
     return true;
 }
 
 bool KafkaMessageProducer::sendMessage(const std::string& topic, const std::string& key, const std::string& message)
 {
+    if (mAccumulator == nullptr) {
+        LOG(logger::LogLevel::Error) << "Cannot send to " << topic << ", the producer is not initialized";
+        return false; // Producer is not initialized
+    }
+
+    // The caller keeps its string, so this is the only copy on the send path
+    return sendMessage(topic, key, mBufferPool.copyOf(message));
+}
+
+bool KafkaMessageProducer::sendMessage(const std::string& topic, const std::string& key, SharedPayload payload,
+    DeliveryCallback onDelivery)
+{
+    return send(topic, key, std::move(payload), std::move(onDelivery), {});
+}
+
+bool KafkaMessageProducer::sendEvent(const std::string& topic, const std::string& key, Event::EventType type,
+    const std::string& eventId, SharedPayload payload, DeliveryCallback onDelivery)
+{
+    ProducerBatchAccumulator::Headers headers;
+    headers.emplace_back(kafka_const::kEventTypeHeader, std::to_string(static_cast<std::uint16_t>(type)));
+    if (!eventId.empty()) {
+        headers.emplace_back(kafka_const::kEventIdHeader, eventId);
+    }
+    return send(topic, key, std::move(payload), std::move(onDelivery), std::move(headers));
+}
+
+bool KafkaMessageProducer::send(const std::string& topic, const std::string& key, SharedPayload payload,
+    DeliveryCallback onDelivery, ProducerBatchAccumulator::Headers headers)
+{
+    if (mAccumulator == nullptr) {
+        LOG(logger::LogLevel::Error) << "Cannot send to " << topic << ", the producer is not initialized";
+        return false; // Producer is not initialized
+    }
+
+    if (mTransactional && mTransactionOwner.load(std::memory_order_acquire) != std::this_thread::get_id()) {
+        return false; // A transactional producer only sends from the operation of runInTransaction
+    }
+
+    // Budget is held from here until the delivery report, or until the record is dropped
+    const std::size_t bytes = key.size() + payload.size();
+    if (!admit(topic, bytes)) {
+        return false;
+    }
+
+    if (!mAccumulator->append(topic, key, std::move(payload), std::move(onDelivery), std::move(headers))) {
+        mBudget->release(bytes);
+        return false;
+    }
+    return true;
+}
+
+PayloadBufferPtr KafkaMessageProducer::acquirePayloadBuffer(std::size_t capacity)
+{
+    return mBufferPool.acquire(capacity);
+}
+
+bool KafkaMessageProducer::flush()
+{
+    if (mProducer == nullptr || mAccumulator == nullptr) {
+        return false; // Producer is not initialized
+    }
+
+    mAccumulator->flush();
+    return mProducer->flush();
+}
+
+bool KafkaMessageProducer::isTransactional() const
+{
+    return mTransactional;
+}
+
+bool KafkaMessageProducer::runInTransaction(const std::function<bool()>& operation)
+{
+    if (!mTransactional || mProducer == nullptr || mAccumulator == nullptr) {
+        return false; // Transactions are not configured
+    }
+
+    // One transaction at a time, it spans every record this producer sends meanwhile
+    std::lock_guard<std::mutex> lock(mTransactionMutex);
+    if (!mProducer->beginTransaction()) {
+        return false;
+    }
+    mTransactionOwner.store(std::this_thread::get_id(), std::memory_order_release);
+
+    bool committed = false;
     try {
-        if (mProducer == nullptr) {
-            // TODO: add logging here
-            return false; // Producer is not initialized
+        if (operation()) {
+            // Every record of the operation must reach the bus before the commit
+            mAccumulator->flush();
+            committed = mProducer->commitTransaction();
         }
+    } catch(const std::exception& e) {
+        // A throwing operation aborts
+        LOG(logger::LogLevel::Error) << "Transaction failed, aborting it: " << e.what();
+    }
+    mTransactionOwner.store(std::thread::id(), std::memory_order_release);
 
-        // Create a producer record
-        // Note: Add id if we want to track the message later
-        KAFKA_API::clients::producer::ProducerRecord record(topic,
-             KAFKA_API::Key(key.c_str(), key.size()), KAFKA_API::Value(message.c_str(), message.size()));
-        // Note: Add id if we want to track the message later
-
-        // Callback function to handle delivery confirmation
-        auto deliveryCallback = [](const KAFKA_API::clients::producer::RecordMetadata& metadata,
-                                   const KAFKA_API::Error& error) {
-            if (error) {
-                // Handle the error (e.g., log it)
-            } else {
-                // Successfully sent the message
-                // You can log the metadata if needed
+    if (!committed) {
+        // Records still in the accumulator were never sent, the abort purges the rest; the
+        // accumulator only holds records of the operation, no other thread could append
+        failRecords(mAccumulator->discard());
+        if (!mProducer->abortTransaction()) {
+            // A new producer with the same transactional id fences this one and aborts its transaction
+            LOG(logger::LogLevel::Critical) << "Failed to abort a transaction, creating the producer again";
+            if (!createProducer()) {
+                LOG(logger::LogLevel::Critical) << "Failed to create the producer again, transactions will fail";
             }
-        };
+        }
+    }
 
-        // Send message, consider the options to copy the record value
-        // or not, read the KafkaProducer::SendOption
-        mProducer->send(record, deliveryCallback);
-    } catch(const KAFKA_API::KafkaException& e) {
-        // Handle Kafka exceptions (e.g., log the error)
-        return false;
+    return committed;
+}
+
+ProducerMetrics::Snapshot KafkaMessageProducer::metricsSnapshot() const
+{
+    auto snapshot = mMetrics.snapshot();
+    if (mAccumulator) {
+        snapshot.queuedRecords = mAccumulator->pendingRecords();
+    }
+    if (mBudget) {
+        snapshot.budget = mBudget->usage();
     }
+    return snapshot;
+}
 
+bool KafkaMessageProducer::createProducer()
+{
+    IMessageBus::ProducerOptions options;
+    options.clientId = mConfig.getKafkaClientId();
+    options.transactionalId = mConfig.getKafkaTransactionalId();
+    options.idempotent = mConfig.isIdempotenceEnabled();
+
+    mProducer = mBus->createProducer(options);
+    if (mProducer == nullptr) {
+        return false; // Failed to create producer, the bus logged why
+    }
+    // Fences older instances with the same transactional id and recovers their transactions
+    if (!options.transactionalId.empty() && !mProducer->initTransactions()) {
+        mProducer.reset();
+        return false;
+    }
     return true;
 }
+
+bool KafkaMessageProducer::admit(const std::string& topic, std::size_t bytes)
+{
+    if (mBudget->tryAcquire(bytes)) {
+        return true;
+    }
+
+    switch (mConfig.getProducerBackpressurePolicy()) {
+    case BackpressurePolicy::eBlock:
+        if (mBudget->acquire(bytes, std::chrono::milliseconds(mConfig.getProducerBlockTimeoutMs()))) {
+            return true;
+        }
+        break;
+    case BackpressurePolicy::eFailFast:
+        break;
+    case BackpressurePolicy::eDropLowestPriority: {
+        // Every queued record of a transactional producer belongs to the open transaction,
+        // dropping one would commit the transaction without it
+        if (mTransactional) {
+            break;
+        }
+        // Only records still queued here can be dropped, librdkafka owns the rest. Free whichever
+        // limit is exhausted, the bytes or the record count
+        const auto usage = mBudget->usage();
+        const std::size_t bytesUsed = usage.bytes + bytes;
+        const std::size_t recordsUsed = usage.records + 1;
+        const std::size_t bytesNeeded = bytesUsed > usage.maxBytes ? bytesUsed - usage.maxBytes : 0;
+        const std::size_t recordsNeeded = recordsUsed > usage.maxRecords ? recordsUsed - usage.maxRecords : 0;
+        auto dropped = mAccumulator->evictBelowPriority(
+            [this](const std::string& name) { return mConfig.getTopicPriority(name); },
+            mConfig.getTopicPriority(topic), bytesNeeded, recordsNeeded);
+        if (!dropped.empty()) {
+            mBudget->onDropped(dropped.size());
+            failRecords(std::move(dropped));
+            if (mBudget->tryAcquire(bytes)) {
+                return true;
+            }
+        }
+        break;
+    }
+    }
+
+    mBudget->onRejected();
+    return false;
+}
+
+void KafkaMessageProducer::failRecords(std::vector<ProducerBatchAccumulator::Record>&& records)
+{
+    for (auto& record : records) {
+        mBudget->release(record.key.size() + record.value.size());
+        if (record.onDelivery) {
+            record.onDelivery(false);
+        }
+    }
+}
+
+void KafkaMessageProducer::sendBatch(Batch&& batch)
+{
+    // One topic lookup per batch, the counters are updated lock-free afterwards
+    auto& counters = mMetrics.topic(batch.topic);
+    ProducerMetrics::onSent(counters, batch.records.size());
+    std::uint64_t refused = 0;
+
+    for (auto& entry : batch.records) {
+        const std::size_t bytes = entry.key.size() + entry.value.size();
+        IMessageBus::Record record;
+        record.topic = batch.topic;
+        record.partition = batch.partition; // kUnassignedPartition lets the bus pick it from the key
+        record.key = std::move(entry.key);
+        record.value = std::move(entry.value);
+        record.headers = std::move(entry.headers);
+
+        // The bus holds the record, and with it the payload, until the delivery callback
+        auto deliveryCallback = [this, bytes, &counters, enqueuedAt = entry.enqueuedAt, onDelivery = entry.onDelivery](
+                                    const IMessageBus::Record& delivered, bool ok) {
+            if (!ok) {
+                ProducerMetrics::onFailed(counters);
+            } else {
+                const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                    ProducerBatchAccumulator::Clock::now() - enqueuedAt);
+                ProducerMetrics::onAcked(counters, static_cast<std::uint64_t>(latency.count()), delivered.offset);
+            }
+            mBudget->release(bytes);
+            if (onDelivery) {
+                onDelivery(ok);
+            }
+        };
+
+        if (!mProducer->publish(std::move(record), std::move(deliveryCallback))) {
+            // The record never reached the client, so no delivery report will follow
+            ++refused;
+            mBudget->release(bytes);
+            if (entry.onDelivery) {
+                entry.onDelivery(false);
+            }
+        }
+    }
+    if (refused > 0) {
+        ProducerMetrics::onRefused(counters, refused);
+    }
+}
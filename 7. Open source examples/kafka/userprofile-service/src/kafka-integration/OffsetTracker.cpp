@@ -0,0 +1,138 @@
+/**
+ * @file OffsetTracker.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of OffsetTracker class
+ */
+
+#include "OffsetTracker.h"
+
+#include <algorithm>
+
+OffsetTracker::OffsetTracker(Options options)
+    : mOptions(options)
+    , mLastCommit(Clock::now())
+{
+    mOptions.commitEveryRecords = std::max<std::size_t>(mOptions.commitEveryRecords, 1);
+}
+
+void OffsetTracker::track(std::string_view topic, std::int32_t partition, std::int64_t offset)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    PartitionState& state = mPartitions[TopicPartition{topic, partition}];
+    if (offset < state.handled || (!state.inFlight.empty() && offset <= state.inFlight.back().offset)) {
+        return; // Redelivered after a seek, handled already or the original entry is still tracked
+    }
+    state.inFlight.push_back(Entry{offset, false});
+    ++mPendingRecords;
+}
+
+void OffsetTracker::complete(std::string_view topic, std::int32_t partition, std::int64_t offset)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mPartitions.find(TopicPartition{topic, partition});
+    if (it != mPartitions.end()) {
+        completeLocked(it->second, offset);
+    }
+}
+
+void OffsetTracker::complete(std::span<const Event> events)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    PartitionState* state = nullptr;
+    const Event* previous = nullptr;
+    for (const auto& event : events) {
+        // Poll batches hold runs of the same partition, only look the partition up when it changes
+        if (previous == nullptr || previous->getPartition() != event.getPartition()
+            || previous->getTopic() != event.getTopic()) {
+            auto it = mPartitions.find(TopicPartition{event.getTopic(), event.getPartition()});
+            state = it != mPartitions.end() ? &it->second : nullptr;
+        }
+        previous = &event;
+        if (state != nullptr) {
+            completeLocked(*state, event.getOffset());
+        }
+    }
+}
+
+bool OffsetTracker::commitDue(Clock::time_point now) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mCompletedSinceCommit == 0) {
+        return false;
+    }
+    return mCompletedSinceCommit >= mOptions.commitEveryRecords || now - mLastCommit >= mOptions.commitInterval;
+}
+
+OffsetTracker::Offsets OffsetTracker::takeCommittable(Clock::time_point now)
+{
+    Offsets offsets;
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& [topicPartition, state] : mPartitions) {
+        if (state.handled > state.committed) {
+            offsets.emplace(topicPartition, state.handled);
+            state.committed = state.handled;
+        }
+    }
+    mCompletedSinceCommit = 0;
+    mLastCommit = now;
+    return offsets;
+}
+
+OffsetTracker::Offsets OffsetTracker::committed() const
+{
+    Offsets offsets;
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto& [topicPartition, state] : mPartitions) {
+        if (state.committed >= 0) {
+            offsets.emplace(topicPartition, state.committed);
+        }
+    }
+    return offsets;
+}
+
+void OffsetTracker::forget(const TopicPartitions& partitions)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto& topicPartition : partitions) {
+        auto it = mPartitions.find(topicPartition);
+        if (it != mPartitions.end()) {
+            mPendingRecords -= it->second.inFlight.size();
+            mPartitions.erase(it);
+        }
+    }
+}
+
+std::size_t OffsetTracker::pendingRecords() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPendingRecords;
+}
+
+void OffsetTracker::completeLocked(PartitionState& state, std::int64_t offset)
+{
+    auto& inFlight = state.inFlight;
+    if (inFlight.empty()) {
+        return;
+    }
+
+    // Partition ordered dispatch completes the front entry, the search is for key ordered dispatch
+    auto it = inFlight.begin();
+    if (it->offset != offset) {
+        it = std::lower_bound(inFlight.begin(), inFlight.end(), offset,
+            [](const Entry& entry, std::int64_t value) { return entry.offset < value; });
+        if (it == inFlight.end() || it->offset != offset || it->done) {
+            return; // Not tracked, or completed twice
+        }
+    } else if (it->done) {
+        return;
+    }
+    it->done = true;
+    ++mCompletedSinceCommit;
+
+    while (!inFlight.empty() && inFlight.front().done) {
+        state.handled = inFlight.front().offset + 1;
+        inFlight.pop_front();
+        --mPendingRecords;
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ * @file PartitionBackpressure.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of PartitionBackpressure class
+ */
+
+#include "PartitionBackpressure.h"
+
+#include <algorithm>
+
+PartitionBackpressure::PartitionBackpressure(Options options, const PartitionDispatcher& dispatcher)
+    : mOptions(options)
+    , mDispatcher(dispatcher)
+    , mThrottled(dispatcher.workerCount(), false)
+{
+    mOptions.highWatermark = std::max<std::size_t>(mOptions.highWatermark, 1);
+    mOptions.lowWatermark = std::min(mOptions.lowWatermark, mOptions.highWatermark - 1);
+}
+
+void PartitionBackpressure::assigned(const TopicPartitions& partitions)
+{
+    mAssigned.insert(partitions.begin(), partitions.end());
+}
+
+void PartitionBackpressure::revoked(const TopicPartitions& partitions)
+{
+    for (const auto& partition : partitions) {
+        mAssigned.erase(partition);
+        mPaused.erase(partition);
+    }
+}
+
+PartitionBackpressure::Changes PartitionBackpressure::update()
+{
+    bool anyThrottled = false;
+    for (std::size_t worker = 0; worker < mThrottled.size(); ++worker) {
+        const std::size_t depth = mDispatcher.queueDepth(worker);
+        if (!mThrottled[worker] && depth >= mOptions.highWatermark) {
+            mThrottled[worker] = true;
+            ++mThrottleCount;
+        } else if (mThrottled[worker] && depth <= mOptions.lowWatermark) {
+            mThrottled[worker] = false;
+        }
+        anyThrottled = anyThrottled || mThrottled[worker];
+    }
+
+    const bool keyOrdered = mDispatcher.ordering() == PartitionDispatcher::Ordering::eKey;
+    Changes changes;
+    for (const auto& partition : mAssigned) {
+        const bool pause = keyOrdered ? anyThrottled : mThrottled[mDispatcher.workerFor(partition.first, partition.second)];
+        const bool paused = mPaused.count(partition) != 0;
+        if (pause && !paused) {
+            changes.pause.insert(partition);
+            mPaused.insert(partition);
+        } else if (!pause && paused) {
+            changes.resume.insert(partition);
+            mPaused.erase(partition);
+        }
+    }
+    return changes;
+}
+
+const PartitionBackpressure::TopicPartitions& PartitionBackpressure::assigned() const
+{
+    return mAssigned;
+}
+
+const PartitionBackpressure::TopicPartitions& PartitionBackpressure::paused() const
+{
+    return mPaused;
+}
+
+std::size_t PartitionBackpressure::throttleCount() const
+{
+    return mThrottleCount;
+}
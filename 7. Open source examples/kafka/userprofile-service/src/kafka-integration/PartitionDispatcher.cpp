@@ -0,0 +1,156 @@
+/**
+ * @file PartitionDispatcher.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of PartitionDispatcher class
+ */
+
+#include "PartitionDispatcher.h"
+
+#include "ShardRouter.h"
+
+#include <algorithm>
+#include <iterator>
+
+PartitionDispatcher::PartitionDispatcher(Options options, Processor processor)
+    : mOptions(options)
+    , mProcessor(std::move(processor))
+{
+    mOptions.workers = std::max<std::size_t>(mOptions.workers, 1);
+    mOptions.queueCapacity = std::max<std::size_t>(mOptions.queueCapacity, 1);
+    mOptions.maxBatch = std::max<std::size_t>(mOptions.maxBatch, 1);
+
+    mWorkers.reserve(mOptions.workers);
+    for (std::size_t index = 0; index < mOptions.workers; ++index) {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t index = 0; index < mOptions.workers; ++index) {
+        Worker& worker = *mWorkers[index];
+        worker.thread = std::thread(&PartitionDispatcher::workerLoop, this, std::ref(worker), index);
+    }
+}
+
+PartitionDispatcher::~PartitionDispatcher()
+{
+    stop();
+}
+
+bool PartitionDispatcher::dispatch(std::vector<Event>&& events)
+{
+    std::vector<std::vector<Event>> perWorker(mWorkers.size());
+    for (auto& event : events) {
+        perWorker[workerFor(event)].push_back(std::move(event));
+    }
+    events.clear();
+
+    bool accepted = true;
+    for (std::size_t index = 0; index < perWorker.size(); ++index) {
+        auto& batch = perWorker[index];
+        Worker& worker = *mWorkers[index];
+        auto next = batch.begin();
+
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        while (next != batch.end()) {
+            worker.space.wait(lock, [this, &worker] {
+                return worker.stopping || worker.queue.size() < mOptions.queueCapacity;
+            });
+            if (worker.stopping) {
+                accepted = false;
+                break;
+            }
+
+            // Fill up to the capacity, the rest waits for the worker to take a batch
+            const auto room = static_cast<std::ptrdiff_t>(mOptions.queueCapacity - worker.queue.size());
+            const auto last = std::next(next, std::min(room, std::distance(next, batch.end())));
+            std::move(next, last, std::back_inserter(worker.queue));
+            next = last;
+            worker.work.notify_one();
+        }
+    }
+    return accepted;
+}
+
+void PartitionDispatcher::drain()
+{
+    for (auto& worker : mWorkers) {
+        std::unique_lock<std::mutex> lock(worker->mutex);
+        worker->space.wait(lock, [&worker] { return worker->queue.empty() && !worker->busy; });
+    }
+}
+
+void PartitionDispatcher::stop()
+{
+    for (auto& worker : mWorkers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->stopping = true;
+        }
+        worker->work.notify_one();
+        worker->space.notify_all();
+    }
+    for (auto& worker : mWorkers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+std::size_t PartitionDispatcher::workerFor(const Event& event) const
+{
+    if (mOptions.ordering == Ordering::eKey && !event.getKey().empty()) {
+        return ShardRouter::hashKey(event.getKey()) % static_cast<std::uint32_t>(mWorkers.size());
+    }
+    return workerFor(event.getTopic(), event.getPartition());
+}
+
+std::size_t PartitionDispatcher::workerFor(std::string_view topic, std::int32_t partition) const
+{
+    // Consecutive partitions of a topic land on consecutive workers
+    const auto index = static_cast<std::uint32_t>(std::max(partition, 0));
+    return (ShardRouter::hashKey(topic) + index) % static_cast<std::uint32_t>(mWorkers.size());
+}
+
+PartitionDispatcher::Ordering PartitionDispatcher::ordering() const
+{
+    return mOptions.ordering;
+}
+
+std::size_t PartitionDispatcher::queueDepth(std::size_t worker) const
+{
+    std::lock_guard<std::mutex> lock(mWorkers[worker]->mutex);
+    return mWorkers[worker]->queue.size();
+}
+
+std::size_t PartitionDispatcher::workerCount() const
+{
+    return mWorkers.size();
+}
+
+void PartitionDispatcher::workerLoop(Worker& worker, std::size_t index)
+{
+    std::vector<Event> batch;
+    batch.reserve(mOptions.maxBatch);
+
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    while (true) {
+        worker.work.wait(lock, [&worker] { return worker.stopping || !worker.queue.empty(); });
+        if (worker.queue.empty()) {
+            break; // Stopping and everything queued has been handled
+        }
+
+        const auto count = std::min(worker.queue.size(), mOptions.maxBatch);
+        const auto last = std::next(worker.queue.begin(), static_cast<std::ptrdiff_t>(count));
+        std::move(worker.queue.begin(), last, std::back_inserter(batch));
+        worker.queue.erase(worker.queue.begin(), last);
+        worker.busy = true;
+        lock.unlock();
+        worker.space.notify_all();
+
+        mProcessor(index, batch);
+        batch.clear();
+
+        lock.lock();
+        worker.busy = false;
+        worker.space.notify_all();
+    }
+}
@@ -0,0 +1,258 @@
+/**
+ * @file ProducerBatchAccumulator.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of ProducerBatchAccumulator class
+ */
+
+#include "ProducerBatchAccumulator.h"
+
+#include "ShardRouter.h"
+
+#include <algorithm>
+#include <iterator>
+
+ProducerBatchAccumulator::ProducerBatchAccumulator(Options options, BatchSink sink)
+    : mOptions(options)
+    , mSink(std::move(sink))
+{
+    mOptions.batchSize = std::max<std::size_t>(mOptions.batchSize, 1);
+    mSender = std::thread(&ProducerBatchAccumulator::senderLoop, this);
+}
+
+ProducerBatchAccumulator::~ProducerBatchAccumulator()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mSenderCv.notify_one();
+    if (mSender.joinable()) {
+        mSender.join();
+    }
+}
+
+bool ProducerBatchAccumulator::append(const std::string& topic, const std::string& key, SharedPayload value,
+    DeliveryCallback onDelivery, Headers headers)
+{
+    const int partition = partitionFor(key, mOptions.partitionCount);
+    const auto now = Clock::now();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (mStopping) {
+        return false;
+    }
+
+    auto [it, created] = mOpenBatches.try_emplace(BatchKey{topic, partition});
+    Batch& batch = it->second;
+    if (created) {
+        batch.topic = topic;
+        batch.partition = partition;
+        batch.createdAt = now;
+        batch.records.reserve(mOptions.batchSize);
+    }
+
+    batch.records.push_back(Record{key, std::move(value), now, std::move(onDelivery), std::move(headers)});
+    ++mPendingRecords;
+
+    if (batch.records.size() >= mOptions.batchSize) {
+        closeBatch(it);
+        lock.unlock();
+        mSenderCv.notify_one();
+    } else if (created && mOpenBatches.size() == 1) {
+        // The sender has no linger deadline to wait for yet
+        lock.unlock();
+        mSenderCv.notify_one();
+    }
+
+    return true;
+}
+
+void ProducerBatchAccumulator::flush()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    closeExpiredBatches(Clock::now(), true);
+    const std::uint64_t target = mEnqueuedBatches;
+    mSenderCv.notify_one();
+    mDrainedCv.wait(lock, [this, target] { return mSentBatches >= target; });
+}
+
+std::vector<ProducerBatchAccumulator::Record> ProducerBatchAccumulator::discard()
+{
+    std::vector<Batch> dropped;
+    std::vector<Record> records;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    for (auto& [key, batch] : mOpenBatches) {
+        dropped.push_back(std::move(batch));
+    }
+
+    // Dropped ready batches count as handled so flush() waiters are not left behind
+    mSentBatches += mReadyBatches.size();
+    std::move(mReadyBatches.begin(), mReadyBatches.end(), std::back_inserter(dropped));
+    mOpenBatches.clear();
+    mReadyBatches.clear();
+    mPendingRecords -= takeRecords(dropped, records);
+    mDrainedCv.notify_all();
+
+    mDrainedCv.wait(lock, [this] { return mSentBatches >= mEnqueuedBatches; });
+    return records;
+}
+
+std::vector<ProducerBatchAccumulator::Record> ProducerBatchAccumulator::evictBelowPriority(
+    const std::function<int(const std::string&)>& priorityOf, int priority, std::size_t bytesNeeded, std::size_t recordsNeeded)
+{
+    struct Candidate
+    {
+        int priority;
+        bool ready;
+        std::size_t index; // into mReadyBatches, or the position in mOpenBatches
+    };
+
+    std::vector<Batch> dropped;
+    std::vector<Record> records;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::vector<Candidate> candidates;
+    std::size_t position = 0;
+    for (const auto& [key, batch] : mOpenBatches) {
+        const int topicPriority = priorityOf(batch.topic);
+        if (topicPriority < priority) {
+            candidates.push_back(Candidate{topicPriority, false, position});
+        }
+        ++position;
+    }
+    for (std::size_t index = 0; index < mReadyBatches.size(); ++index) {
+        const int topicPriority = priorityOf(mReadyBatches[index].topic);
+        if (topicPriority < priority) {
+            candidates.push_back(Candidate{topicPriority, true, index});
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [](const Candidate& lhs, const Candidate& rhs) { return lhs.priority < rhs.priority; });
+
+    // Pick whole batches, lowest priority first
+    std::vector<bool> dropOpen(mOpenBatches.size(), false);
+    std::vector<bool> dropReady(mReadyBatches.size(), false);
+    std::size_t freed = 0;
+    std::size_t freedRecords = 0;
+    auto openAt = [this](std::size_t index) { return std::next(mOpenBatches.begin(), static_cast<long>(index)); };
+    for (const auto& candidate : candidates) {
+        if (freed >= bytesNeeded && freedRecords >= recordsNeeded) {
+            break;
+        }
+        const Batch& batch = candidate.ready ? mReadyBatches[candidate.index] : openAt(candidate.index)->second;
+        for (const auto& record : batch.records) {
+            freed += record.key.size() + record.value.size();
+        }
+        freedRecords += batch.records.size();
+        (candidate.ready ? dropReady : dropOpen)[candidate.index] = true;
+    }
+
+    position = 0;
+    for (auto it = mOpenBatches.begin(); it != mOpenBatches.end(); ++position) {
+        if (dropOpen[position]) {
+            dropped.push_back(std::move(it->second));
+            it = mOpenBatches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::deque<Batch> kept;
+    for (std::size_t index = 0; index < mReadyBatches.size(); ++index) {
+        if (dropReady[index]) {
+            dropped.push_back(std::move(mReadyBatches[index]));
+            ++mSentBatches; // Counts as handled, like discard()
+        } else {
+            kept.push_back(std::move(mReadyBatches[index]));
+        }
+    }
+    mReadyBatches.swap(kept);
+
+    mPendingRecords -= takeRecords(dropped, records);
+    mDrainedCv.notify_all();
+    return records;
+}
+
+std::size_t ProducerBatchAccumulator::pendingRecords() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPendingRecords;
+}
+
+int ProducerBatchAccumulator::partitionFor(std::string_view key, int partitionCount)
+{
+    if (partitionCount <= 1) {
+        return kUnassignedPartition;
+    }
+
+    // Same stable hash as the producer pool. Only when the partition count is a multiple of the
+    // shard count does a shard fill the batches of its own partitions alone; otherwise shards share
+    // partitions and send smaller batches, a key still always goes through one shard
+    return static_cast<int>(ShardRouter::hashKey(key) % static_cast<std::uint32_t>(partitionCount));
+}
+
+void ProducerBatchAccumulator::senderLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        closeExpiredBatches(Clock::now(), mStopping);
+
+        if (!mReadyBatches.empty()) {
+            Batch batch = std::move(mReadyBatches.front());
+            mReadyBatches.pop_front();
+            const std::size_t count = batch.records.size();
+
+            lock.unlock();
+            mSink(std::move(batch));
+            lock.lock();
+
+            mPendingRecords -= count;
+            ++mSentBatches;
+            mDrainedCv.notify_all();
+            continue;
+        }
+
+        if (mStopping) {
+            break;
+        }
+
+        if (mOpenBatches.empty()) {
+            mSenderCv.wait(lock);
+        } else {
+            auto oldest = mOpenBatches.begin()->second.createdAt;
+            for (const auto& [key, batch] : mOpenBatches) {
+                oldest = std::min(oldest, batch.createdAt);
+            }
+            mSenderCv.wait_until(lock, oldest + mOptions.linger);
+        }
+    }
+}
+
+void ProducerBatchAccumulator::closeBatch(std::map<BatchKey, Batch>::iterator it)
+{
+    mReadyBatches.push_back(std::move(it->second));
+    mOpenBatches.erase(it);
+    ++mEnqueuedBatches;
+}
+
+std::size_t ProducerBatchAccumulator::takeRecords(std::vector<Batch>& batches, std::vector<Record>& records)
+{
+    std::size_t count = 0;
+    for (auto& batch : batches) {
+        count += batch.records.size();
+        std::move(batch.records.begin(), batch.records.end(), std::back_inserter(records));
+    }
+    return count;
+}
+
+void ProducerBatchAccumulator::closeExpiredBatches(Clock::time_point now, bool all)
+{
+    for (auto it = mOpenBatches.begin(); it != mOpenBatches.end();) {
+        auto current = it++;
+        if (all || now - current->second.createdAt >= mOptions.linger) {
+            closeBatch(current);
+        }
+    }
+}
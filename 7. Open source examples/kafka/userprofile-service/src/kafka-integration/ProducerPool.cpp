@@ -0,0 +1,101 @@
+/**
+ * @file ProducerPool.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of ProducerPool class
+ */
+
+#include "ProducerPool.h"
+
+#include <algorithm>
+
+#include "logger/LoggerStream.h"
+
+ProducerPool::ProducerPool(const ServiceConfig& config, std::shared_ptr<IMessageBus> bus)
+    : mRouter(static_cast<std::size_t>(config.getProducerShards()))
+    , mTransactional(!config.getKafkaTransactionalId().empty())
+{
+    const std::size_t shards = mRouter.shardCount();
+    mShards.reserve(shards);
+    for (std::size_t index = 0; index < shards; ++index) {
+        ServiceConfig shardConfig = config;
+        const std::string suffix = "-" + std::to_string(index);
+
+        // Client ids must be unique per Kafka client
+        if (!config.getKafkaClientId().empty()) {
+            shardConfig.setKafkaClientId(config.getKafkaClientId() + suffix);
+        }
+
+        // The pool as a whole keeps the configured memory bound
+        shardConfig.setProducerInFlightBudget(
+            std::max<std::size_t>(config.getProducerMaxInFlightBytes() / shards, 1),
+            std::max<std::size_t>(config.getProducerMaxInFlightRecords() / shards, 1));
+
+        mShards.push_back(std::make_unique<KafkaMessageProducer>(shardConfig, bus));
+    }
+}
+
+ProducerPool::~ProducerPool()
+{
+}
+
+bool ProducerPool::initialize()
+{
+    if (mTransactional) {
+        // A transaction cannot span shards, and a transactional shard refuses every send outside one
+        LOG(logger::LogLevel::Error) << "A producer pool cannot be transactional, use a single KafkaMessageProducer";
+        return false;
+    }
+
+    bool initialized = true;
+    for (auto& shard : mShards) {
+        initialized = shard->initialize() && initialized;
+    }
+    return initialized;
+}
+
+bool ProducerPool::sendMessage(const std::string& topic, const std::string& key, const std::string& message)
+{
+    return shardFor(key).sendMessage(topic, key, message);
+}
+
+bool ProducerPool::sendMessage(const std::string& topic, const std::string& key, SharedPayload payload,
+    DeliveryCallback onDelivery)
+{
+    return shardFor(key).sendMessage(topic, key, std::move(payload), std::move(onDelivery));
+}
+
+bool ProducerPool::sendEvent(const std::string& topic, const std::string& key, Event::EventType type,
+    const std::string& eventId, SharedPayload payload, DeliveryCallback onDelivery)
+{
+    return shardFor(key).sendEvent(topic, key, type, eventId, std::move(payload), std::move(onDelivery));
+}
+
+KafkaMessageProducer& ProducerPool::shardFor(std::string_view key)
+{
+    return *mShards[mRouter.shardFor(key)];
+}
+
+bool ProducerPool::flush()
+{
+    bool flushed = true;
+    for (auto& shard : mShards) {
+        flushed = shard->flush() && flushed;
+    }
+    return flushed;
+}
+
+std::vector<ProducerMetrics::Snapshot> ProducerPool::metricsSnapshot() const
+{
+    std::vector<ProducerMetrics::Snapshot> snapshots;
+    snapshots.reserve(mShards.size());
+    for (const auto& shard : mShards) {
+        snapshots.push_back(shard->metricsSnapshot());
+    }
+    return snapshots;
+}
+
+std::size_t ProducerPool::shardCount() const
+{
+    return mShards.size();
+}
@@ -0,0 +1,115 @@
+/**
+ * @file ReplayDecoder.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of ReplayDecoder class
+ */
+
+#include "ReplayDecoder.h"
+
+#include "UserEventView.h"
+
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <unordered_map>
+
+namespace
+{
+    // Below this many events per thread the thread start costs more than the parsing
+    constexpr std::size_t kMinEventsPerThread = 256;
+}
+
+ReplayDecoder::ReplayDecoder(std::size_t threads)
+    : mThreads(std::max<std::size_t>(threads, 1))
+{
+}
+
+void ReplayDecoder::add(Event&& event)
+{
+    mEvents.push_back(std::move(event));
+}
+
+std::size_t ReplayDecoder::buffered() const
+{
+    return mEvents.size();
+}
+
+ReplayDecoder::Batch ReplayDecoder::decode()
+{
+    Batch batch;
+    batch.records = mEvents.size();
+    if (mEvents.empty()) {
+        return batch;
+    }
+
+    mDecoded.assign(mEvents.size(), Decoded{});
+    const std::size_t threads = std::clamp<std::size_t>(mEvents.size() / kMinEventsPerThread, 1, mThreads);
+    const std::size_t chunk = (mEvents.size() + threads - 1) / threads;
+
+    // The calling thread takes the first chunk
+    std::vector<std::future<void>> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t begin = chunk; begin < mEvents.size(); begin += chunk) {
+        const std::size_t end = std::min(begin + chunk, mEvents.size());
+        workers.push_back(std::async(std::launch::async, &ReplayDecoder::decodeRange,
+            mEvents.data() + begin, mEvents.data() + end, mDecoded.data() + begin));
+    }
+    decodeRange(mEvents.data(), mEvents.data() + std::min(chunk, mEvents.size()), mDecoded.data());
+    for (auto& worker : workers) {
+        worker.get();
+    }
+
+    // Fold in record order, a later event of a user replaces an earlier one
+    std::unordered_map<std::string, std::optional<User>> users; // nullopt means deleted
+    users.reserve(mDecoded.size());
+    for (auto& decoded : mDecoded) {
+        const std::string userId = decoded.user.getUserId();
+        if (userId.empty()) {
+            ++batch.skipped;
+            continue;
+        }
+        if (decoded.type == Event::EventType::eUserDeleted) {
+            users[userId].reset();
+        } else {
+            users[userId] = std::move(decoded.user);
+        }
+    }
+
+    for (auto& [userId, user] : users) {
+        if (user.has_value()) {
+            batch.upserts.push_back(std::move(*user));
+        } else {
+            batch.removedIds.push_back(userId);
+        }
+    }
+
+    mEvents.clear();
+    return batch;
+}
+
+void ReplayDecoder::decodeRange(const Event* begin, const Event* end, Decoded* out)
+{
+    for (const Event* event = begin; event != end; ++event, ++out) {
+        switch (event->getType()) {
+        case Event::EventType::eUserCreated:
+        case Event::EventType::eUserUpdated:
+        case Event::EventType::eUserDeleted:
+            out->type = event->getType();
+            {
+                // A deletion only needs the user ID, the other fields are never decoded for it
+                UserEventView view(event->getPayload());
+                User user = out->type == Event::EventType::eUserDeleted
+                    ? User(std::string(view.getUserId()), "", "", "", "")
+                    : view.toUser();
+                // A malformed payload is left without an id and skipped, as User::fromJson did
+                if (view.isValid()) {
+                    out->user = std::move(user);
+                }
+            }
+            break;
+        default:
+            break; // Not a user event, left without an id and skipped
+        }
+    }
+}
@@ -0,0 +1,328 @@
+/**
+ * @file RetryScheduler.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of RetryScheduler class
+ */
+
+#include "RetryScheduler.h"
+
+#include <algorithm>
+
+#include "logger/LoggerStream.h"
+
+RetryScheduler::RetryScheduler(Options options, DeadLetter deadLetter, Completion completion, Attempt attempt)
+    : mOptions(options)
+    , mDeadLetter(std::move(deadLetter))
+    , mCompletion(std::move(completion))
+    , mAttempt(std::move(attempt))
+{
+    if (!mAttempt) {
+        mAttempt = [](const std::shared_ptr<Handler>& handler, const Event& event) {
+            return handler->handleEvent(event);
+        };
+    }
+    mOptions.maxAttempts = std::max<std::size_t>(mOptions.maxAttempts, 1);
+    mOptions.tick = std::max(mOptions.tick, std::chrono::milliseconds(1));
+    mOptions.maxBackoff = std::max(mOptions.maxBackoff, mOptions.initialBackoff);
+    mSlots.resize(std::max<std::size_t>(mOptions.slots, 2));
+    mNextTick = Clock::now() + mOptions.tick;
+    mTimer = std::thread(&RetryScheduler::timerLoop, this);
+}
+
+RetryScheduler::~RetryScheduler()
+{
+    stop();
+}
+
+bool RetryScheduler::schedule(Event event, Handlers failed)
+{
+    // A pending retry must not pin the whole poll batch its payload and fields point into
+    event.ownPayload();
+    Entry entry{std::move(event), std::move(failed)};
+    entry.bytes = entryBytes(entry);
+
+    if (mOptions.maxAttempts > 1) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mStopping) {
+            return false; // Not completed, consumed again after a restart
+        }
+        if (mPendingEvents < mOptions.maxPendingEvents && mPendingBytes + entry.bytes <= mOptions.maxPendingBytes) {
+            if (mPendingEvents == 0) {
+                mNextTick = Clock::now() + mOptions.tick; // The wheel idled, restart it from now
+            }
+            ++mPendingEvents;
+            mPendingBytes += entry.bytes;
+            trackLocked(entry);
+            insertLocked(std::move(entry), backoff(1));
+            mScheduled.fetch_add(1, std::memory_order_relaxed);
+            mCv.notify_one();
+            return true;
+        }
+        mRejected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (!deadLetter(entry)) {
+        // Fails closed: the offset stays held, the event is consumed again after a rebalance or restart
+        LOG(logger::LogLevel::Error) << "Retry queue full, holding the offset of " << entry.event.getTopic() << "/"
+                                     << entry.event.getPartition() << "@" << entry.event.getOffset();
+    }
+    return false;
+}
+
+void RetryScheduler::supersede(const Event& event, const Handlers& handlers, const Handlers& failed)
+{
+    if (!hasPendingKeys() || event.getKey().empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    const auto it = mKeys.find(std::string(event.getKey()));
+    if (it == mKeys.end()) {
+        return;
+    }
+    auto& handled = it->second.handled;
+    for (const auto& handler : handlers) {
+        if (std::find(failed.begin(), failed.end(), handler) != failed.end()) {
+            continue;
+        }
+        const auto known = std::find_if(handled.begin(), handled.end(), [&](const Handled& entry) {
+            return entry.handler == handler.get() && entry.partition == event.getPartition()
+                && entry.topic == event.getTopic();
+        });
+        if (known == handled.end()) {
+            handled.push_back(Handled{handler.get(), std::string(event.getTopic()), event.getPartition(),
+                event.getOffset()});
+        } else {
+            known->offset = std::max(known->offset, event.getOffset());
+        }
+    }
+}
+
+bool RetryScheduler::hasPendingKeys() const
+{
+    return mPendingKeys.load(std::memory_order_acquire) > 0;
+}
+
+void RetryScheduler::forget(const OffsetTracker::TopicPartitions& partitions)
+{
+    std::lock_guard<std::mutex> run(mRunMutex);
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& slot : mSlots) {
+        auto dropped = std::remove_if(slot.begin(), slot.end(), [&](const Entry& entry) {
+            return partitions.count(OffsetTracker::TopicPartition{entry.event.getTopic(), entry.event.getPartition()}) != 0;
+        });
+        for (auto it = dropped; it != slot.end(); ++it) {
+            --mPendingEvents;
+            mPendingBytes -= it->bytes;
+            untrackLocked(*it);
+        }
+        slot.erase(dropped, slot.end());
+    }
+}
+
+void RetryScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mCv.notify_one();
+    if (mTimer.joinable()) {
+        mTimer.join();
+    }
+}
+
+RetryScheduler::Snapshot RetryScheduler::stats() const
+{
+    Snapshot snapshot;
+    snapshot.scheduled = mScheduled.load(std::memory_order_relaxed);
+    snapshot.retries = mRetries.load(std::memory_order_relaxed);
+    snapshot.recovered = mRecovered.load(std::memory_order_relaxed);
+    snapshot.deadLettered = mDeadLettered.load(std::memory_order_relaxed);
+    snapshot.rejected = mRejected.load(std::memory_order_relaxed);
+    snapshot.superseded = mSuperseded.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    snapshot.pendingEvents = mPendingEvents;
+    snapshot.pendingBytes = mPendingBytes;
+    return snapshot;
+}
+
+std::size_t RetryScheduler::entryBytes(const Entry& entry)
+{
+    const Event& event = entry.event;
+    return sizeof(Entry) + event.getTopic().size() + event.getKey().size() + event.getId().size()
+        + event.getPayload().size() + entry.handlers.capacity() * sizeof(Handlers::value_type);
+}
+
+std::chrono::milliseconds RetryScheduler::backoff(std::size_t attempts) const
+{
+    if (attempts >= mOptions.maxAttempts) {
+        return mOptions.maxBackoff; // Only the dead-letter sink is retried
+    }
+    const std::size_t doublings = std::min<std::size_t>(attempts - 1, 30);
+    const auto delay = mOptions.initialBackoff * (std::int64_t{1} << doublings);
+    return std::min(delay, mOptions.maxBackoff);
+}
+
+void RetryScheduler::insertLocked(Entry&& entry, std::chrono::milliseconds delay)
+{
+    const std::size_t ticks = std::max<std::size_t>(
+        static_cast<std::size_t>((delay + mOptions.tick - std::chrono::milliseconds(1)) / mOptions.tick), 1);
+    entry.rounds = (ticks - 1) / mSlots.size();
+    mSlots[(mCursor + ticks) % mSlots.size()].push_back(std::move(entry));
+}
+
+void RetryScheduler::retry(Entry& entry)
+{
+    bool superseded = false;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        superseded = dropSupersededLocked(entry);
+    }
+    if (superseded) {
+        // Every handler already handled a later event of the key, the older one is not applied again
+        mSuperseded.fetch_add(1, std::memory_order_relaxed);
+        mCompletion(entry.event);
+        return;
+    }
+
+    if (entry.attempts < mOptions.maxAttempts) {
+        mRetries.fetch_add(1, std::memory_order_relaxed);
+        Handlers failing;
+        for (const auto& handler : entry.handlers) {
+            if (!mAttempt(handler, entry.event)) {
+                failing.push_back(handler);
+            }
+        }
+        entry.handlers = std::move(failing);
+        ++entry.attempts;
+
+        if (entry.handlers.empty()) {
+            mRecovered.fetch_add(1, std::memory_order_relaxed);
+            mCompletion(entry.event);
+            return;
+        }
+        if (entry.attempts < mOptions.maxAttempts) {
+            return;
+        }
+    }
+
+    if (deadLetter(entry)) {
+        entry.handlers.clear();
+    }
+}
+
+bool RetryScheduler::deadLetter(const Entry& entry)
+{
+    if (!mDeadLetter || !mDeadLetter(entry.event, entry.attempts)) {
+        LOG(logger::LogLevel::Warning) << "The dead-letter sink refused " << entry.event.getTopic() << "/"
+                                       << entry.event.getPartition() << "@" << entry.event.getOffset()
+                                       << ", its offset stays held";
+        return false;
+    }
+    mDeadLettered.fetch_add(1, std::memory_order_relaxed);
+    mCompletion(entry.event);
+    return true;
+}
+
+void RetryScheduler::trackLocked(const Entry& entry)
+{
+    if (entry.event.getKey().empty()) {
+        return;
+    }
+    ++mKeys[std::string(entry.event.getKey())].pending;
+    mPendingKeys.store(mKeys.size(), std::memory_order_release);
+}
+
+void RetryScheduler::untrackLocked(const Entry& entry)
+{
+    const auto it = entry.event.getKey().empty() ? mKeys.end() : mKeys.find(std::string(entry.event.getKey()));
+    if (it == mKeys.end()) {
+        return;
+    }
+    if (--it->second.pending == 0) {
+        mKeys.erase(it); // What superseded the key only matters while an event of it is pending
+        mPendingKeys.store(mKeys.size(), std::memory_order_release);
+    }
+}
+
+bool RetryScheduler::dropSupersededLocked(Entry& entry)
+{
+    const Event& event = entry.event;
+    const auto it = event.getKey().empty() ? mKeys.end() : mKeys.find(std::string(event.getKey()));
+    if (it == mKeys.end()) {
+        return false;
+    }
+    const auto& handled = it->second.handled;
+    std::erase_if(entry.handlers, [&](const std::shared_ptr<Handler>& handler) {
+        return std::any_of(handled.begin(), handled.end(), [&](const Handled& later) {
+            return later.handler == handler.get() && later.partition == event.getPartition()
+                && later.offset > event.getOffset() && later.topic == event.getTopic();
+        });
+    });
+    return entry.handlers.empty();
+}
+
+void RetryScheduler::timerLoop()
+{
+    std::vector<Entry> due;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            if (mPendingEvents == 0) {
+                mCv.wait(lock, [this] { return mStopping || mPendingEvents > 0; });
+            } else {
+                mCv.wait_until(lock, mNextTick, [this] { return mStopping; });
+            }
+            if (mStopping) {
+                return;
+            }
+            if (Clock::now() < mNextTick) {
+                continue; // Woken by schedule()
+            }
+        }
+
+        // forget() must not run while due entries are outside the wheel
+        std::lock_guard<std::mutex> run(mRunMutex);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            const auto now = Clock::now();
+            while (mNextTick <= now) {
+                mCursor = (mCursor + 1) % mSlots.size();
+                auto& slot = mSlots[mCursor];
+                for (std::size_t i = 0; i < slot.size();) {
+                    if (slot[i].rounds > 0) {
+                        --slot[i].rounds;
+                        ++i;
+                        continue;
+                    }
+                    due.push_back(std::move(slot[i]));
+                    if (i + 1 != slot.size()) {
+                        slot[i] = std::move(slot.back());
+                    }
+                    slot.pop_back();
+                }
+                mNextTick += mOptions.tick;
+            }
+        }
+
+        // Handlers run without the lock, so the handler threads can keep scheduling
+        for (auto& entry : due) {
+            retry(entry);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& entry : due) {
+            if (entry.handlers.empty()) {
+                --mPendingEvents;
+                mPendingBytes -= entry.bytes;
+                untrackLocked(entry);
+            } else {
+                insertLocked(std::move(entry), backoff(entry.attempts));
+            }
+        }
+        due.clear();
+    }
+}
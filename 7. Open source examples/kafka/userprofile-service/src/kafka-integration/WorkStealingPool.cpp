@@ -0,0 +1,109 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of WorkStealingPool class
+ */
+
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Pool and queue of the calling thread, set on the pool threads only
+    thread_local const WorkStealingPool* tCurrentPool = nullptr;
+    thread_local std::size_t tCurrentQueue = 0;
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+{
+    threads = std::max<std::size_t>(threads, 1);
+    mQueues.reserve(threads);
+    for (std::size_t index = 0; index < threads; ++index) {
+        mQueues.push_back(std::make_unique<Queue>());
+    }
+    mThreads.reserve(threads);
+    for (std::size_t index = 0; index < threads; ++index) {
+        mThreads.emplace_back(&WorkStealingPool::workerLoop, this, index);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStopping = true;
+    }
+    mWake.notify_all();
+    for (auto& thread : mThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    const std::size_t index = tCurrentPool == this
+        ? tCurrentQueue
+        : mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+    {
+        std::lock_guard<std::mutex> lock(mQueues[index]->mutex);
+        mQueues[index]->tasks.push_back(std::move(task));
+    }
+
+    // Counted before the sleep mutex is taken, so a thread about to sleep sees the task
+    mPending.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+    }
+    mWake.notify_one();
+}
+
+std::size_t WorkStealingPool::threadCount() const
+{
+    return mThreads.size();
+}
+
+bool WorkStealingPool::tryTake(std::size_t self, Task& task)
+{
+    for (std::size_t offset = 0; offset < mQueues.size(); ++offset) {
+        Queue& queue = *mQueues[(self + offset) % mQueues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (offset == 0) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        } else {
+            task = std::move(queue.tasks.back()); // Steal the task its owner would run last
+            queue.tasks.pop_back();
+        }
+        mPending.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index)
+{
+    tCurrentPool = this;
+    tCurrentQueue = index;
+
+    Task task;
+    while (true) {
+        if (tryTake(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mWake.wait(lock, [this] { return mStopping || mPending.load(std::memory_order_acquire) > 0; });
+        if (mStopping && mPending.load(std::memory_order_acquire) == 0) {
+            break; // Stopping and every queued task has run
+        }
+    }
+}
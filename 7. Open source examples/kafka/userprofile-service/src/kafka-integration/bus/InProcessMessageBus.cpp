@@ -0,0 +1,742 @@
+/**
+ * @file InProcessMessageBus.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file contains the implementation of the in-process message bus
+ */
+
+#include "bus/InProcessMessageBus.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "ShardRouter.h"
+
+namespace
+{
+    using FetchedRecords = std::vector<std::shared_ptr<const IMessageBus::Record>>;
+
+    /**
+     * @brief Build the poll batch of fetched records, it views them in the log instead of copying them
+     */
+    std::shared_ptr<const PolledBatch> toBatch(std::shared_ptr<const FetchedRecords> stored)
+    {
+        auto batch = std::make_shared<PolledBatch>(stored);
+        batch->reserve(stored->size());
+        std::vector<PolledBatch::Header> headers;
+        for (const auto& record : *stored) {
+            headers.clear();
+            for (const auto& [name, value] : record->headers) {
+                headers.emplace_back(name, value);
+            }
+            batch->add(PolledBatch::Record{record->topic, record->partition, record->offset, record->key,
+                record->value, record->timestamp}, headers);
+        }
+        return batch;
+    }
+}
+
+/**
+ * @brief Producer handle, transactions and their fencing live in the bus
+ */
+class InProcessMessageBus::BusProducer : public IMessageBus::Producer
+{
+public:
+    BusProducer(InProcessMessageBus& bus, const ProducerOptions& options)
+        : mBus(bus)
+        , mTransactionalId(options.transactionalId)
+    {
+    }
+
+    ~BusProducer() override
+    {
+        // Like closing a Kafka producer, no delivery callback runs after this returns
+        flush();
+    }
+
+    bool publish(Record record, DeliveryCallback onDelivery) override
+    {
+        if (mTransactionalId.empty()) {
+            return mBus.publish(std::move(record), std::move(onDelivery), mTransactionalId, 0);
+        }
+        const std::uint64_t epoch = mEpoch.load();
+        return epoch != 0 && mBus.publish(std::move(record), std::move(onDelivery), mTransactionalId, epoch);
+    }
+
+    bool flush() override
+    {
+        mBus.flushDeliveries();
+        return true;
+    }
+
+    bool initTransactions() override
+    {
+        if (mTransactionalId.empty()) {
+            return false;
+        }
+        mEpoch = mBus.registerProducer(mTransactionalId);
+        return true;
+    }
+
+    bool beginTransaction() override
+    {
+        const std::uint64_t epoch = mEpoch.load();
+        return epoch != 0 && mBus.beginTransaction(mTransactionalId, epoch);
+    }
+
+    bool commitTransaction() override
+    {
+        // Like Kafka, the commit waits for the delivery of the records sent before it
+        mBus.flushDeliveries();
+        const std::uint64_t epoch = mEpoch.load();
+        return epoch != 0 && mBus.endTransaction(mTransactionalId, epoch, true);
+    }
+
+    bool abortTransaction() override
+    {
+        const std::uint64_t epoch = mEpoch.load();
+        return epoch != 0 && mBus.endTransaction(mTransactionalId, epoch, false);
+    }
+
+private:
+    InProcessMessageBus& mBus;
+    std::string mTransactionalId;
+    std::atomic<std::uint64_t> mEpoch{0}; // 0 until initTransactions()
+};
+
+/**
+ * @brief Consumer handle, the group state itself lives in the bus
+ */
+class InProcessMessageBus::GroupConsumer : public IMessageBus::Consumer
+{
+public:
+    GroupConsumer(InProcessMessageBus& bus, const std::string& groupId, std::size_t maxPollRecords)
+        : mBus(bus)
+        , mGroupId(groupId)
+        , mMaxPollRecords(std::max<std::size_t>(maxPollRecords, 1))
+        , mMember(std::make_shared<Member>())
+    {
+    }
+
+    ~GroupConsumer() override
+    {
+        close();
+    }
+
+    void subscribe(const std::set<std::string>& topics, RebalanceCallback onRebalance) override
+    {
+        if (mGroupId.empty() || mAssigned) {
+            return; // Subscribing needs a group, and Kafka does not mix it with assign()
+        }
+        mBus.join(mGroupId, mMember, topics, std::move(onRebalance));
+        mJoined = true;
+    }
+
+    void assign(const TopicPartitions& partitions) override
+    {
+        if (mJoined) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        mMember->positions.clear();
+        for (const auto& topicPartition : partitions) {
+            if (const Partition* partition = mBus.partitionLocked(topicPartition)) {
+                mMember->positions[topicPartition] = partition->startOffset;
+            }
+        }
+        mAssigned = true;
+    }
+
+    std::shared_ptr<const PolledBatch> poll(std::chrono::milliseconds timeout) override
+    {
+        auto stored = std::make_shared<StoredRecords>();
+        if (mJoined) {
+            mBus.announce(mGroupId, *mMember);
+        }
+        if (mJoined || mAssigned) {
+            *stored = mBus.fetch(mGroupId, *mMember, mMaxPollRecords, timeout);
+        }
+        return toBatch(std::move(stored));
+    }
+
+    void seek(const TopicPartition& partition, std::int64_t offset) override
+    {
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        if (auto it = mMember->positions.find(partition); it != mMember->positions.end()) {
+            it->second = offset;
+        }
+    }
+
+    std::int64_t position(const TopicPartition& partition) const override
+    {
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        auto it = mMember->positions.find(partition);
+        return it != mMember->positions.end() ? it->second : -1;
+    }
+
+    bool commit(const Offsets& offsets) override
+    {
+        if (mGroupId.empty()) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        auto& committed = mBus.mGroups[mGroupId].committed;
+        for (const auto& [topicPartition, offset] : offsets) {
+            committed[topicPartition] = offset;
+        }
+        return true;
+    }
+
+    void commitAsync(const Offsets& offsets) override
+    {
+        commit(offsets);
+    }
+
+    Offsets committed(const TopicPartitions& partitions) const override
+    {
+        Offsets offsets;
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        auto group = mBus.mGroups.find(mGroupId);
+        if (group == mBus.mGroups.end()) {
+            return offsets;
+        }
+        for (const auto& topicPartition : partitions) {
+            if (auto it = group->second.committed.find(topicPartition); it != group->second.committed.end()) {
+                offsets.emplace(topicPartition, it->second);
+            }
+        }
+        return offsets;
+    }
+
+    Offsets beginningOffsets(const TopicPartitions& partitions) const override
+    {
+        Offsets offsets;
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        for (const auto& topicPartition : partitions) {
+            if (const Partition* partition = mBus.partitionLocked(topicPartition)) {
+                offsets.emplace(topicPartition, partition->startOffset);
+            }
+        }
+        return offsets;
+    }
+
+    Offsets endOffsets(const TopicPartitions& partitions) const override
+    {
+        Offsets offsets;
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        for (const auto& topicPartition : partitions) {
+            if (const Partition* partition = mBus.partitionLocked(topicPartition)) {
+                offsets.emplace(topicPartition, stableOffsetLocked(*partition));
+            }
+        }
+        return offsets;
+    }
+
+    Offsets offsetsForTime(const TopicPartitions& partitions, Timestamp time) const override
+    {
+        Offsets offsets;
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        for (const auto& topicPartition : partitions) {
+            const Partition* partition = mBus.partitionLocked(topicPartition);
+            if (partition == nullptr) {
+                continue;
+            }
+            const std::int64_t stable = stableOffsetLocked(*partition);
+            auto it = std::find_if(partition->log.begin(), partition->log.end(), [&](const StoredRecord& stored) {
+                return !stored.control && !stored.aborted && stored.record->timestamp >= time;
+            });
+            offsets.emplace(topicPartition,
+                it != partition->log.end() && it->record->offset < stable ? it->record->offset : -1);
+        }
+        return offsets;
+    }
+
+    TopicPartitions partitionsFor(const std::string& topic) const override
+    {
+        TopicPartitions partitions;
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        auto it = mBus.mTopics.find(topic);
+        if (it == mBus.mTopics.end()) {
+            return partitions;
+        }
+        for (std::size_t partition = 0; partition < it->second.size(); ++partition) {
+            partitions.emplace(topic, static_cast<std::int32_t>(partition));
+        }
+        return partitions;
+    }
+
+    void pause(const TopicPartitions& partitions) override
+    {
+        std::lock_guard<std::mutex> lock(mBus.mMutex);
+        mMember->paused.insert(partitions.begin(), partitions.end());
+    }
+
+    void resume(const TopicPartitions& partitions) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mBus.mMutex);
+            for (const auto& topicPartition : partitions) {
+                mMember->paused.erase(topicPartition);
+            }
+        }
+        mBus.mRecordsCv.notify_all();
+    }
+
+    void close() override
+    {
+        if (mJoined) {
+            mJoined = false;
+            mBus.leave(mGroupId, mMember);
+        }
+        if (mAssigned) {
+            mAssigned = false;
+            std::lock_guard<std::mutex> lock(mBus.mMutex);
+            mMember->positions.clear();
+            mMember->paused.clear();
+        }
+    }
+
+private:
+    InProcessMessageBus& mBus;
+    std::string mGroupId;
+    std::size_t mMaxPollRecords;
+    std::shared_ptr<Member> mMember;
+    bool mJoined = false;
+    bool mAssigned = false;
+};
+
+InProcessMessageBus::InProcessMessageBus(Options options)
+    : mOptions(options)
+{
+    mOptions.defaultPartitions = std::max(mOptions.defaultPartitions, 1);
+    if (mOptions.deliveryLatency.count() > 0) {
+        mDeliveryThread = std::thread(&InProcessMessageBus::deliveryLoop, this);
+    }
+}
+
+InProcessMessageBus::~InProcessMessageBus()
+{
+    {
+        std::lock_guard<std::mutex> lock(mDeliveryMutex);
+        mStopping = true;
+    }
+    mDeliveryCv.notify_one();
+    mDeliveredCv.notify_all();
+    if (mDeliveryThread.joinable()) {
+        mDeliveryThread.join();
+    }
+}
+
+bool InProcessMessageBus::createTopic(const std::string& topic, std::int32_t partitions)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mTopics.count(topic) == 0) {
+        mTopics[topic].resize(static_cast<std::size_t>(std::max(partitions, 1)));
+    }
+    return true;
+}
+
+std::unique_ptr<IMessageBus::Producer> InProcessMessageBus::createProducer(const ProducerOptions& options)
+{
+    return std::make_unique<BusProducer>(*this, options);
+}
+
+std::unique_ptr<IMessageBus::Consumer> InProcessMessageBus::createConsumer(const std::string& groupId,
+    std::size_t maxPollRecords)
+{
+    return std::make_unique<GroupConsumer>(*this, groupId, maxPollRecords);
+}
+
+bool InProcessMessageBus::publish(Record record, DeliveryCallback onDelivery, const std::string& transactionalId,
+    std::uint64_t epoch)
+{
+    const auto now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Transaction* transaction = nullptr;
+        if (!transactionalId.empty()) {
+            auto it = mTransactions.find(transactionalId);
+            if (it == mTransactions.end() || it->second.epoch != epoch) {
+                return false; // No transaction open, or the producer was fenced
+            }
+            transaction = &it->second;
+        }
+
+        auto& partitions = topicLocked(record.topic);
+        const auto partitionCount = static_cast<std::uint64_t>(partitions.size());
+        if (record.partition < 0) {
+            record.partition = static_cast<std::int32_t>(record.key.empty()
+                ? mNextUnkeyed++ % partitionCount : ShardRouter::hashKey(record.key) % partitionCount);
+        } else if (static_cast<std::uint64_t>(record.partition) >= partitionCount) {
+            return false; // No such partition
+        }
+
+        Partition& partition = partitions[record.partition];
+        record.timestamp = std::chrono::system_clock::now();
+        const auto visibleAt = transaction != nullptr ? Clock::time_point::max() : now + mOptions.visibilityLatency;
+        record.offset = appendLocked(partition, StoredRecord{std::make_shared<Record>(record), visibleAt});
+        if (transaction != nullptr) {
+            auto& offsets = transaction->offsets[TopicPartition(record.topic, record.partition)];
+            if (offsets.empty()) {
+                partition.openTransactions.insert(record.offset);
+            }
+            offsets.push_back(record.offset);
+        }
+    }
+    mRecordsCv.notify_all();
+
+    if (!onDelivery) {
+        return true;
+    }
+    if (!mDeliveryThread.joinable()) {
+        onDelivery(record, true);
+        return true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mDeliveryMutex);
+        mDeliveries.push_back(PendingDelivery{now + mOptions.deliveryLatency, std::move(record), std::move(onDelivery)});
+    }
+    mDeliveryCv.notify_one();
+    return true;
+}
+
+std::uint64_t InProcessMessageBus::registerProducer(const std::string& transactionalId)
+{
+    std::uint64_t epoch = 0;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        epoch = ++mProducerEpochs[transactionalId];
+        if (auto it = mTransactions.find(transactionalId); it != mTransactions.end()) {
+            endTransactionLocked(it->second, false);
+            mTransactions.erase(it);
+        }
+    }
+    mRecordsCv.notify_all();
+    return epoch;
+}
+
+bool InProcessMessageBus::beginTransaction(const std::string& transactionalId, std::uint64_t epoch)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mProducerEpochs[transactionalId] != epoch || mTransactions.count(transactionalId) != 0) {
+        return false;
+    }
+    mTransactions[transactionalId].epoch = epoch;
+    return true;
+}
+
+bool InProcessMessageBus::endTransaction(const std::string& transactionalId, std::uint64_t epoch, bool commit)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = mTransactions.find(transactionalId);
+        if (it == mTransactions.end() || it->second.epoch != epoch) {
+            return false;
+        }
+        endTransactionLocked(it->second, commit);
+        mTransactions.erase(it);
+    }
+    mRecordsCv.notify_all();
+    return true;
+}
+
+void InProcessMessageBus::endTransactionLocked(Transaction& transaction, bool commit)
+{
+    const auto now = Clock::now();
+    for (const auto& [topicPartition, offsets] : transaction.offsets) {
+        Partition& partition = mTopics[topicPartition.first][topicPartition.second];
+        for (const std::int64_t offset : offsets) {
+            StoredRecord& stored = partition.log[static_cast<std::size_t>(offset - partition.startOffset)];
+            if (commit) {
+                stored.visibleAt = now + mOptions.visibilityLatency;
+            } else {
+                stored.aborted = true;
+            }
+        }
+        partition.openTransactions.erase(partition.openTransactions.find(offsets.front()));
+
+        StoredRecord marker{std::make_shared<Record>(), now, true};
+        marker.record->topic = topicPartition.first;
+        marker.record->partition = topicPartition.second;
+        marker.record->timestamp = std::chrono::system_clock::now();
+        appendLocked(partition, std::move(marker));
+    }
+}
+
+void InProcessMessageBus::flushDeliveries()
+{
+    std::unique_lock<std::mutex> lock(mDeliveryMutex);
+    mDeliveredCv.wait(lock, [this] { return mStopping || (mDeliveries.empty() && mDelivering == 0); });
+}
+
+std::vector<InProcessMessageBus::Partition>& InProcessMessageBus::topicLocked(const std::string& topic)
+{
+    auto& partitions = mTopics[topic];
+    if (partitions.empty()) {
+        partitions.resize(static_cast<std::size_t>(mOptions.defaultPartitions));
+    }
+    return partitions;
+}
+
+const InProcessMessageBus::Partition* InProcessMessageBus::partitionLocked(const TopicPartition& partition) const
+{
+    auto topic = mTopics.find(partition.first);
+    if (topic == mTopics.end() || partition.second < 0
+        || static_cast<std::size_t>(partition.second) >= topic->second.size()) {
+        return nullptr;
+    }
+    return &topic->second[static_cast<std::size_t>(partition.second)];
+}
+
+std::int64_t InProcessMessageBus::stableOffsetLocked(const Partition& partition)
+{
+    return partition.openTransactions.empty()
+        ? partition.startOffset + static_cast<std::int64_t>(partition.log.size())
+        : *partition.openTransactions.begin();
+}
+
+std::int64_t InProcessMessageBus::appendLocked(Partition& partition, StoredRecord stored)
+{
+    const std::int64_t offset = partition.startOffset + static_cast<std::int64_t>(partition.log.size());
+    stored.record->offset = offset;
+    partition.log.push_back(std::move(stored));
+
+    // Retention never drops the records of an open transaction, its end still needs them
+    while (mOptions.retentionRecords > 0 && partition.log.size() > mOptions.retentionRecords
+        && (partition.openTransactions.empty() || partition.startOffset < *partition.openTransactions.begin())) {
+        partition.log.pop_front();
+        ++partition.startOffset;
+    }
+    return offset;
+}
+
+void InProcessMessageBus::rebalanceLocked(Group& group)
+{
+    // Every topic is spread round-robin over the members reading it, in join order
+    std::map<const Member*, TopicPartitions> desired;
+    std::set<std::string> topics;
+    for (const auto& member : group.members) {
+        topics.insert(member->topics.begin(), member->topics.end());
+    }
+    for (const auto& topic : topics) {
+        std::vector<const Member*> readers;
+        for (const auto& member : group.members) {
+            if (member->topics.count(topic) != 0) {
+                readers.push_back(member.get());
+            }
+        }
+        const auto partitionCount = static_cast<std::int32_t>(topicLocked(topic).size());
+        for (std::int32_t partition = 0; partition < partitionCount; ++partition) {
+            desired[readers[static_cast<std::size_t>(partition) % readers.size()]].emplace(topic, partition);
+        }
+    }
+
+    for (const auto& member : group.members) {
+        const TopicPartitions& next = desired[member.get()];
+        for (const auto& topicPartition : member->assignment) {
+            if (next.count(topicPartition) != 0) {
+                continue;
+            }
+            if (member->pendingAssigned.erase(topicPartition) == 0) {
+                member->pendingRevoked.insert(topicPartition);
+                member->handingOver.insert(topicPartition);
+            }
+        }
+        for (const auto& topicPartition : next) {
+            if (member->assignment.count(topicPartition) != 0) {
+                continue;
+            }
+            if (member->pendingRevoked.erase(topicPartition) != 0) {
+                member->handingOver.erase(topicPartition); // Taken back before the member noticed
+            } else {
+                member->pendingAssigned.insert(topicPartition);
+            }
+        }
+        member->assignment = next;
+    }
+    mRecordsCv.notify_all();
+}
+
+bool InProcessMessageBus::handingOverLocked(const Group& group, const TopicPartition& partition) const
+{
+    return std::any_of(group.members.begin(), group.members.end(),
+        [&partition](const auto& member) { return member->handingOver.count(partition) != 0; });
+}
+
+void InProcessMessageBus::join(const std::string& groupId, const std::shared_ptr<Member>& member,
+    const std::set<std::string>& topics, RebalanceCallback onRebalance)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    Group& group = mGroups[groupId];
+    member->topics = topics;
+    member->onRebalance = std::move(onRebalance);
+    if (std::find(group.members.begin(), group.members.end(), member) == group.members.end()) {
+        group.members.push_back(member);
+    }
+    rebalanceLocked(group);
+}
+
+void InProcessMessageBus::leave(const std::string& groupId, const std::shared_ptr<Member>& member)
+{
+    TopicPartitions revoked;
+    RebalanceCallback onRebalance;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Group& group = mGroups[groupId];
+        for (const auto& [topicPartition, position] : member->positions) {
+            revoked.insert(topicPartition);
+        }
+        member->topics.clear();
+        rebalanceLocked(group);
+
+        // Only what the member was told about is revoked, the rest moves on at once
+        member->handingOver = revoked;
+        member->pendingAssigned.clear();
+        member->pendingRevoked.clear();
+        onRebalance = member->onRebalance;
+    }
+
+    if (onRebalance && !revoked.empty()) {
+        onRebalance(RebalanceType::eRevoked, revoked);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Group& group = mGroups[groupId];
+        group.members.erase(std::remove(group.members.begin(), group.members.end(), member), group.members.end());
+        member->handingOver.clear();
+        member->positions.clear();
+    }
+    mRecordsCv.notify_all();
+}
+
+void InProcessMessageBus::announce(const std::string& groupId, Member& member)
+{
+    TopicPartitions revoked;
+    TopicPartitions assigned;
+    RebalanceCallback onRebalance;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        Group& group = mGroups[groupId];
+        revoked.swap(member.pendingRevoked);
+        for (const auto& topicPartition : revoked) {
+            member.positions.erase(topicPartition);
+            member.paused.erase(topicPartition);
+        }
+
+        // A partition moves once its previous owner committed in its revoke callback
+        for (auto it = member.pendingAssigned.begin(); it != member.pendingAssigned.end();) {
+            if (handingOverLocked(group, *it)) {
+                ++it;
+                continue;
+            }
+            const Partition& partition = topicLocked(it->first)[it->second];
+            auto committed = group.committed.find(*it);
+            member.positions[*it] = committed != group.committed.end()
+                ? std::max(committed->second, partition.startOffset) : partition.startOffset;
+            assigned.insert(*it);
+            it = member.pendingAssigned.erase(it);
+        }
+        onRebalance = member.onRebalance;
+    }
+
+    if (!revoked.empty()) {
+        if (onRebalance) {
+            onRebalance(RebalanceType::eRevoked, revoked);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const auto& topicPartition : revoked) {
+                member.handingOver.erase(topicPartition);
+            }
+        }
+        mRecordsCv.notify_all();
+    }
+    if (!assigned.empty() && onRebalance) {
+        onRebalance(RebalanceType::eAssigned, assigned);
+    }
+}
+
+InProcessMessageBus::StoredRecords InProcessMessageBus::fetch(const std::string& groupId, Member& member,
+    std::size_t maxRecords, std::chrono::milliseconds timeout)
+{
+    StoredRecords records;
+    std::vector<std::pair<const TopicPartition*, std::int64_t*>> owned;
+    const auto deadline = Clock::now() + timeout;
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        const auto now = Clock::now();
+        auto nextVisible = Clock::time_point::max();
+
+        owned.clear();
+        for (auto& [topicPartition, position] : member.positions) {
+            if (member.paused.count(topicPartition) == 0) {
+                owned.emplace_back(&topicPartition, &position);
+            }
+        }
+
+        // Start at a different partition every poll so a busy one cannot starve the others
+        const std::size_t start = owned.empty() ? 0 : member.nextPartition++ % owned.size();
+        for (std::size_t i = 0; i < owned.size(); ++i) {
+            const auto& [topicPartition, position] = owned[(start + i) % owned.size()];
+            const Partition& partition = mTopics[topicPartition->first][topicPartition->second];
+            *position = std::max(*position, partition.startOffset);
+
+            // Nothing at or behind an open transaction is fetched, markers and aborted records are skipped
+            const std::int64_t stable = stableOffsetLocked(partition);
+            while (*position < stable) {
+                const StoredRecord& stored = partition.log[static_cast<std::size_t>(*position - partition.startOffset)];
+                if (stored.control || stored.aborted) {
+                    ++*position;
+                    continue;
+                }
+                if (records.size() >= maxRecords) {
+                    break;
+                }
+                if (stored.visibleAt > now) {
+                    nextVisible = std::min(nextVisible, stored.visibleAt);
+                    break;
+                }
+                records.push_back(stored.record);
+                ++*position;
+            }
+        }
+
+        if (!records.empty() || now >= deadline || !member.pendingRevoked.empty()) {
+            return records;
+        }
+        // Let poll() announce new partitions unless they still wait for their previous owner
+        const Group& group = mGroups[groupId];
+        for (const auto& topicPartition : member.pendingAssigned) {
+            if (!handingOverLocked(group, topicPartition)) {
+                return records;
+            }
+        }
+        mRecordsCv.wait_until(lock, std::min(deadline, nextVisible));
+    }
+}
+
+void InProcessMessageBus::deliveryLoop()
+{
+    std::unique_lock<std::mutex> lock(mDeliveryMutex);
+    while (!mStopping) {
+        if (mDeliveries.empty()) {
+            mDeliveryCv.wait(lock, [this] { return mStopping || !mDeliveries.empty(); });
+            continue;
+        }
+        if (Clock::now() < mDeliveries.front().at) {
+            mDeliveryCv.wait_until(lock, mDeliveries.front().at, [this] { return mStopping; });
+            continue;
+        }
+
+        PendingDelivery delivery = std::move(mDeliveries.front());
+        mDeliveries.pop_front();
+        ++mDelivering;
+        lock.unlock();
+        delivery.onDelivery(delivery.record, true);
+        lock.lock();
+        --mDelivering;
+        mDeliveredCv.notify_all();
+    }
+}
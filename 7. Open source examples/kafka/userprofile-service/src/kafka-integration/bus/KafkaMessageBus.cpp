@@ -0,0 +1,495 @@
+/**
+ * @file KafkaMessageBus.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file contains the implementation of the message bus backed by a Kafka cluster
+ */
+
+#include "bus/KafkaMessageBus.h"
+
+#include <algorithm>
+
+#include <kafka/AdminClient.h>
+#include <kafka/KafkaConsumer.h>
+#include <kafka/KafkaException.h>
+#include <kafka/KafkaProducer.h>
+#include <kafka/ProducerRecord.h>
+
+#include "KafkaConst.h"
+#include "logger/LoggerStream.h"
+
+namespace
+{
+    using KafkaConsumer = KAFKA_API::clients::consumer::KafkaConsumer;
+    using KafkaProducer = KAFKA_API::clients::producer::KafkaProducer;
+
+    // How long a metadata request may take before partitionsFor() gives up
+    constexpr std::chrono::milliseconds kMetadataTimeout{5000};
+}
+
+/**
+ * @brief Producer on a KafkaProducer, values are handed to librdkafka without a copy
+ */
+class KafkaMessageBus::KafkaProducerAdapter : public IMessageBus::Producer
+{
+public:
+    explicit KafkaProducerAdapter(std::unique_ptr<KafkaProducer> producer)
+        : mProducer(std::move(producer))
+    {
+    }
+
+    bool publish(Record record, DeliveryCallback onDelivery) override
+    {
+        // The callback owns the record, so the value stays valid until the broker acknowledged it
+        auto owned = std::make_shared<Record>(std::move(record));
+        try {
+            const auto value = owned->value.view();
+            const auto key = KAFKA_API::Key(owned->key.data(), owned->key.size());
+            const auto payload = KAFKA_API::Value(value.data(), value.size());
+            auto producerRecord = owned->partition < 0
+                ? KAFKA_API::clients::producer::ProducerRecord(owned->topic, key, payload)
+                : KAFKA_API::clients::producer::ProducerRecord(owned->topic, owned->partition, key, payload);
+
+            // librdkafka copies the headers on send, the strings only have to outlive the call
+            for (const auto& [name, headerValue] : owned->headers) {
+                producerRecord.headers().emplace_back(name, KAFKA_API::Header::Value(headerValue.data(), headerValue.size()));
+            }
+
+            mProducer->send(producerRecord,
+                [owned, onDelivery = std::move(onDelivery)](const KAFKA_API::clients::producer::RecordMetadata& metadata,
+                    const KAFKA_API::Error& error) {
+                    if (error) {
+                        LOG(logger::LogLevel::Error) << "Failed to deliver a record to " << owned->topic << ": "
+                                                     << error.message();
+                    } else {
+                        owned->partition = metadata.partition();
+                        owned->offset = metadata.offset().value_or(-1);
+                    }
+                    if (onDelivery) {
+                        onDelivery(*owned, !error);
+                    }
+                },
+                KafkaProducer::SendOption::NoCopyRecordValue);
+            return true;
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "The Kafka client refused a record for " << owned->topic << ": " << e.what();
+            return false;
+        }
+    }
+
+    bool flush() override
+    {
+        try {
+            return !mProducer->flush();
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to flush the Kafka producer: " << e.what();
+            return false;
+        }
+    }
+
+    bool initTransactions() override
+    {
+        return runTransactional("initialize transactions", [this] { mProducer->initTransactions(); });
+    }
+
+    bool beginTransaction() override
+    {
+        return runTransactional("begin a transaction", [this] { mProducer->beginTransaction(); });
+    }
+
+    bool commitTransaction() override
+    {
+        return runTransactional("commit a transaction", [this] { mProducer->commitTransaction(); });
+    }
+
+    bool abortTransaction() override
+    {
+        return runTransactional("abort a transaction", [this] { mProducer->abortTransaction(); });
+    }
+
+private:
+    template <typename Call>
+    static bool runTransactional(const char* what, Call call)
+    {
+        try {
+            call();
+            return true;
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to " << what << ": " << e.what();
+            return false;
+        }
+    }
+
+    std::unique_ptr<KafkaProducer> mProducer;
+};
+
+/**
+ * @brief Consumer on a KafkaConsumer, values stay in the polled records without a copy
+ */
+class KafkaMessageBus::KafkaConsumerAdapter : public IMessageBus::Consumer
+{
+public:
+    KafkaConsumerAdapter(std::unique_ptr<KafkaConsumer> consumer, bool grouped)
+        : mConsumer(std::move(consumer))
+        , mGrouped(grouped)
+    {
+    }
+
+    void subscribe(const std::set<std::string>& topics, RebalanceCallback onRebalance) override
+    {
+        try {
+            mConsumer->subscribe(KAFKA_API::Topics(topics.begin(), topics.end()),
+                [onRebalance = std::move(onRebalance)](KAFKA_API::clients::consumer::RebalanceEventType type,
+                    const KAFKA_API::TopicPartitions& partitions) {
+                    if (!onRebalance) {
+                        return;
+                    }
+                    onRebalance(type == KAFKA_API::clients::consumer::RebalanceEventType::PartitionsAssigned
+                        ? RebalanceType::eAssigned : RebalanceType::eRevoked, toPartitions(partitions));
+                });
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to subscribe: " << e.what();
+        }
+    }
+
+    void assign(const TopicPartitions& partitions) override
+    {
+        try {
+            mConsumer->assign(toKafka(partitions));
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to assign partitions: " << e.what();
+        }
+    }
+
+    std::shared_ptr<const PolledBatch> poll(std::chrono::milliseconds timeout) override
+    {
+        using Polled = std::vector<KAFKA_API::clients::consumer::ConsumerRecord>;
+        auto polled = std::make_shared<Polled>();
+        try {
+            *polled = mConsumer->poll(timeout);
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to poll: " << e.what();
+        }
+
+        // Keys, values and header values view the polled records, which the batch keeps alive. The
+        // client returns topic and header names as new strings, the batch interns them once
+        auto batch = std::make_shared<PolledBatch>(polled);
+        batch->reserve(polled->size());
+        std::vector<PolledBatch::Header> headers;
+        for (const auto& polledRecord : *polled) {
+            if (polledRecord.error()) {
+                LOG(logger::LogLevel::Warning) << "Skipping a record which failed to consume: "
+                                               << polledRecord.toString();
+                continue;
+            }
+            headers.clear();
+            for (const auto& header : polledRecord.headers()) {
+                headers.emplace_back(batch->intern(header.key),
+                    std::string_view(static_cast<const char*>(header.value.data()), header.value.size()));
+            }
+            PolledBatch::Record record;
+            record.topic = batch->intern(polledRecord.topic());
+            record.partition = polledRecord.partition();
+            record.offset = polledRecord.offset();
+            record.key = std::string_view(static_cast<const char*>(polledRecord.key().data()),
+                polledRecord.key().size());
+            record.value = SharedPayload(std::string_view(static_cast<const char*>(polledRecord.value().data()),
+                polledRecord.value().size()), polled);
+            record.timestamp = Timestamp(std::chrono::milliseconds(polledRecord.timestamp().msSinceEpoch));
+            batch->add(std::move(record), headers);
+        }
+        return batch;
+    }
+
+    void seek(const TopicPartition& partition, std::int64_t offset) override
+    {
+        try {
+            mConsumer->seek(partition, offset);
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to seek " << partition.first << "-" << partition.second << ": "
+                                         << e.what();
+        }
+    }
+
+    std::int64_t position(const TopicPartition& partition) const override
+    {
+        try {
+            const auto offset = mConsumer->position(partition);
+            return offset >= 0 ? offset : -1;
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to get the position of " << partition.first << "-"
+                                         << partition.second << ": " << e.what();
+            return -1;
+        }
+    }
+
+    bool commit(const Offsets& offsets) override
+    {
+        if (!mGrouped) {
+            return false;
+        }
+        try {
+            mConsumer->commitSync(toKafka(offsets));
+            return true;
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to commit offsets: " << e.what();
+            return false;
+        }
+    }
+
+    void commitAsync(const Offsets& offsets) override
+    {
+        if (!mGrouped) {
+            return;
+        }
+        try {
+            mConsumer->commitAsync(toKafka(offsets),
+                [](const KAFKA_API::TopicPartitionOffsets&, const KAFKA_API::Error& error) {
+                    if (error) {
+                        LOG(logger::LogLevel::Warning) << "Failed to commit offsets asynchronously: " << error.message();
+                    }
+                });
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Warning) << "Failed to commit offsets asynchronously: " << e.what();
+        }
+    }
+
+    Offsets committed(const TopicPartitions& partitions) const override
+    {
+        Offsets offsets;
+        for (const auto& partition : partitions) {
+            try {
+                const auto offset = mConsumer->committed(partition);
+                if (offset >= 0) {
+                    offsets.emplace(partition, offset);
+                }
+            } catch(const KAFKA_API::KafkaException& e) {
+                LOG(logger::LogLevel::Warning) << "Failed to get the committed offset of " << partition.first << "-"
+                                               << partition.second << ": " << e.what();
+            }
+        }
+        return offsets;
+    }
+
+    Offsets beginningOffsets(const TopicPartitions& partitions) const override
+    {
+        try {
+            return toOffsets(mConsumer->beginningOffsets(toKafka(partitions)));
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to get the beginning offsets: " << e.what();
+            return {};
+        }
+    }
+
+    Offsets endOffsets(const TopicPartitions& partitions) const override
+    {
+        try {
+            return toOffsets(mConsumer->endOffsets(toKafka(partitions)));
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to get the end offsets: " << e.what();
+            return {};
+        }
+    }
+
+    Offsets offsetsForTime(const TopicPartitions& partitions, Timestamp time) const override
+    {
+        Offsets offsets;
+        try {
+            offsets = toOffsets(mConsumer->offsetsForTime(toKafka(partitions), time));
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to get the offsets for a time: " << e.what();
+            return offsets;
+        }
+        for (const auto& partition : partitions) {
+            if (auto it = offsets.find(partition); it == offsets.end() || it->second < 0) {
+                offsets[partition] = -1; // No record that late
+            }
+        }
+        return offsets;
+    }
+
+    TopicPartitions partitionsFor(const std::string& topic) const override
+    {
+        TopicPartitions partitions;
+        try {
+            const auto metadata = mConsumer->fetchBrokerMetadata(topic, kMetadataTimeout);
+            if (!metadata) {
+                LOG(logger::LogLevel::Error) << "No broker metadata for " << topic;
+                return partitions;
+            }
+            for (const auto& [partition, info] : metadata->partitions()) {
+                partitions.emplace(topic, partition);
+            }
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to fetch the broker metadata for " << topic << ": " << e.what();
+        }
+        return partitions;
+    }
+
+    void pause(const TopicPartitions& partitions) override
+    {
+        try {
+            mConsumer->pause(toKafka(partitions));
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to pause partitions: " << e.what();
+        }
+    }
+
+    void resume(const TopicPartitions& partitions) override
+    {
+        try {
+            mConsumer->resume(toKafka(partitions));
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to resume partitions: " << e.what();
+        }
+    }
+
+    void close() override
+    {
+        try {
+            mConsumer->close();
+        } catch(const KAFKA_API::KafkaException& e) {
+            LOG(logger::LogLevel::Error) << "Failed to close the consumer: " << e.what();
+        }
+    }
+
+private:
+    static KAFKA_API::TopicPartitions toKafka(const TopicPartitions& partitions)
+    {
+        return KAFKA_API::TopicPartitions(partitions.begin(), partitions.end());
+    }
+
+    static KAFKA_API::TopicPartitionOffsets toKafka(const Offsets& offsets)
+    {
+        return KAFKA_API::TopicPartitionOffsets(offsets.begin(), offsets.end());
+    }
+
+    static TopicPartitions toPartitions(const KAFKA_API::TopicPartitions& partitions)
+    {
+        return TopicPartitions(partitions.begin(), partitions.end());
+    }
+
+    static Offsets toOffsets(const KAFKA_API::TopicPartitionOffsets& offsets)
+    {
+        return Offsets(offsets.begin(), offsets.end());
+    }
+
+    std::unique_ptr<KafkaConsumer> mConsumer;
+    bool mGrouped;
+};
+
+KafkaMessageBus::KafkaMessageBus(const ServiceConfig& config)
+    : mConfig(config)
+{
+}
+
+bool KafkaMessageBus::createTopic(const std::string& topic, std::int32_t partitions)
+{
+    const std::string servers = brokers();
+    if (servers.empty()) {
+        return false; // No brokers configured
+    }
+    try {
+        KAFKA_API::clients::admin::AdminClient admin(KAFKA_API::Properties({{"bootstrap.servers", servers}}));
+        // -1 leaves the replication factor to the broker default
+        const auto result = admin.createTopics({topic}, partitions, -1);
+        if (result.error && result.error.value() != RD_KAFKA_RESP_ERR_TOPIC_ALREADY_EXISTS) {
+            LOG(logger::LogLevel::Error) << "Failed to create " << topic << ": " << result.error.message();
+            return false;
+        }
+        return true;
+    } catch(const KAFKA_API::KafkaException& e) {
+        LOG(logger::LogLevel::Error) << "Failed to create " << topic << ": " << e.what();
+        return false;
+    }
+}
+
+std::unique_ptr<IMessageBus::Producer> KafkaMessageBus::createProducer(const ProducerOptions& options)
+{
+    const std::string servers = brokers();
+    if (servers.empty()) {
+        LOG(logger::LogLevel::Error) << "Cannot create a Kafka producer, no brokers configured";
+        return nullptr;
+    }
+
+    KAFKA_API::Properties properties({{"bootstrap.servers", servers}});
+    const std::string& clientId = options.clientId.empty() ? mConfig.getKafkaClientId() : options.clientId;
+    if (!clientId.empty()) {
+        properties.put("client.id", clientId);
+    }
+
+    const bool transactional = !options.transactionalId.empty();
+    if (options.idempotent || transactional) {
+        // The broker drops duplicates caused by retries, which requires acks from all replicas
+        // and at most 5 in-flight requests per connection to keep ordering
+        properties.put("enable.idempotence", "true");
+        properties.put("acks", "all");
+        properties.put("max.in.flight.requests.per.connection", "5");
+    }
+    if (transactional) {
+        properties.put("transactional.id", options.transactionalId);
+    }
+
+    // Explicit producer settings from the configuration override the defaults above
+    for (const auto& [key, value] : mConfig.getAllKafkaProducerConfig()) {
+        properties.put(key, value);
+    }
+
+    try {
+        return std::make_unique<KafkaProducerAdapter>(std::make_unique<KafkaProducer>(properties));
+    } catch(const KAFKA_API::KafkaException& e) {
+        LOG(logger::LogLevel::Error) << "Failed to create the Kafka producer: " << e.what();
+        return nullptr;
+    }
+}
+
+std::unique_ptr<IMessageBus::Consumer> KafkaMessageBus::createConsumer(const std::string& groupId,
+    std::size_t maxPollRecords)
+{
+    const std::string servers = brokers();
+    if (servers.empty()) {
+        LOG(logger::LogLevel::Error) << "Cannot create a Kafka consumer, no brokers configured";
+        return nullptr;
+    }
+
+    KAFKA_API::Properties properties({{"bootstrap.servers", servers}});
+    if (!groupId.empty()) {
+        properties.put("group.id", groupId);
+    }
+    if (!mConfig.getKafkaClientId().empty()) {
+        properties.put("client.id", mConfig.getKafkaClientId());
+    }
+
+    // Offsets are committed by the consumer once records are handled, never by a background timer
+    properties.put("enable.auto.commit", "false");
+
+    // A poll returns early once it has this many records, so a backlog is drained in large batches
+    properties.put("max.poll.records", std::to_string(std::max<std::size_t>(maxPollRecords, 1)));
+
+    // Records of open or aborted transactions are never handed out
+    properties.put("isolation.level", "read_committed");
+
+    // Explicit consumer settings from the configuration override the defaults above
+    for (const auto& [key, value] : mConfig.getAllKafkaConsumerConfig()) {
+        properties.put(key, value);
+    }
+
+    try {
+        return std::make_unique<KafkaConsumerAdapter>(std::make_unique<KafkaConsumer>(properties), !groupId.empty());
+    } catch(const KAFKA_API::KafkaException& e) {
+        LOG(logger::LogLevel::Error) << "Failed to create the Kafka consumer: " << e.what();
+        return nullptr;
+    }
+}
+
+std::string KafkaMessageBus::brokers() const
+{
+    // Brokers from the configuration win, the constants are the local development fallback
+    std::string brokers = mConfig.getKafkaBroker();
+    if (brokers.empty()) {
+        for (const auto& [name, address] : kafka_const::kBrokers) {
+            brokers += (brokers.empty() ? "" : ",") + address;
+        }
+    }
+    return brokers;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file PolledBatch.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of PolledBatch class
+ */
+
+#include "bus/PolledBatch.h"
+
+#include <algorithm>
+
+PolledBatch::PolledBatch(std::shared_ptr<const void> storage)
+    : mStorage(std::move(storage))
+    , mArena(mBuffer.data(), mBuffer.size())
+    , mInterned(&mArena)
+{
+}
+
+void PolledBatch::reserve(std::size_t records)
+{
+    mRecords.reserve(records);
+}
+
+void PolledBatch::add(Record record, std::span<const Header> headers)
+{
+    record.firstHeader = static_cast<std::uint32_t>(mHeaders.size());
+    record.headerCount = static_cast<std::uint32_t>(headers.size());
+    mHeaders.insert(mHeaders.end(), headers.begin(), headers.end());
+    mRecords.push_back(std::move(record));
+}
+
+std::string_view PolledBatch::intern(std::string_view text)
+{
+    // A linear search beats hashing for a handful of names
+    for (const auto name : mInterned) {
+        if (name == text) {
+            return name;
+        }
+    }
+    auto* bytes = static_cast<char*>(mArena.allocate(std::max<std::size_t>(text.size(), 1), 1));
+    std::copy(text.begin(), text.end(), bytes);
+    return mInterned.emplace_back(bytes, text.size());
+}
+
+const std::vector<PolledBatch::Record>& PolledBatch::records() const
+{
+    return mRecords;
+}
+
+std::span<const PolledBatch::Header> PolledBatch::headers(const Record& record) const
+{
+    return std::span<const Header>(mHeaders).subspan(record.firstHeader, record.headerCount);
+}
+
+std::size_t PolledBatch::size() const
+{
+    return mRecords.size();
+}
+
+bool PolledBatch::empty() const
+{
+    return mRecords.empty();
+}
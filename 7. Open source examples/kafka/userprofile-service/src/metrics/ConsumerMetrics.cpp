@@ -0,0 +1,111 @@
+/**
+ * @file ConsumerMetrics.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of ConsumerMetrics class
+ */
+
+#include "ConsumerMetrics.h"
+
+#include <algorithm>
+
+namespace
+{
+    std::uint64_t elapsedUs(Event::Clock::time_point from, Event::Clock::time_point to)
+    {
+        if (to <= from) {
+            return 0;
+        }
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+    }
+
+    double perSecond(std::uint64_t current, std::uint64_t previous, double seconds)
+    {
+        return seconds > 0.0 ? static_cast<double>(current - previous) / seconds : 0.0;
+    }
+
+    std::shared_ptr<const ConsumerMetrics::Snapshot> emptySnapshot()
+    {
+        ConsumerMetrics::Snapshot snapshot;
+        snapshot.takenAt = ConsumerMetrics::Clock::now();
+        return std::make_shared<const ConsumerMetrics::Snapshot>(std::move(snapshot));
+    }
+}
+
+ConsumerMetrics::ConsumerMetrics()
+    : mSnapshot(emptySnapshot())
+{
+}
+
+void ConsumerMetrics::onPolled(std::uint64_t records, std::uint64_t bytes, std::uint64_t decodeUs)
+{
+    mPolledRecords.fetch_add(records, std::memory_order_relaxed);
+    mPolledBytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (records > 0) {
+        mDecodeUs.record(decodeUs);
+    }
+}
+
+void ConsumerMetrics::onHandled(std::span<const Event> events, std::size_t failed, Clock::time_point startedAt,
+    Clock::time_point finishedAt)
+{
+    std::uint64_t bytes = 0;
+    for (const auto& event : events) {
+        bytes += event.getKey().size() + event.getPayload().size();
+        mQueueUs.record(elapsedUs(event.getReceivedAt(), startedAt));
+        mPollToHandledUs.record(elapsedUs(event.getReceivedAt(), finishedAt));
+    }
+    mHandleUs.record(elapsedUs(startedAt, finishedAt));
+
+    mHandledRecords.fetch_add(events.size(), std::memory_order_relaxed);
+    mHandledBytes.fetch_add(bytes, std::memory_order_relaxed);
+    mFailedRecords.fetch_add(failed, std::memory_order_relaxed);
+}
+
+void ConsumerMetrics::publish(Clock::time_point now, std::vector<PartitionLag> partitions,
+    std::vector<std::size_t> queueDepths, DedupSnapshot dedup, RetrySnapshot retry,
+    std::vector<HandlerSnapshot> handlers)
+{
+    const auto previous = mSnapshot.load(std::memory_order_acquire);
+    auto next = std::make_shared<Snapshot>();
+    next->takenAt = now;
+
+    next->polledRecords = mPolledRecords.load(std::memory_order_relaxed);
+    next->polledBytes = mPolledBytes.load(std::memory_order_relaxed);
+    next->handledRecords = mHandledRecords.load(std::memory_order_relaxed);
+    next->handledBytes = mHandledBytes.load(std::memory_order_relaxed);
+    next->failedRecords = mFailedRecords.load(std::memory_order_relaxed);
+
+    const double seconds = std::chrono::duration<double>(now - previous->takenAt).count();
+    next->polledRecordsPerSec = perSecond(next->polledRecords, previous->polledRecords, seconds);
+    next->polledBytesPerSec = perSecond(next->polledBytes, previous->polledBytes, seconds);
+    next->handledRecordsPerSec = perSecond(next->handledRecords, previous->handledRecords, seconds);
+    next->handledBytesPerSec = perSecond(next->handledBytes, previous->handledBytes, seconds);
+
+    next->decodeUs = mDecodeUs.snapshot();
+    next->queueUs = mQueueUs.snapshot();
+    next->handleUs = mHandleUs.snapshot();
+    next->pollToHandledUs = mPollToHandledUs.snapshot();
+
+    for (auto& partition : partitions) {
+        if (partition.endOffset >= 0 && partition.committed >= 0) {
+            partition.lag = std::max<std::int64_t>(partition.endOffset - partition.committed, 0);
+            next->totalLag += partition.lag;
+        }
+    }
+    next->partitions = std::move(partitions);
+    next->queueDepths = std::move(queueDepths);
+
+    next->dedup = dedup;
+    next->dedupHitsPerSec = perSecond(dedup.hits, previous->dedup.hits, seconds);
+    next->dedupMissesPerSec = perSecond(dedup.misses, previous->dedup.misses, seconds);
+    next->retry = retry;
+    next->handlers = std::move(handlers);
+
+    mSnapshot.store(std::move(next), std::memory_order_release);
+}
+
+std::shared_ptr<const ConsumerMetrics::Snapshot> ConsumerMetrics::snapshot() const
+{
+    return mSnapshot.load(std::memory_order_acquire);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of LatencyHistogram class
+ */
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+
+void LatencyHistogram::record(std::uint64_t value)
+{
+    mBuckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t currentMax = mMax.load(std::memory_order_relaxed);
+    while (value > currentMax
+        && !mMax.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot result;
+    result.count = mCount.load(std::memory_order_relaxed);
+    result.max = mMax.load(std::memory_order_relaxed);
+    if (result.count > 0) {
+        result.mean = static_cast<double>(mSum.load(std::memory_order_relaxed)) / static_cast<double>(result.count);
+    }
+    result.p50 = valueAtPercentile(50.0);
+    result.p90 = valueAtPercentile(90.0);
+    result.p99 = valueAtPercentile(99.0);
+    result.p999 = valueAtPercentile(99.9);
+    return result;
+}
+
+std::uint64_t LatencyHistogram::valueAtPercentile(double percentile) const
+{
+    std::uint64_t total = 0;
+    for (const auto& bucket : mBuckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto target = std::max<std::uint64_t>(1,
+        static_cast<std::uint64_t>(clamped / 100.0 * static_cast<double>(total) + 0.5));
+
+    std::uint64_t seen = 0;
+    for (std::size_t index = 0; index < kBucketCount; ++index) {
+        seen += mBuckets[index].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(bucketUpperBound(index), mMax.load(std::memory_order_relaxed));
+        }
+    }
+    return mMax.load(std::memory_order_relaxed);
+}
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t value)
+{
+    value = std::min<std::uint64_t>(value, (std::uint64_t{1} << kMaxValueBits) - 1);
+    if (value < kSubBucketCount) {
+        return static_cast<std::size_t>(value);
+    }
+
+    const unsigned msb = static_cast<unsigned>(std::bit_width(value)) - 1;
+    const unsigned exponent = msb - kSubBucketBits + 1;
+    const std::uint64_t mantissa = value >> exponent; // in [kHalfSubBucketCount, kSubBucketCount)
+    return static_cast<std::size_t>(kSubBucketCount + (exponent - 1) * kHalfSubBucketCount
+        + (mantissa - kHalfSubBucketCount));
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index)
+{
+    if (index < kSubBucketCount) {
+        return index;
+    }
+
+    const std::uint64_t offset = index - kSubBucketCount;
+    const std::uint64_t exponent = offset / kHalfSubBucketCount + 1;
+    const std::uint64_t mantissa = offset % kHalfSubBucketCount + kHalfSubBucketCount;
+    return ((mantissa + 1) << exponent) - 1;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file ProducerMetrics.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file is implementation of ProducerMetrics class
+ */
+
+#include "ProducerMetrics.h"
+
+#include <algorithm>
+#include <mutex>
+
+ProducerMetrics::TopicCounters& ProducerMetrics::topic(const std::string& topic)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(mMutex);
+        auto it = mTopics.find(topic);
+        if (it != mTopics.end()) {
+            return *it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mMutex);
+    auto& counters = mTopics[topic];
+    if (!counters) {
+        counters = std::make_unique<TopicCounters>();
+    }
+    return *counters;
+}
+
+void ProducerMetrics::onSent(TopicCounters& counters, std::uint64_t records)
+{
+    counters.sent.fetch_add(records, std::memory_order_relaxed);
+    counters.inFlight.fetch_add(static_cast<std::int64_t>(records), std::memory_order_relaxed);
+}
+
+void ProducerMetrics::onRefused(TopicCounters& counters, std::uint64_t records)
+{
+    counters.sent.fetch_sub(records, std::memory_order_relaxed);
+    counters.refused.fetch_add(records, std::memory_order_relaxed);
+    counters.inFlight.fetch_sub(static_cast<std::int64_t>(records), std::memory_order_relaxed);
+}
+
+void ProducerMetrics::onAcked(TopicCounters& counters, std::uint64_t latencyUs, std::int64_t offset)
+{
+    counters.acked.fetch_add(1, std::memory_order_relaxed);
+    counters.inFlight.fetch_sub(1, std::memory_order_relaxed);
+    counters.ackLatencyUs.record(latencyUs);
+
+    std::int64_t current = counters.lastAckedOffset.load(std::memory_order_relaxed);
+    while (offset > current
+        && !counters.lastAckedOffset.compare_exchange_weak(current, offset, std::memory_order_relaxed)) {
+    }
+}
+
+void ProducerMetrics::onFailed(TopicCounters& counters)
+{
+    counters.failed.fetch_add(1, std::memory_order_relaxed);
+    counters.inFlight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+ProducerMetrics::Snapshot ProducerMetrics::snapshot() const
+{
+    Snapshot result;
+    {
+        std::shared_lock<std::shared_mutex> lock(mMutex);
+        result.topics.reserve(mTopics.size());
+        for (const auto& [name, counters] : mTopics) {
+            TopicSnapshot topic;
+            topic.topic = name;
+            topic.sent = counters->sent.load(std::memory_order_relaxed);
+            topic.refused = counters->refused.load(std::memory_order_relaxed);
+            topic.acked = counters->acked.load(std::memory_order_relaxed);
+            topic.failed = counters->failed.load(std::memory_order_relaxed);
+            topic.inFlight = counters->inFlight.load(std::memory_order_relaxed);
+            topic.lastAckedOffset = counters->lastAckedOffset.load(std::memory_order_relaxed);
+            topic.ackLatencyUs = counters->ackLatencyUs.snapshot();
+            result.topics.push_back(std::move(topic));
+        }
+    }
+
+    std::sort(result.topics.begin(), result.topics.end(),
+        [](const TopicSnapshot& lhs, const TopicSnapshot& rhs) { return lhs.topic < rhs.topic; });
+    return result;
+}
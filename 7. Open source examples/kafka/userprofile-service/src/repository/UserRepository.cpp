@@ -8,10 +8,28 @@
 #include "UserRepository.h"
 #include "User.h"
 #include "connection/SQLiteConnection.h"
+#include "logger/LoggerStream.h"
 
 namespace
 {
     using ConnectionType = user_profile::utils::database::ConnectionType;
+
+    std::string insertUserSql(const User& user)
+    {
+        return "INSERT INTO Users (user_id, email, username, created_at, updated_at) "
+            "VALUES ('" + user.getUserId() + "', '" + user.getEmail() + "', '"
+            + user.getUserName() + "', '" + user.getCreateAt() + "', '"
+            + user.getUpdateAt() + "')";
+    }
+
+    std::string updateUserSql(const User& user)
+    {
+        return "UPDATE Users SET "
+            "email = '" + user.getEmail() + "', "
+            "username = '" + user.getUserName() + "', "
+            "updated_at = '" + user.getUpdateAt() + "' "
+            "WHERE user_id = '" + user.getUserId() + "'";
+    }
 }
 
 UserRepository::UserRepository()
@@ -25,7 +43,7 @@ UserRepository::~UserRepository()
 
 void UserRepository::selectConnection(ConnectionType type)
 {
-    if (type == m_currentConnectionType) {
+    if (type == m_currentConnectionType && !m_currentConnection.expired()) {
         return;
     }
 
@@ -45,6 +63,7 @@ ConnectionType UserRepository::getCurrentConnectionType() const
 
 void UserRepository::createTable()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (auto const connection = m_currentConnection.lock(); connection) {
         //TODO: build a helper create sql query by object
         const std::string sql = 
@@ -56,6 +75,19 @@ void UserRepository::createTable()
             "updated_at TEXT DEFAULT CURRENT_TIMESTAMP"
             ")";
         connection->transaction(sql);
+
+        // Events are written here together with the user row and relayed to Kafka afterwards
+        const std::string outboxSql =
+            "CREATE TABLE IF NOT EXISTS Outbox ("
+            "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+            "topic TEXT NOT NULL, "
+            "message_key TEXT NOT NULL, "
+            "payload BLOB NOT NULL, "
+            "event_type INTEGER NOT NULL DEFAULT 0, "
+            "event_id TEXT NOT NULL DEFAULT '', "
+            "created_at TEXT DEFAULT CURRENT_TIMESTAMP"
+            ")";
+        connection->transaction(outboxSql);
     } else {
         //TODO: add log
     }
@@ -63,13 +95,9 @@ void UserRepository::createTable()
 
 void UserRepository::insert(const User& user)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (auto const connection = m_currentConnection.lock(); connection) {
-        const std::string sql =
-            "INSERT INTO Users (user_id, email, username, created_at, updated_at) "
-            "VALUES ('" + user.getUserId() + "', '" + user.getEmail() + "', '"
-            + user.getUserName() + "', '" + user.getCreateAt() + "', '"
-            + user.getUpdateAt() + "')";
-        connection->transaction(sql);
+        connection->transaction(insertUserSql(user));
     } else {
         //TODO: add log
     }
@@ -77,19 +105,170 @@ void UserRepository::insert(const User& user)
 
 void UserRepository::update(const User& user)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (auto const connection = m_currentConnection.lock(); connection) {
-        const std::string sql =
-            "UPDATE Users SET "
-            "email = '" + user.getEmail() + "', "
-            "username = '" + user.getUserName() + "', "
-            "updated_at = '" + user.getUpdateAt() + "' "
-            "WHERE user_id = '" + user.getUserId() + "'";
-        connection->transaction(sql);
+        connection->transaction(updateUserSql(user));
     } else {
         //TODO: add log
     }
 }
 
+bool UserRepository::insert(const User& user, const OutboxMessage& event)
+{
+    return writeWithOutbox(insertUserSql(user), event);
+}
+
+bool UserRepository::update(const User& user, const OutboxMessage& event)
+{
+    return writeWithOutbox(updateUserSql(user), event);
+}
+
+std::optional<std::vector<OutboxMessage>> UserRepository::fetchOutbox(std::size_t limit)
+{
+    std::vector<OutboxMessage> messages;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const connection = m_currentConnection.lock();
+    if (!connection)
+    {
+        LOG(logger::LogLevel::Error) << "Cannot read the outbox without a database connection";
+        return std::nullopt;
+    }
+
+    try {
+        SQLite::Statement query(*connection->connection(),
+            "SELECT id, topic, message_key, payload, event_type, event_id FROM Outbox ORDER BY id LIMIT ?");
+        query.bind(1, static_cast<std::int64_t>(limit));
+        messages.reserve(limit);
+        while (query.executeStep())
+        {
+            OutboxMessage message;
+            message.id = query.getColumn(0).getInt64();
+            message.topic = query.getColumn(1).getText();
+            message.key = query.getColumn(2).getText();
+            const auto payload = query.getColumn(3);
+            message.payload.assign(static_cast<const char*>(payload.getBlob()), payload.getBytes());
+            message.type = static_cast<user_profile::utils::event::EventType>(query.getColumn(4).getInt());
+            message.eventId = query.getColumn(5).getText();
+            messages.push_back(std::move(message));
+        }
+    } catch (std::exception &e) {
+        LOG(logger::LogLevel::Error) << "Failed to read the outbox: " << e.what();
+        return std::nullopt;
+    }
+
+    return messages;
+}
+
+bool UserRepository::removeOutbox(const std::vector<std::int64_t>& ids)
+{
+    if (ids.empty()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const connection = m_currentConnection.lock();
+    if (!connection)
+    {
+        LOG(logger::LogLevel::Error) << "Cannot delete outbox rows without a database connection";
+        return false;
+    }
+
+    try {
+        SQLite::Transaction transaction(*connection->connection());
+        SQLite::Statement statement(*connection->connection(), "DELETE FROM Outbox WHERE id = ?");
+        for (const auto id : ids) {
+            statement.bind(1, id);
+            statement.exec();
+            statement.reset();
+        }
+        transaction.commit();
+    } catch (std::exception &e) {
+        LOG(logger::LogLevel::Error) << "Failed to delete " << ids.size() << " outbox rows: " << e.what();
+        return false;
+    }
+
+    return true;
+}
+
+bool UserRepository::writeWithOutbox(const std::string& sql, const OutboxMessage& event)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const connection = m_currentConnection.lock();
+    if (!connection)
+    {
+        LOG(logger::LogLevel::Error) << "Cannot write a user and its event without a database connection";
+        return false;
+    }
+
+    try {
+        SQLite::Transaction transaction(*connection->connection());
+        connection->connection()->exec(sql);
+
+        SQLite::Statement outbox(*connection->connection(),
+            "INSERT INTO Outbox (topic, message_key, payload, event_type, event_id) VALUES (?, ?, ?, ?, ?)");
+        outbox.bind(1, event.topic);
+        outbox.bind(2, event.key);
+        outbox.bind(3, event.payload.data(), static_cast<int>(event.payload.size()));
+        outbox.bind(4, static_cast<int>(event.type));
+        outbox.bind(5, event.eventId);
+        outbox.exec();
+
+        transaction.commit();
+    } catch (std::exception &e) {
+        // The transaction rolls back in its destructor, neither row is kept
+        LOG(logger::LogLevel::Error) << "Failed to write a user and its " << event.topic << " event: " << e.what();
+        return false;
+    }
+
+    return true;
+}
+
+bool UserRepository::applyBatch(const std::vector<User>& upserts, const std::vector<std::string>& removedIds)
+{
+    if (upserts.empty() && removedIds.empty()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const connection = m_currentConnection.lock();
+    if (!connection)
+    {
+        LOG(logger::LogLevel::Error) << "Cannot apply a replayed batch without a database connection";
+        return false;
+    }
+
+    try {
+        // One transaction and one prepared statement per kind, SQLite then syncs once per batch
+        SQLite::Transaction transaction(*connection->connection());
+        SQLite::Statement upsert(*connection->connection(),
+            "INSERT INTO Users (user_id, email, username, created_at, updated_at) VALUES (?, ?, ?, ?, ?) "
+            "ON CONFLICT(user_id) DO UPDATE SET "
+            "email = excluded.email, username = excluded.username, updated_at = excluded.updated_at");
+        for (const auto& user : upserts) {
+            upsert.bind(1, user.getUserId());
+            upsert.bind(2, user.getEmail());
+            upsert.bind(3, user.getUserName());
+            upsert.bind(4, user.getCreateAt());
+            upsert.bind(5, user.getUpdateAt());
+            upsert.exec();
+            upsert.reset();
+        }
+
+        SQLite::Statement remove(*connection->connection(), "DELETE FROM Users WHERE user_id = ?");
+        for (const auto& userId : removedIds) {
+            remove.bind(1, userId);
+            remove.exec();
+            remove.reset();
+        }
+        transaction.commit();
+    } catch (std::exception &e) {
+        LOG(logger::LogLevel::Error) << "Failed to apply a replayed batch, it is rolled back: " << e.what();
+        return false;
+    }
+
+    return true;
+}
+
 void UserRepository::remove(const User& user)
 {
 }
@@ -101,6 +280,7 @@ std::vector<User> UserRepository::getAll()
 
 std::optional<User> UserRepository::findById(const std::string& userId)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto const connection = m_currentConnection.lock();
     if (!connection)
     {
@@ -120,6 +300,7 @@ std::optional<User> UserRepository::findById(const std::string& userId)
 
 std::optional<User> UserRepository::findByUserName(const std::string& userName)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto const connection = m_currentConnection.lock();
     if (!connection)
     {
@@ -139,6 +320,7 @@ std::optional<User> UserRepository::findByUserName(const std::string& userName)
 
 std::optional<User> UserRepository::findByEmail(const std::string& email)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     auto const connection = m_currentConnection.lock();
     if (!connection)
     {
@@ -0,0 +1,157 @@
+/*
+* File: OutboxRelay.cpp
+* Author: trung.la
+* Date: 10-16-2026
+* Description: This is implementation of the relay which publishes outbox rows to Kafka
+*/
+
+#include "OutboxRelay.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "KafkaMessageProducer.h"
+#include "SharedPayload.h"
+#include "IOutboxStore.h"
+#include "logger/LoggerStream.h"
+
+namespace
+{
+    /**
+     * @brief Delivery reports of one relay round
+     * Shared with the delivery callbacks, which may outlive a round that timed out.
+     */
+    struct RelayRound
+    {
+        std::mutex mutex;
+        std::condition_variable done;
+        std::size_t pending = 0;
+        bool failed = false; ///< A delivery failed, the rows after it are not sent this round
+        std::vector<std::int64_t> acked;
+    };
+}
+
+OutboxRelay::OutboxRelay(IOutboxStore& outbox, KafkaMessageProducer& producer)
+    : OutboxRelay(outbox, producer, Options{})
+{
+}
+
+OutboxRelay::OutboxRelay(IOutboxStore& outbox, KafkaMessageProducer& producer, Options options)
+    : mOutbox(outbox)
+    , mProducer(producer)
+    , mOptions(options)
+{
+}
+
+OutboxRelay::~OutboxRelay()
+{
+    stop();
+}
+
+void OutboxRelay::start()
+{
+    if (mRunning.exchange(true)) {
+        return; // Already running
+    }
+    mThread = std::thread(&OutboxRelay::run, this);
+}
+
+void OutboxRelay::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mRunning.exchange(false)) {
+            return;
+        }
+    }
+    mWakeUp.notify_all();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+std::size_t OutboxRelay::relayOnce()
+{
+    auto fetched = mOutbox.fetchOutbox(mOptions.batchSize);
+    if (!fetched.has_value() || fetched->empty()) {
+        return 0; // The repository logged why it could not read, the next round tries again
+    }
+    auto& rows = *fetched;
+
+    auto round = std::make_shared<RelayRound>();
+    auto publish = [this, &rows, &round]() {
+        for (auto& row : rows) {
+            {
+                std::lock_guard<std::mutex> lock(round->mutex);
+                if (round->failed) {
+                    return false; // Sent again from the failed row on, after the rows in front of it
+                }
+                ++round->pending;
+            }
+
+            const auto id = row.id;
+            const bool queued = mProducer.sendEvent(row.topic, row.key, row.type, row.eventId,
+                SharedPayload::fromString(std::move(row.payload)),
+                [round, id](bool delivered) {
+                    std::lock_guard<std::mutex> lock(round->mutex);
+                    if (delivered) {
+                        round->acked.push_back(id);
+                    } else {
+                        round->failed = true;
+                    }
+                    --round->pending;
+                    round->done.notify_all();
+                });
+
+            if (!queued) {
+                std::lock_guard<std::mutex> lock(round->mutex);
+                --round->pending;
+                return false; // Refused, this row and the rest are sent by the next round
+            }
+        }
+        return true;
+    };
+
+    std::vector<std::int64_t> published;
+    if (mProducer.isTransactional()) {
+        // The commit makes the whole round visible at once, or none of it
+        if (mProducer.runInTransaction(publish)) {
+            published.reserve(rows.size());
+            for (const auto& row : rows) {
+                published.push_back(row.id);
+            }
+        }
+    } else {
+        publish();
+        std::unique_lock<std::mutex> lock(round->mutex);
+        round->done.wait_for(lock, mOptions.ackTimeout, [&round] { return round->pending == 0; });
+
+        // Delivery reports come in any order; a row acknowledged behind a missing one stays, so
+        // the next round resends it after the missing one and the broker ends with them in order
+        std::sort(round->acked.begin(), round->acked.end());
+        for (std::size_t i = 0; i < round->acked.size() && round->acked[i] == rows[i].id; ++i) {
+            published.push_back(rows[i].id);
+        }
+    }
+
+    if (!mOutbox.removeOutbox(published)) {
+        LOG(logger::LogLevel::Error) << "Failed to delete " << published.size()
+                                     << " published outbox rows, they are sent again";
+        return 0;
+    }
+    return published.size();
+}
+
+void OutboxRelay::run()
+{
+    while (mRunning.load()) {
+        const std::size_t published = relayOnce();
+        if (published >= mOptions.batchSize) {
+            continue; // Backlog, keep draining
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait_for(lock, mOptions.idleInterval, [this] { return !mRunning.load(); });
+    }
+}
@@ -7,18 +7,45 @@
 
 #include "UserProfileService.h"
 
+#include "bus/KafkaMessageBus.h"
+#include "logger/LoggerStream.h"
+
 UserProfileService::UserProfileService()
+    : UserProfileService(ServiceConfig{}, std::make_shared<KafkaMessageBus>(ServiceConfig{}))
+{
+}
+
+UserProfileService::UserProfileService(const ServiceConfig& config, std::shared_ptr<IMessageBus> bus)
+    : mConfig(config)
+    , mProducer(mConfig, std::move(bus))
+    , mRelay(mRepository, mProducer)
 {
 }
 
 UserProfileService::~UserProfileService()
 {
+    stop();
 }
 
-void UserProfileService::start()
+bool UserProfileService::start()
 {
+    mRepository.selectConnection(user_profile::utils::database::ConnectionType::eSQLite);
+    mRepository.createTable();
+    if (!mProducer.initialize()) {
+        LOG(logger::LogLevel::Error) << "Cannot start the outbox relay, the producer failed to initialize";
+        return false;
+    }
+    mRelay.start();
+    return true;
 }
 
 void UserProfileService::stop()
 {
-}
\ No newline at end of file
+    mRelay.stop();
+    mProducer.flush();
+}
+
+UserRepository& UserProfileService::getRepository()
+{
+    return mRepository;
+}
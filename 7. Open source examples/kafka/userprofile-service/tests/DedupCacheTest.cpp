@@ -0,0 +1,150 @@
+/**
+ * @file DedupCacheTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests what DedupCache remembers and what it evicts
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "DedupCache.h"
+#include "ShardRouter.h"
+
+namespace
+{
+    Event eventWithId(const std::string& id)
+    {
+        Event event(Event::EventType::eUserUpdated);
+        event.setId(id);
+        return event;
+    }
+
+    std::size_t stripeOf(const std::string& id)
+    {
+        return ShardRouter::hashKey("i:" + id) % DedupCache::kStripes; // the key DedupCache hashes
+    }
+
+    /**
+     * @brief Event IDs of equal length, the first count of them in one stripe
+     */
+    std::vector<std::string> idsInOneStripe(std::size_t count)
+    {
+        std::vector<std::string> ids;
+        char id[16];
+        for (int i = 0; ids.size() < count; ++i) {
+            std::snprintf(id, sizeof(id), "event-%06d", i);
+            if (ids.empty() || stripeOf(id) == stripeOf(ids.front())) {
+                ids.emplace_back(id);
+            }
+        }
+        return ids;
+    }
+
+    std::string idInAnotherStripe(const std::string& other)
+    {
+        char id[16];
+        for (int i = 0;; ++i) {
+            std::snprintf(id, sizeof(id), "other-%06d", i);
+            if (stripeOf(id) != stripeOf(other)) {
+                return id;
+            }
+        }
+    }
+
+    /**
+     * @brief A cache whose stripes hold exactly perStripe entries of the IDs above
+     */
+    std::size_t boundFor(std::size_t perStripe)
+    {
+        DedupCache probe(1 << 20);
+        probe.testAndInsert(eventWithId("event-000000"));
+        return DedupCache::kStripes * perStripe * probe.stats().bytes;
+    }
+}
+
+TEST(DedupCacheTest, StripeEvictsItsOldestEntryAtCapacity)
+{
+    const auto ids = idsInOneStripe(4);
+    const auto other = idInAnotherStripe(ids.front());
+    DedupCache cache(boundFor(3));
+
+    EXPECT_FALSE(cache.testAndInsert(eventWithId(other)));
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_FALSE(cache.testAndInsert(eventWithId(ids[i])));
+    }
+    EXPECT_EQ(cache.stats().evictions, 0u);
+
+    EXPECT_FALSE(cache.testAndInsert(eventWithId(ids[3]))); // the stripe is full, ids[0] goes
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_EQ(cache.stats().entries, 4u);
+
+    EXPECT_TRUE(cache.testAndInsert(eventWithId(ids[2])));
+    EXPECT_TRUE(cache.testAndInsert(eventWithId(other))); // the other stripe kept its entry
+    EXPECT_FALSE(cache.testAndInsert(eventWithId(ids[0]))); // forgotten, handled again
+}
+
+TEST(DedupCacheTest, HitRefreshesRecency)
+{
+    const auto ids = idsInOneStripe(4);
+    DedupCache cache(boundFor(3));
+    for (std::size_t i = 0; i < 3; ++i) {
+        cache.testAndInsert(eventWithId(ids[i]));
+    }
+
+    EXPECT_TRUE(cache.testAndInsert(eventWithId(ids[0]))); // now the most recent
+    EXPECT_FALSE(cache.testAndInsert(eventWithId(ids[3]))); // evicts ids[1], the oldest
+
+    EXPECT_TRUE(cache.testAndInsert(eventWithId(ids[0])));
+    EXPECT_TRUE(cache.testAndInsert(eventWithId(ids[2])));
+    EXPECT_TRUE(cache.testAndInsert(eventWithId(ids[3])));
+    EXPECT_FALSE(cache.testAndInsert(eventWithId(ids[1])));
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.misses, 5u);
+}
+
+TEST(DedupCacheTest, ForgetLetsARedeliveryThrough)
+{
+    const auto ids = idsInOneStripe(4);
+    DedupCache cache(boundFor(3));
+    for (std::size_t i = 0; i < 3; ++i) {
+        cache.testAndInsert(eventWithId(ids[i]));
+    }
+    const auto full = cache.stats();
+
+    cache.forget(eventWithId(ids[1])); // its handlers failed
+    cache.forget(eventWithId("never-seen"));
+    EXPECT_EQ(cache.stats().entries, 2u);
+    EXPECT_LT(cache.stats().bytes, full.bytes);
+
+    EXPECT_FALSE(cache.testAndInsert(eventWithId(ids[3]))); // fits in the room ids[1] left
+    EXPECT_EQ(cache.stats().evictions, 0u);
+    EXPECT_TRUE(cache.testAndInsert(eventWithId(ids[0])));
+    EXPECT_FALSE(cache.testAndInsert(eventWithId(ids[1])));
+}
+
+TEST(DedupCacheTest, EventsWithoutIdAreKnownByTheirPosition)
+{
+    DedupCache cache(1 << 20);
+    Event event(Event::EventType::eUserUpdated);
+    event.setSource("user-events", 3, 42);
+    EXPECT_FALSE(cache.testAndInsert(event));
+    EXPECT_TRUE(cache.testAndInsert(event));
+
+    Event next(Event::EventType::eUserUpdated);
+    next.setSource("user-events", 3, 43);
+    EXPECT_FALSE(cache.testAndInsert(next));
+
+    // With an ID the position does not matter, a producer retry lands at another offset
+    Event retried = eventWithId("event-1");
+    retried.setSource("user-events", 3, 44);
+    EXPECT_FALSE(cache.testAndInsert(retried));
+    retried.setSource("user-events", 3, 45);
+    EXPECT_TRUE(cache.testAndInsert(retried));
+}
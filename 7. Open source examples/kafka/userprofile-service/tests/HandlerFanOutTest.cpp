@@ -0,0 +1,114 @@
+/**
+ * @file HandlerFanOutTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests how HandlerFanOut treats a handler which overran its timeout
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "HandlerFanOut.h"
+
+namespace
+{
+    /**
+     * @brief Handler whose first batch takes longer than its timeout
+     */
+    class SlowFirstBatchHandler : public Handler
+    {
+    public:
+        bool handleEvent(const Event&) override
+        {
+            return true;
+        }
+
+        std::vector<std::size_t> handleEvents(std::span<const Event>) override
+        {
+            if (mBatches.fetch_add(1) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            }
+            return {};
+        }
+
+        std::atomic<int> mBatches{0};
+    };
+
+    /**
+     * @brief Handler which handles everything at once
+     */
+    class FastHandler : public Handler
+    {
+    public:
+        bool handleEvent(const Event&) override
+        {
+            return true;
+        }
+    };
+}
+
+TEST(HandlerFanOutTest, OverrunningHandlerIsBusyUntilItFinished)
+{
+    const auto slow = std::make_shared<SlowFirstBatchHandler>();
+    const auto fast = std::make_shared<FastHandler>();
+    HandlerFanOut fanOut;
+    fanOut.add(slow, HandlerFanOut::Options{"slow", std::chrono::milliseconds(20)});
+    fanOut.add(fast, HandlerFanOut::Options{"fast"});
+    fanOut.start(2);
+
+    const HandlerFanOut::Handlers handlers{slow, fast};
+    const std::vector<Event> events(3, Event(Event::EventType::eUserUpdated));
+
+    auto failed = fanOut.run(handlers, events);
+    EXPECT_EQ(failed[0].size(), 3u); // timed out
+    EXPECT_TRUE(failed[1].empty());
+
+    // The first batch still runs: the next one fails without reaching the handler, and so does a retry
+    failed = fanOut.run(handlers, events);
+    EXPECT_EQ(failed[0].size(), 3u);
+    EXPECT_EQ(slow->mBatches.load(), 1);
+    EXPECT_FALSE(fanOut.handleRetry(slow, events[0]));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_TRUE(fanOut.handleRetry(slow, events[0]));
+    failed = fanOut.run(handlers, events);
+    EXPECT_TRUE(failed[0].empty());
+    EXPECT_EQ(slow->mBatches.load(), 2);
+    EXPECT_EQ(fanOut.stats()[0].timeouts, 2u);
+}
+
+TEST(HandlerFanOutTest, LoneHandlerTimesOutOnThePool)
+{
+    const auto slow = std::make_shared<SlowFirstBatchHandler>();
+    HandlerFanOut fanOut;
+    fanOut.add(slow, HandlerFanOut::Options{"slow", std::chrono::milliseconds(20)});
+    fanOut.start(1);
+
+    const std::vector<Event> events(2, Event(Event::EventType::eUserUpdated));
+    const auto startedAt = std::chrono::steady_clock::now();
+    const auto failed = fanOut.run({slow}, events);
+    EXPECT_LT(std::chrono::steady_clock::now() - startedAt, std::chrono::milliseconds(150));
+    EXPECT_EQ(failed[0].size(), 2u);
+    EXPECT_EQ(fanOut.stats()[0].timeouts, 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_TRUE(fanOut.run({slow}, events)[0].empty());
+}
+
+TEST(HandlerFanOutTest, TimeoutIsNotEnforcedWithoutPool)
+{
+    const auto slow = std::make_shared<SlowFirstBatchHandler>();
+    HandlerFanOut fanOut;
+    fanOut.add(slow, HandlerFanOut::Options{"slow", std::chrono::milliseconds(20)});
+    fanOut.start(0);
+
+    // The calling thread runs the handler and cannot give up on it
+    const std::vector<Event> events(2, Event(Event::EventType::eUserUpdated));
+    EXPECT_TRUE(fanOut.run({slow}, events)[0].empty());
+    EXPECT_EQ(fanOut.stats()[0].timeouts, 0u);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file HandlerLaneTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests when HandlerLane reports a spilled batch as done
+ */
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "HandlerLane.h"
+
+namespace
+{
+    class HandlerLaneTest : public ::testing::Test
+    {
+    protected:
+        HandlerLaneTest()
+            // ctest runs every test in its own process, at the same time with -j
+            : mDirectory(std::filesystem::temp_directory_path() / "handler-lane-test" /
+                  ::testing::UnitTest::GetInstance()->current_test_info()->name())
+        {
+            std::filesystem::remove_all(mDirectory);
+        }
+
+        ~HandlerLaneTest() override
+        {
+            std::filesystem::remove_all(mDirectory);
+        }
+
+        std::size_t filesOnDisk() const
+        {
+            std::size_t files = 0;
+            for (const auto& entry : std::filesystem::directory_iterator(mDirectory)) {
+                files += entry.is_regular_file() ? 1 : 0;
+            }
+            return files;
+        }
+
+        std::filesystem::path mDirectory;
+    };
+}
+
+TEST_F(HandlerLaneTest, SpilledBatchIsDoneOnlyOnceHandled)
+{
+    std::promise<void> release;
+    const std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> batches{0};
+    HandlerLane lane(HandlerLane::Options{1, 1, HandlerLane::Overflow::eSpill, mDirectory},
+        [&](std::span<const Event>) {
+            if (batches.fetch_add(1) == 0) {
+                released.wait();
+            }
+            return std::vector<std::size_t>{0};
+        });
+
+    const std::vector<Event> events(1, Event(Event::EventType::eUserUpdated));
+    std::mutex mutex;
+    std::vector<int> done;
+    auto doneFor = [&](int batch) {
+        return [&, batch](std::vector<std::size_t> failed) {
+            EXPECT_EQ(failed, std::vector<std::size_t>{0});
+            std::lock_guard<std::mutex> lock(mutex);
+            done.push_back(batch);
+        };
+    };
+
+    lane.submit(events, doneFor(0));
+    while (batches.load() == 0) {
+        std::this_thread::yield(); // the worker holds the first batch, the queue is empty again
+    }
+    lane.submit(events, doneFor(1)); // queued
+    lane.submit(events, doneFor(2)); // spilled, the queue is full
+    EXPECT_EQ(lane.spillDepth(), 1u);
+    EXPECT_EQ(filesOnDisk(), 1u);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_TRUE(done.empty()); // the spilled batch is not done before the handler had it
+    }
+
+    release.set_value();
+    lane.drain(); // covers the spilled batch too
+    EXPECT_EQ(done, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(lane.spillDepth(), 0u);
+    EXPECT_EQ(filesOnDisk(), 0u);
+}
+
+TEST_F(HandlerLaneTest, SpillFilesOfPreviousRunAreRemoved)
+{
+    std::filesystem::create_directories(mDirectory);
+    std::ofstream(mDirectory / "00000000000000000000.spill") << "left behind";
+
+    std::atomic<int> batches{0};
+    HandlerLane lane(HandlerLane::Options{1, 1, HandlerLane::Overflow::eSpill, mDirectory},
+        [&](std::span<const Event>) {
+            batches.fetch_add(1);
+            return std::vector<std::size_t>{};
+        });
+    lane.drain();
+
+    EXPECT_EQ(filesOnDisk(), 0u);
+    EXPECT_EQ(batches.load(), 0); // the broker redelivers them, they were never committed
+}
@@ -0,0 +1,237 @@
+/**
+ * @file KafkaMessageProducerTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests KafkaMessageProducer against the in-process broker stand-in
+ */
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "KafkaMessageProducer.h"
+#include "ProducerPool.h"
+#include "bus/InProcessMessageBus.h"
+#include "const/KafkaConst.h"
+
+namespace
+{
+    const std::string kTopic = "user-events";
+
+    class KafkaMessageProducerTest : public ::testing::Test
+    {
+    protected:
+        KafkaMessageProducerTest()
+            : mBus(std::make_shared<InProcessMessageBus>(InProcessMessageBus::Options{}))
+        {
+            mBus->createTopic(kTopic, 1);
+            mConfig.setKafkaTransactionalId("userprofile-test");
+        }
+
+        /**
+         * @brief Read every committed record of the topic with a read_committed consumer
+         */
+        std::vector<std::string> committedValues()
+        {
+            auto consumer = mBus->createConsumer("", 100);
+            consumer->assign({{kTopic, 0}});
+            std::vector<std::string> values;
+            while (true) {
+                const auto batch = consumer->poll(std::chrono::milliseconds(10));
+                if (batch->empty()) {
+                    return values;
+                }
+                for (const auto& record : batch->records()) {
+                    values.emplace_back(record.value.view());
+                }
+            }
+        }
+
+        std::shared_ptr<InProcessMessageBus> mBus;
+        ServiceConfig mConfig;
+    };
+}
+
+TEST_F(KafkaMessageProducerTest, CommittedTransactionBecomesVisibleAtOnce)
+{
+    KafkaMessageProducer producer(mConfig, mBus);
+    ASSERT_TRUE(producer.initialize());
+    ASSERT_TRUE(producer.isTransactional());
+
+    const bool committed = producer.runInTransaction([&] {
+        EXPECT_TRUE(producer.sendMessage(kTopic, "a", "1"));
+        EXPECT_TRUE(producer.sendMessage(kTopic, "b", "2"));
+        EXPECT_TRUE(producer.flush());
+        EXPECT_TRUE(committedValues().empty()); // Sent, but the transaction is still open
+        return true;
+    });
+
+    EXPECT_TRUE(committed);
+    EXPECT_EQ(committedValues(), (std::vector<std::string>{"1", "2"}));
+}
+
+TEST_F(KafkaMessageProducerTest, AbortedTransactionIsNeverConsumed)
+{
+    KafkaMessageProducer producer(mConfig, mBus);
+    ASSERT_TRUE(producer.initialize());
+
+    EXPECT_FALSE(producer.runInTransaction([&] {
+        EXPECT_TRUE(producer.sendMessage(kTopic, "a", "1"));
+        EXPECT_TRUE(producer.flush());
+        return false;
+    }));
+    EXPECT_TRUE(producer.runInTransaction([&] { return producer.sendMessage(kTopic, "b", "2"); }));
+
+    EXPECT_EQ(committedValues(), std::vector<std::string>{"2"});
+}
+
+TEST_F(KafkaMessageProducerTest, SendOutsideTransactionIsRefused)
+{
+    KafkaMessageProducer producer(mConfig, mBus);
+    ASSERT_TRUE(producer.initialize());
+
+    EXPECT_FALSE(producer.sendMessage(kTopic, "a", "1"));
+    EXPECT_TRUE(committedValues().empty());
+}
+
+TEST_F(KafkaMessageProducerTest, OtherThreadCannotSendIntoOpenTransaction)
+{
+    KafkaMessageProducer producer(mConfig, mBus);
+    ASSERT_TRUE(producer.initialize());
+
+    // Another thread sends while the transaction is open; its record must neither join the
+    // transaction nor be dropped silently by the abort
+    EXPECT_FALSE(producer.runInTransaction([&] {
+        EXPECT_TRUE(producer.sendMessage(kTopic, "a", "inside"));
+        auto foreign = std::async(std::launch::async, [&] { return producer.sendMessage(kTopic, "b", "foreign"); });
+        EXPECT_FALSE(foreign.get());
+        return false;
+    }));
+
+    EXPECT_TRUE(committedValues().empty());
+    EXPECT_EQ(producer.metricsSnapshot().budget.records, 0u);
+}
+
+TEST_F(KafkaMessageProducerTest, NewProducerFencesOldOne)
+{
+    KafkaMessageProducer oldProducer(mConfig, mBus);
+    ASSERT_TRUE(oldProducer.initialize());
+    KafkaMessageProducer newProducer(mConfig, mBus);
+    ASSERT_TRUE(newProducer.initialize());
+
+    EXPECT_FALSE(oldProducer.runInTransaction([&] { return oldProducer.sendMessage(kTopic, "a", "old"); }));
+    EXPECT_TRUE(newProducer.runInTransaction([&] { return newProducer.sendMessage(kTopic, "a", "new"); }));
+
+    EXPECT_EQ(committedValues(), std::vector<std::string>{"new"});
+}
+
+TEST_F(KafkaMessageProducerTest, EvictionFreesTheExhaustedRecordCount)
+{
+    // The byte budget has room, only the record count is exhausted: one queued record makes room
+    ServiceConfig config;
+    config.setProducerInFlightBudget(1 << 20, 3);
+    config.setProducerBackpressurePolicy(ServiceConfig::BackpressurePolicy::eDropLowestPriority, 0);
+    config.setProducerLingerMs(60000);
+    config.setTopicPriority(kTopic, 10);
+    KafkaMessageProducer producer(config, mBus);
+    ASSERT_TRUE(producer.initialize());
+
+    for (const std::string topic : {"audit-a", "audit-b", "audit-c"}) {
+        ASSERT_TRUE(producer.sendMessage(topic, "k", "1"));
+    }
+    EXPECT_TRUE(producer.sendMessage(kTopic, "k", std::string(256, 'x')));
+
+    EXPECT_EQ(producer.metricsSnapshot().budget.dropped, 1u);
+    EXPECT_TRUE(producer.flush());
+}
+
+TEST_F(KafkaMessageProducerTest, EvictionNeverDropsRecordsOfOpenTransaction)
+{
+    mConfig.setProducerInFlightBudget(1 << 20, 1);
+    mConfig.setProducerBackpressurePolicy(ServiceConfig::BackpressurePolicy::eDropLowestPriority, 0);
+    mConfig.setProducerLingerMs(60000);
+    mConfig.setTopicPriority("audit", 0);
+    mConfig.setTopicPriority(kTopic, 10);
+    KafkaMessageProducer producer(mConfig, mBus);
+    ASSERT_TRUE(producer.initialize());
+
+    EXPECT_TRUE(producer.runInTransaction([&] {
+        EXPECT_TRUE(producer.sendMessage("audit", "k", "low"));
+        EXPECT_FALSE(producer.sendMessage(kTopic, "k", "high"));
+        return true;
+    }));
+
+    EXPECT_EQ(producer.metricsSnapshot().budget.dropped, 0u);
+    EXPECT_TRUE(committedValues().empty());
+}
+
+TEST_F(KafkaMessageProducerTest, SendEventSetsTypeAndIdHeaders)
+{
+    KafkaMessageProducer producer(ServiceConfig{}, mBus);
+    ASSERT_TRUE(producer.initialize());
+    ASSERT_TRUE(producer.sendEvent(kTopic, "user-1", Event::EventType::eUserDeleted, "event-7",
+        SharedPayload::fromString("payload")));
+    ASSERT_TRUE(producer.sendEvent(kTopic, "user-1", Event::EventType::eUserUpdated, "",
+        SharedPayload::fromString("payload")));
+    ASSERT_TRUE(producer.flush());
+
+    auto consumer = mBus->createConsumer("", 10);
+    consumer->assign({{kTopic, 0}});
+    const auto batch = consumer->poll(std::chrono::milliseconds(10));
+    ASSERT_EQ(batch->size(), 2u);
+    const auto headersOf = [&batch](std::size_t index) {
+        const auto headers = batch->headers(batch->records()[index]);
+        return IMessageBus::Headers(headers.begin(), headers.end());
+    };
+    EXPECT_EQ(headersOf(0), (IMessageBus::Headers{{kafka_const::kEventTypeHeader, "3"},
+        {kafka_const::kEventIdHeader, "event-7"}}));
+    EXPECT_EQ(headersOf(1), (IMessageBus::Headers{{kafka_const::kEventTypeHeader, "2"}}));
+}
+
+TEST_F(KafkaMessageProducerTest, ProducerPoolRefusesTransactionalConfig)
+{
+    mConfig.setProducerShards(2);
+    ProducerPool transactional(mConfig, mBus);
+    EXPECT_FALSE(transactional.initialize());
+    EXPECT_FALSE(transactional.sendMessage(kTopic, "user-1", "refused"));
+
+    mConfig.setKafkaTransactionalId("");
+    ProducerPool pool(mConfig, mBus);
+    ASSERT_TRUE(pool.initialize());
+    EXPECT_TRUE(pool.sendMessage(kTopic, "user-1", "sent"));
+    EXPECT_TRUE(pool.flush());
+}
+
+TEST(InProcessMessageBusTest, OpenTransactionHoldsBackLaterRecords)
+{
+    InProcessMessageBus bus(InProcessMessageBus::Options{});
+    bus.createTopic(kTopic, 1);
+    auto transactional = bus.createProducer({"", "tx", false});
+    auto plain = bus.createProducer({});
+    ASSERT_TRUE(transactional->initTransactions());
+    ASSERT_TRUE(transactional->beginTransaction());
+
+    IMessageBus::Record record;
+    record.topic = kTopic;
+    record.value = SharedPayload::fromString("in-transaction");
+    ASSERT_TRUE(transactional->publish(record, {}));
+    record.value = SharedPayload::fromString("plain");
+    ASSERT_TRUE(plain->publish(record, {}));
+
+    auto consumer = bus.createConsumer("", 10);
+    consumer->assign({{kTopic, 0}});
+    EXPECT_TRUE(consumer->poll(std::chrono::milliseconds(10))->empty());
+    EXPECT_EQ(consumer->endOffsets({{kTopic, 0}}).at({kTopic, 0}), 0);
+
+    ASSERT_TRUE(transactional->commitTransaction());
+    const auto batch = consumer->poll(std::chrono::milliseconds(10));
+    ASSERT_EQ(batch->size(), 2u);
+    EXPECT_EQ(batch->records()[0].value.view(), "in-transaction");
+    EXPECT_EQ(batch->records()[1].value.view(), "plain");
+    EXPECT_EQ(consumer->position({kTopic, 0}), 3); // past the commit marker
+}
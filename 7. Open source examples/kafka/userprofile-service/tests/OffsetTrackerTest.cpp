@@ -0,0 +1,164 @@
+/**
+ * @file OffsetTrackerTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests which offsets OffsetTracker lets the consumer commit
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "OffsetTracker.h"
+
+namespace
+{
+    const std::string kTopic = "user-events";
+    const OffsetTracker::TopicPartition kFirst{kTopic, 0};
+    const OffsetTracker::TopicPartition kSecond{kTopic, 1};
+
+    OffsetTracker::Options cadence(std::size_t commitEveryRecords)
+    {
+        OffsetTracker::Options options;
+        options.commitEveryRecords = commitEveryRecords;
+        options.commitInterval = std::chrono::hours(1);
+        return options;
+    }
+
+    void track(OffsetTracker& tracker, const OffsetTracker::TopicPartition& partition, std::int64_t first,
+        std::int64_t last)
+    {
+        for (auto offset = first; offset <= last; ++offset) {
+            tracker.track(partition.first, partition.second, offset);
+        }
+    }
+
+    Event eventAt(const OffsetTracker::TopicPartition& partition, std::int64_t offset)
+    {
+        Event event(Event::EventType::eUserUpdated);
+        event.setSource(partition.first, partition.second, offset);
+        return event;
+    }
+}
+
+TEST(OffsetTrackerTest, OutOfOrderCompletionHoldsAtTheFirstGap)
+{
+    OffsetTracker tracker(cadence(1));
+    const auto now = OffsetTracker::Clock::now();
+    track(tracker, kFirst, 10, 14);
+
+    tracker.complete(kTopic, 0, 12);
+    tracker.complete(kTopic, 0, 14);
+    tracker.complete(kTopic, 0, 11);
+    EXPECT_TRUE(tracker.takeCommittable(now).empty()); // 10 is still running
+    EXPECT_EQ(tracker.pendingRecords(), 5u);
+
+    tracker.complete(kTopic, 0, 10);
+    EXPECT_EQ(tracker.takeCommittable(now), (OffsetTracker::Offsets{{kFirst, 13}})); // held at 13
+    EXPECT_EQ(tracker.pendingRecords(), 2u);
+
+    tracker.complete(kTopic, 0, 13);
+    EXPECT_EQ(tracker.takeCommittable(now), (OffsetTracker::Offsets{{kFirst, 15}}));
+    EXPECT_EQ(tracker.pendingRecords(), 0u);
+}
+
+TEST(OffsetTrackerTest, BatchCompletionMatchesSingleCompletion)
+{
+    OffsetTracker tracker(cadence(1));
+    track(tracker, kFirst, 0, 3);
+    track(tracker, kSecond, 0, 1);
+
+    // Runs of partitions as a poll batch holds them, the second partition out of order
+    const std::vector<Event> events{eventAt(kFirst, 1), eventAt(kFirst, 0), eventAt(kSecond, 1),
+        eventAt(kFirst, 3)};
+    tracker.complete(events);
+
+    EXPECT_EQ(tracker.takeCommittable(OffsetTracker::Clock::now()), (OffsetTracker::Offsets{{kFirst, 2}}));
+    EXPECT_EQ(tracker.pendingRecords(), 4u); // done records wait behind a gap until it closes
+}
+
+TEST(OffsetTrackerTest, TrackIgnoresRedeliveredOffsets)
+{
+    OffsetTracker tracker(cadence(1));
+    const auto now = OffsetTracker::Clock::now();
+    track(tracker, kFirst, 0, 2);
+
+    tracker.track(kTopic, 0, 1); // still in flight
+    tracker.track(kTopic, 0, 2);
+    EXPECT_EQ(tracker.pendingRecords(), 3u);
+
+    track(tracker, kFirst, 0, 2);
+    tracker.complete(kTopic, 0, 0);
+    tracker.complete(kTopic, 0, 1);
+    tracker.complete(kTopic, 0, 2);
+    EXPECT_EQ(tracker.pendingRecords(), 0u);
+    EXPECT_EQ(tracker.takeCommittable(now), (OffsetTracker::Offsets{{kFirst, 3}}));
+
+    // Redelivered after a seek, every record was handled already and is not waited for again
+    track(tracker, kFirst, 0, 2);
+    EXPECT_EQ(tracker.pendingRecords(), 0u);
+    track(tracker, kFirst, 3, 3);
+    EXPECT_EQ(tracker.pendingRecords(), 1u);
+
+    tracker.complete(kTopic, 0, 3);
+    tracker.complete(kTopic, 0, 3); // completed twice
+    EXPECT_EQ(tracker.pendingRecords(), 0u);
+    EXPECT_EQ(tracker.takeCommittable(now), (OffsetTracker::Offsets{{kFirst, 4}}));
+}
+
+TEST(OffsetTrackerTest, TakeCommittableReturnsEachAdvanceOnce)
+{
+    OffsetTracker tracker(cadence(2));
+    const auto now = OffsetTracker::Clock::now();
+    track(tracker, kFirst, 0, 2);
+    track(tracker, kSecond, 5, 5);
+
+    EXPECT_FALSE(tracker.commitDue(now));
+    tracker.complete(kTopic, 0, 0);
+    EXPECT_FALSE(tracker.commitDue(now)); // one record of two
+    tracker.complete(kTopic, 1, 5);
+    EXPECT_TRUE(tracker.commitDue(now));
+
+    const OffsetTracker::Offsets first{{kFirst, 1}, {kSecond, 6}};
+    EXPECT_EQ(tracker.takeCommittable(now), first);
+    EXPECT_FALSE(tracker.commitDue(now));
+    EXPECT_TRUE(tracker.takeCommittable(now).empty());
+    EXPECT_EQ(tracker.committed(), first);
+
+    // Only the partition which moved is returned
+    tracker.complete(kTopic, 0, 1);
+    EXPECT_EQ(tracker.takeCommittable(now), (OffsetTracker::Offsets{{kFirst, 2}}));
+    EXPECT_EQ(tracker.committed(), (OffsetTracker::Offsets{{kFirst, 2}, {kSecond, 6}}));
+
+    // The interval makes a commit due without the record count
+    tracker.complete(kTopic, 0, 2);
+    EXPECT_FALSE(tracker.commitDue(now));
+    EXPECT_TRUE(tracker.commitDue(now + std::chrono::hours(1)));
+}
+
+TEST(OffsetTrackerTest, ForgetDropsARevokedPartition)
+{
+    OffsetTracker tracker(cadence(1));
+    const auto now = OffsetTracker::Clock::now();
+    track(tracker, kFirst, 0, 3);
+    track(tracker, kSecond, 0, 3);
+    tracker.complete(kTopic, 1, 0);
+    EXPECT_EQ(tracker.takeCommittable(now), (OffsetTracker::Offsets{{kSecond, 1}}));
+
+    tracker.forget({kSecond});
+    EXPECT_EQ(tracker.pendingRecords(), 4u);
+    EXPECT_TRUE(tracker.committed().empty());
+
+    // A handler finishing a record of the revoked partition late commits nothing for it
+    tracker.complete(kTopic, 1, 1);
+    tracker.complete(kTopic, 0, 0);
+    EXPECT_EQ(tracker.takeCommittable(now), (OffsetTracker::Offsets{{kFirst, 1}}));
+
+    // Assigned again, the partition starts over from the records polled then
+    track(tracker, kSecond, 1, 2);
+    EXPECT_EQ(tracker.pendingRecords(), 5u);
+    tracker.complete(kTopic, 1, 1);
+    EXPECT_EQ(tracker.takeCommittable(now), (OffsetTracker::Offsets{{kSecond, 2}}));
+}
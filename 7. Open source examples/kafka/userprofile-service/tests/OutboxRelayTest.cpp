@@ -0,0 +1,265 @@
+/**
+ * @file OutboxRelayTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests which outbox rows OutboxRelay deletes when a delivery fails
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "IOutboxStore.h"
+#include "KafkaMessageProducer.h"
+#include "OutboxRelay.h"
+#include "bus/InProcessMessageBus.h"
+#include "const/KafkaConst.h"
+
+namespace
+{
+    const std::string kTopic = "user-events";
+
+    /**
+     * @brief Outbox table stand-in, rows are read in id order like UserRepository does
+     */
+    class MemoryOutbox : public IOutboxStore
+    {
+    public:
+        void add(const std::string& key, const std::string& eventId)
+        {
+            OutboxMessage row;
+            row.id = ++mLastId;
+            row.topic = kTopic;
+            row.key = key;
+            row.payload = "payload-" + eventId;
+            row.type = user_profile::utils::event::EventType::eUserUpdated;
+            row.eventId = eventId;
+            mRows[row.id] = row;
+        }
+
+        std::vector<std::int64_t> ids() const
+        {
+            std::vector<std::int64_t> ids;
+            for (const auto& [id, row] : mRows) {
+                ids.push_back(id);
+            }
+            return ids;
+        }
+
+        std::optional<std::vector<OutboxMessage>> fetchOutbox(std::size_t limit) override
+        {
+            std::vector<OutboxMessage> rows;
+            for (auto it = mRows.begin(); it != mRows.end() && rows.size() < limit; ++it) {
+                rows.push_back(it->second);
+            }
+            return rows;
+        }
+
+        bool removeOutbox(const std::vector<std::int64_t>& ids) override
+        {
+            for (const auto id : ids) {
+                mRows.erase(id);
+            }
+            return true;
+        }
+
+    private:
+        std::int64_t mLastId = 0;
+        std::map<std::int64_t, OutboxMessage> mRows;
+    };
+
+    /**
+     * @brief In-process bus whose producers report the first delivery of chosen events as failed
+     */
+    class FailingBus : public IMessageBus
+    {
+    public:
+        FailingBus()
+            : mBus(InProcessMessageBus::Options{})
+        {
+        }
+
+        void failOnce(const std::string& eventId)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFailing.insert(eventId);
+        }
+
+        bool createTopic(const std::string& topic, std::int32_t partitions) override
+        {
+            return mBus.createTopic(topic, partitions);
+        }
+
+        std::unique_ptr<Producer> createProducer(const ProducerOptions& options) override
+        {
+            return std::make_unique<FailingProducer>(*this, mBus.createProducer(options));
+        }
+
+        std::unique_ptr<Consumer> createConsumer(const std::string& groupId, std::size_t maxPollRecords) override
+        {
+            return mBus.createConsumer(groupId, maxPollRecords);
+        }
+
+    private:
+        class FailingProducer : public Producer
+        {
+        public:
+            FailingProducer(FailingBus& bus, std::unique_ptr<Producer> producer)
+                : mBus(bus)
+                , mProducer(std::move(producer))
+            {
+            }
+
+            bool publish(Record record, DeliveryCallback onDelivery) override
+            {
+                if (mBus.takeFailure(record)) {
+                    onDelivery(record, false);
+                    return true;
+                }
+                return mProducer->publish(std::move(record), std::move(onDelivery));
+            }
+
+            bool flush() override { return mProducer->flush(); }
+            bool initTransactions() override { return mProducer->initTransactions(); }
+            bool beginTransaction() override { return mProducer->beginTransaction(); }
+            bool commitTransaction() override { return mProducer->commitTransaction(); }
+            bool abortTransaction() override { return mProducer->abortTransaction(); }
+
+        private:
+            FailingBus& mBus;
+            std::unique_ptr<Producer> mProducer;
+        };
+
+        bool takeFailure(const Record& record)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const auto& [name, value] : record.headers) {
+                if (name == kafka_const::kEventIdHeader) {
+                    return mFailing.erase(value) != 0;
+                }
+            }
+            return false;
+        }
+
+        InProcessMessageBus mBus;
+        std::mutex mMutex;
+        std::set<std::string> mFailing;
+    };
+
+    class OutboxRelayTest : public ::testing::Test
+    {
+    protected:
+        OutboxRelayTest()
+            : mBus(std::make_shared<FailingBus>())
+        {
+            mBus->createTopic(kTopic, 1);
+        }
+
+        /**
+         * @brief Read the event IDs of every record of the topic in offset order
+         */
+        std::vector<std::string> publishedEventIds()
+        {
+            auto consumer = mBus->createConsumer("", 100);
+            consumer->assign({{kTopic, 0}});
+            std::vector<std::string> eventIds;
+            while (true) {
+                const auto batch = consumer->poll(std::chrono::milliseconds(10));
+                if (batch->empty()) {
+                    return eventIds;
+                }
+                for (const auto& record : batch->records()) {
+                    for (const auto& [name, value] : batch->headers(record)) {
+                        if (name == kafka_const::kEventIdHeader) {
+                            eventIds.emplace_back(value);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Keep the last copy of each event, the one a consumer applies last
+         */
+        static std::vector<std::string> lastCopies(const std::vector<std::string>& eventIds)
+        {
+            std::vector<std::string> last;
+            for (auto it = eventIds.rbegin(); it != eventIds.rend(); ++it) {
+                if (std::find(last.begin(), last.end(), *it) == last.end()) {
+                    last.push_back(*it);
+                }
+            }
+            std::reverse(last.begin(), last.end());
+            return last;
+        }
+
+        std::shared_ptr<FailingBus> mBus;
+        ServiceConfig mConfig;
+        MemoryOutbox mOutbox;
+    };
+}
+
+TEST_F(OutboxRelayTest, FailedRowKeepsTheRowsBehindIt)
+{
+    KafkaMessageProducer producer(mConfig, mBus);
+    ASSERT_TRUE(producer.initialize());
+    OutboxRelay relay(mOutbox, producer);
+
+    const std::vector<std::string> events{"e1", "e2", "e3", "e4", "e5"};
+    for (const auto& eventId : events) {
+        mOutbox.add("user-1", eventId);
+    }
+    mBus->failOnce("e3");
+
+    // Rows 4 and 5 may be acknowledged, they still stay behind the failed row 3
+    EXPECT_EQ(relay.relayOnce(), 2u);
+    EXPECT_EQ(mOutbox.ids(), (std::vector<std::int64_t>{3, 4, 5}));
+
+    EXPECT_EQ(relay.relayOnce(), 3u);
+    EXPECT_TRUE(mOutbox.ids().empty());
+    EXPECT_EQ(relay.relayOnce(), 0u);
+
+    const auto published = publishedEventIds();
+    for (const auto& eventId : events) {
+        EXPECT_NE(std::find(published.begin(), published.end(), eventId), published.end()) << eventId;
+    }
+    EXPECT_EQ(lastCopies(published), events);
+}
+
+TEST_F(OutboxRelayTest, EveryRowIsDeliveredInOrderAcrossRounds)
+{
+    KafkaMessageProducer producer(mConfig, mBus);
+    ASSERT_TRUE(producer.initialize());
+    OutboxRelay::Options options;
+    options.batchSize = 4;
+    OutboxRelay relay(mOutbox, producer, options);
+
+    std::vector<std::string> events;
+    for (int i = 1; i <= 10; ++i) {
+        events.push_back("e" + std::to_string(i));
+        mOutbox.add("user-" + std::to_string(i % 3), events.back());
+    }
+    mBus->failOnce("e1");
+    mBus->failOnce("e6");
+    mBus->failOnce("e10");
+
+    std::size_t rounds = 0;
+    while (!mOutbox.ids().empty() && rounds < 20) {
+        relay.relayOnce();
+        ++rounds;
+    }
+
+    EXPECT_TRUE(mOutbox.ids().empty());
+    const auto published = publishedEventIds();
+    EXPECT_GE(published.size(), events.size() + 3); // every failed row was sent again
+    EXPECT_EQ(lastCopies(published), events);
+}
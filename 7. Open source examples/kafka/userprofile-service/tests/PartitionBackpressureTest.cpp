@@ -0,0 +1,246 @@
+/**
+ * @file PartitionBackpressureTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests when PartitionBackpressure pauses and resumes partitions
+ * * The handler threads of a real PartitionDispatcher hold their events until the test releases them,
+ * * so every queue depth below is exact.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "PartitionBackpressure.h"
+#include "PartitionDispatcher.h"
+
+namespace
+{
+    const std::string kTopic = "user-events";
+
+    /**
+     * @brief Lets the handler threads handle one event per permit
+     */
+    class Gate
+    {
+    public:
+        void pass()
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mChanged.wait(lock, [this] { return mOpen || mPermits > 0; });
+            if (!mOpen) {
+                --mPermits;
+            }
+        }
+
+        void release(std::size_t permits)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPermits += permits;
+            mChanged.notify_all();
+        }
+
+        void open()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mOpen = true;
+            mChanged.notify_all();
+        }
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mChanged;
+        std::size_t mPermits = 0;
+        bool mOpen = false;
+    };
+
+    class PartitionBackpressureTest : public ::testing::Test
+    {
+    protected:
+        ~PartitionBackpressureTest() override
+        {
+            mGate.open(); // the dispatcher handles every queued event before it stops
+        }
+
+        void start(PartitionDispatcher::Ordering ordering)
+        {
+            PartitionDispatcher::Options options;
+            options.workers = 2;
+            options.maxBatch = 1; // the event a handler holds is out of the queue
+            options.ordering = ordering;
+            mDispatcher = std::make_unique<PartitionDispatcher>(options,
+                [this](std::size_t, std::vector<Event>&) { mGate.pass(); });
+
+            PartitionBackpressure::Options watermarks;
+            watermarks.highWatermark = 4;
+            watermarks.lowWatermark = 1;
+            mBackpressure = std::make_unique<PartitionBackpressure>(watermarks, *mDispatcher);
+
+            // Consecutive partitions land on consecutive threads, 0 and 2 share one
+            ASSERT_EQ(mDispatcher->workerFor(kTopic, 0), mDispatcher->workerFor(kTopic, 2));
+            ASSERT_NE(mDispatcher->workerFor(kTopic, 0), mDispatcher->workerFor(kTopic, 1));
+        }
+
+        /**
+         * @brief Queue events of a partition and wait until its handler thread holds the first
+         */
+        void queue(std::int32_t partition, std::size_t count)
+        {
+            std::vector<Event> events;
+            for (std::size_t i = 0; i < count; ++i) {
+                Event event(Event::EventType::eUserUpdated);
+                event.setSource(kTopic, partition, mNextOffset++);
+                events.push_back(std::move(event));
+            }
+            const std::size_t worker = mDispatcher->workerFor(kTopic, partition);
+            const std::size_t depth = mDepth[worker] + count - (mQueued[worker] == 0 ? 1 : 0);
+            mQueued[worker] += count;
+            ASSERT_TRUE(mDispatcher->dispatch(std::move(events)));
+            waitForDepth(worker, depth);
+        }
+
+        /**
+         * @brief Let the handler thread of a partition finish events, it takes the next one each time
+         */
+        void handle(std::int32_t partition, std::size_t count)
+        {
+            const std::size_t worker = mDispatcher->workerFor(kTopic, partition);
+            mQueued[worker] -= count;
+            mGate.release(count);
+            waitForDepth(worker, mQueued[worker] == 0 ? 0 : mQueued[worker] - 1);
+        }
+
+        void waitForDepth(std::size_t worker, std::size_t depth)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (mDispatcher->queueDepth(worker) != depth && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            ASSERT_EQ(mDispatcher->queueDepth(worker), depth);
+            mDepth[worker] = depth;
+        }
+
+        static PartitionBackpressure::TopicPartitions partitions(const std::vector<std::int32_t>& numbers)
+        {
+            PartitionBackpressure::TopicPartitions result;
+            for (const auto number : numbers) {
+                result.insert({kTopic, number});
+            }
+            return result;
+        }
+
+        Gate mGate;
+        std::unique_ptr<PartitionDispatcher> mDispatcher;
+        std::unique_ptr<PartitionBackpressure> mBackpressure;
+        std::vector<std::size_t> mQueued = std::vector<std::size_t>(2, 0); // events a thread has not finished
+        std::vector<std::size_t> mDepth = std::vector<std::size_t>(2, 0);
+        std::int64_t mNextOffset = 0;
+    };
+}
+
+TEST_F(PartitionBackpressureTest, PausesAtHighWatermarkAndResumesAtLowWatermark)
+{
+    start(PartitionDispatcher::Ordering::ePartition);
+    mBackpressure->assigned(partitions({0, 1, 2}));
+
+    queue(0, 4); // three queued behind the one being handled
+    auto changes = mBackpressure->update();
+    EXPECT_TRUE(changes.pause.empty());
+    EXPECT_TRUE(mBackpressure->paused().empty());
+
+    // Only the partitions of the throttled thread are paused
+    queue(2, 1);
+    changes = mBackpressure->update();
+    EXPECT_EQ(changes.pause, partitions({0, 2}));
+    EXPECT_TRUE(changes.resume.empty());
+    EXPECT_EQ(mBackpressure->paused(), partitions({0, 2}));
+    EXPECT_EQ(mBackpressure->throttleCount(), 1u);
+
+    handle(0, 2); // depth 2, above the low watermark
+    changes = mBackpressure->update();
+    EXPECT_TRUE(changes.pause.empty());
+    EXPECT_TRUE(changes.resume.empty());
+
+    handle(0, 1);
+    changes = mBackpressure->update();
+    EXPECT_TRUE(changes.pause.empty());
+    EXPECT_EQ(changes.resume, partitions({0, 2}));
+    EXPECT_TRUE(mBackpressure->paused().empty());
+}
+
+TEST_F(PartitionBackpressureTest, DepthBetweenTheWatermarksDoesNotFlap)
+{
+    start(PartitionDispatcher::Ordering::ePartition);
+    mBackpressure->assigned(partitions({0, 1}));
+
+    // Rising between the watermarks pauses nothing, falling between them resumes nothing
+    queue(0, 4); // depth 3
+    EXPECT_TRUE(mBackpressure->update().pause.empty());
+    for (std::size_t round = 0; round < 3; ++round) {
+        handle(0, 1); // depth 2
+        EXPECT_TRUE(mBackpressure->update().pause.empty());
+        queue(0, 1); // depth 3
+        EXPECT_TRUE(mBackpressure->update().pause.empty());
+    }
+    EXPECT_EQ(mBackpressure->throttleCount(), 0u);
+
+    queue(0, 1); // depth 4
+    EXPECT_EQ(mBackpressure->update().pause, partitions({0}));
+    for (std::size_t round = 0; round < 3; ++round) {
+        handle(0, 2); // depth 2
+        EXPECT_TRUE(mBackpressure->update().resume.empty());
+        queue(0, 1); // depth 3
+        EXPECT_TRUE(mBackpressure->update().pause.empty());
+        queue(0, 1); // depth 4, paused already
+        EXPECT_TRUE(mBackpressure->update().pause.empty());
+    }
+    EXPECT_EQ(mBackpressure->paused(), partitions({0}));
+    EXPECT_EQ(mBackpressure->throttleCount(), 1u);
+}
+
+TEST_F(PartitionBackpressureTest, KeyOrderingPausesEveryPartition)
+{
+    start(PartitionDispatcher::Ordering::eKey);
+    mBackpressure->assigned(partitions({0, 1, 2}));
+
+    queue(1, 5); // events without a key stay on the thread of their partition
+    auto changes = mBackpressure->update();
+    EXPECT_EQ(changes.pause, partitions({0, 1, 2}));
+
+    handle(1, 4);
+    changes = mBackpressure->update();
+    EXPECT_EQ(changes.resume, partitions({0, 1, 2}));
+}
+
+TEST_F(PartitionBackpressureTest, RevokedPartitionIsForgotten)
+{
+    start(PartitionDispatcher::Ordering::ePartition);
+    mBackpressure->assigned(partitions({0, 1, 2}));
+    queue(0, 5);
+    EXPECT_EQ(mBackpressure->update().pause, partitions({0, 2}));
+
+    mBackpressure->revoked(partitions({0}));
+    EXPECT_EQ(mBackpressure->assigned(), partitions({1, 2}));
+    EXPECT_EQ(mBackpressure->paused(), partitions({2}));
+
+    // The consumer owns the partition no more, it is neither paused nor resumed for it
+    queue(0, 1);
+    EXPECT_TRUE(mBackpressure->update().pause.empty());
+    handle(0, 5);
+    EXPECT_EQ(mBackpressure->update().resume, partitions({2}));
+    EXPECT_TRUE(mBackpressure->paused().empty());
+
+    // Assigned again while its thread is throttled, the partition is paused straight away
+    queue(0, 4);
+    EXPECT_EQ(mBackpressure->update().pause, partitions({2}));
+    mBackpressure->assigned(partitions({0}));
+    EXPECT_EQ(mBackpressure->update().pause, partitions({0}));
+    EXPECT_EQ(mBackpressure->paused(), partitions({0, 2}));
+}
@@ -0,0 +1,94 @@
+/**
+ * @file RetrySchedulerTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests when RetryScheduler retries, drops and holds failed events
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "RetryScheduler.h"
+
+namespace
+{
+    /**
+     * @brief Handler which counts its calls and handles every event
+     */
+    class CountingHandler : public Handler
+    {
+    public:
+        bool handleEvent(const Event&) override
+        {
+            mCalls.fetch_add(1);
+            return true;
+        }
+
+        std::atomic<int> mCalls{0};
+    };
+
+    Event makeEvent(std::string_view key, std::int64_t offset)
+    {
+        Event event(Event::EventType::eUserUpdated);
+        event.setKey(key);
+        event.setSource("user-events", 0, offset);
+        return event;
+    }
+
+    RetryScheduler::Options fastOptions()
+    {
+        RetryScheduler::Options options;
+        options.initialBackoff = std::chrono::milliseconds(20);
+        options.tick = std::chrono::milliseconds(1);
+        return options;
+    }
+}
+
+TEST(RetrySchedulerTest, LaterEventOfKeySupersedesRetry)
+{
+    std::atomic<int> completed{0};
+    RetryScheduler retries(fastOptions(), {}, [&](const Event&) { completed.fetch_add(1); });
+    const auto handler = std::make_shared<CountingHandler>();
+
+    ASSERT_TRUE(retries.schedule(makeEvent("user-1", 1), {handler}));
+    EXPECT_TRUE(retries.hasPendingKeys());
+    retries.supersede(makeEvent("user-1", 2), {handler}, {});
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(handler->mCalls.load(), 0); // The older event is not applied after the newer one
+    EXPECT_EQ(completed.load(), 1);
+    EXPECT_EQ(retries.stats().superseded, 1u);
+    EXPECT_FALSE(retries.hasPendingKeys());
+}
+
+TEST(RetrySchedulerTest, EarlierEventOfKeyIsStillRetried)
+{
+    std::atomic<int> completed{0};
+    RetryScheduler retries(fastOptions(), {}, [&](const Event&) { completed.fetch_add(1); });
+    const auto handler = std::make_shared<CountingHandler>();
+
+    ASSERT_TRUE(retries.schedule(makeEvent("user-1", 5), {handler}));
+    retries.supersede(makeEvent("user-1", 4), {handler}, {});
+    retries.supersede(makeEvent("user-1", 6), {handler}, {handler}); // failed, handled nothing
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(handler->mCalls.load(), 1);
+    EXPECT_EQ(retries.stats().recovered, 1u);
+    EXPECT_EQ(completed.load(), 1);
+}
+
+TEST(RetrySchedulerTest, RefusedDeadLetterHoldsOffset)
+{
+    RetryScheduler::Options options = fastOptions();
+    options.maxAttempts = 1;
+    std::atomic<int> completed{0};
+    RetryScheduler retries(options, [](const Event&, std::size_t) { return false; },
+        [&](const Event&) { completed.fetch_add(1); });
+
+    EXPECT_FALSE(retries.schedule(makeEvent("user-1", 1), {std::make_shared<CountingHandler>()}));
+    EXPECT_EQ(completed.load(), 0);
+}
@@ -0,0 +1,235 @@
+/**
+ * @file UserEventViewTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file checks every field UserEventView reads against the eager decoders
+ * * JSON payloads are compared with User::fromJson, protobuf payloads with
+ * * user_service::User::ParseFromString and TimeUtil::ToString for the timestamps.
+ */
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <google/protobuf/util/time_util.h>
+#include <gtest/gtest.h>
+
+#include "EventEnvelope.h"
+#include "User.h"
+#include "UserEventView.h"
+#include "userprofile.pb.h"
+
+namespace
+{
+    using google::protobuf::util::TimeUtil;
+
+    /**
+     * @brief The user ParseFromString decodes, an absent timestamp reads as empty like in the view
+     * @return false if the payload does not parse
+     */
+    bool parseProtobuf(std::string_view payload, User& user)
+    {
+        user_service::User message;
+        if (!message.ParseFromArray(payload.data(), static_cast<int>(payload.size()))) {
+            return false;
+        }
+        user = User(message.user_id(), message.username(), message.email(),
+            message.has_created_at() ? TimeUtil::ToString(message.created_at()) : "",
+            message.has_updated_at() ? TimeUtil::ToString(message.updated_at()) : "");
+        return true;
+    }
+
+    void expectFields(UserEventView& view, const User& expected)
+    {
+        EXPECT_EQ(view.getUserId(), expected.getUserId());
+        EXPECT_EQ(view.getUserName(), expected.getUserName());
+        EXPECT_EQ(view.getEmail(), expected.getEmail());
+        EXPECT_EQ(view.getCreateAt(), expected.getCreateAt());
+        EXPECT_EQ(view.getUpdateAt(), expected.getUpdateAt());
+    }
+
+    /**
+     * @brief Read the fields one at a time, last to first, then whole through a second view
+     */
+    void expectSameUser(std::string_view payload, const User& expected)
+    {
+        {
+            UserEventView view(payload);
+            EXPECT_EQ(view.getUpdateAt(), expected.getUpdateAt());
+            EXPECT_EQ(view.getCreateAt(), expected.getCreateAt());
+            EXPECT_EQ(view.getEmail(), expected.getEmail());
+            EXPECT_EQ(view.getUserName(), expected.getUserName());
+            EXPECT_EQ(view.getUserId(), expected.getUserId());
+            EXPECT_TRUE(view.isValid());
+        }
+
+        UserEventView view(payload);
+        const User user = view.toUser();
+        EXPECT_TRUE(view.isValid());
+        EXPECT_EQ(user.getUserId(), expected.getUserId());
+        EXPECT_EQ(user.getUserName(), expected.getUserName());
+        EXPECT_EQ(user.getEmail(), expected.getEmail());
+        EXPECT_EQ(user.getCreateAt(), expected.getCreateAt());
+        EXPECT_EQ(user.getUpdateAt(), expected.getUpdateAt());
+        expectFields(view, expected);
+    }
+
+    void expectSameAsFromJson(std::string_view payload)
+    {
+        SCOPED_TRACE(std::string(payload));
+        UserEventView view(payload);
+        EXPECT_EQ(view.getEncoding(), UserEventView::Encoding::eJson);
+        expectSameUser(payload, User().fromJson(payload));
+    }
+
+    void expectSameAsProtobuf(const std::string& payload)
+    {
+        User expected;
+        ASSERT_TRUE(parseProtobuf(payload, expected));
+        UserEventView view(payload);
+        EXPECT_EQ(view.getEncoding(), UserEventView::Encoding::eProtobuf);
+        expectSameUser(payload, expected);
+    }
+
+    user_service::User makeMessage()
+    {
+        user_service::User message;
+        message.set_user_id("6f1c2a4e-9b7d-4c3e-8a5f-100000000042");
+        message.set_email("user42@example.com");
+        message.set_username("user42");
+        message.mutable_created_at()->set_seconds(1792137600); // 2026-10-16T08:00:00Z
+        message.mutable_updated_at()->set_seconds(1792143000);
+        return message;
+    }
+}
+
+TEST(UserEventViewTest, JsonMatchesFromJson)
+{
+    User user("6f1c2a4e-9b7d-4c3e-8a5f-100000000042", "user42", "user42@example.com", "2026-10-16T08:00:00Z",
+        "2026-10-16T09:30:00Z");
+    expectSameAsFromJson(user.toJson());
+    expectSameAsFromJson(" \n{ \"email\" : \"e@x\" ,\t\"user_id\":\"u1\" , \"updated_at\":\"later\" }");
+    expectSameAsFromJson("{}");
+}
+
+TEST(UserEventViewTest, JsonEscapesAreDecoded)
+{
+    expectSameAsFromJson(R"({"user_id":"a\"b\\c\/d","username":"tab\there\nline\r\b\f",)"
+                         R"("email":"A\u00e9\u4E2D@x","created_at":"\uD83D\uDE00","updated_at":"\ud83d\ude00 ok"})");
+
+    UserEventView view(R"({"username":"\uD83D\uDE00"})");
+    EXPECT_EQ(view.getUserName(), "\xF0\x9F\x98\x80"); // U+1F600 as UTF-8
+
+    // A high surrogate without its low half is no character, fromJson rejects the whole payload
+    UserEventView lone(R"({"username":"\uD83D x"})");
+    EXPECT_EQ(lone.getUserName(), "");
+    EXPECT_FALSE(lone.isValid());
+    EXPECT_EQ(User().fromJson(R"({"username":"\uD83D x"})").getUserName(), "");
+}
+
+TEST(UserEventViewTest, JsonSkipsNestedValuesAndBracesInStrings)
+{
+    expectSameAsFromJson(R"({"profile":{"bio":"} ] { [","tags":["}",{"a":[1,2,{"b":"]"}]}]},)"
+                         R"("user_id":"u}1","extra":[["}"],[]],"email":"e}@x","count":-1.5e3,)"
+                         R"("username":"{name}","flags":[true,false,null],"created_at":"c","updated_at":"u"})");
+}
+
+TEST(UserEventViewTest, JsonNullAndMissingFieldsAreEmpty)
+{
+    expectSameAsFromJson(R"({"user_id":"u1","email":null})");
+    expectSameAsFromJson(R"({"user_id":null,"username":7,"email":{"a":"b"},"created_at":["c"],"updated_at":true})");
+    expectSameAsFromJson(R"({"other":"x"})");
+}
+
+TEST(UserEventViewTest, TruncatedJsonIsInvalid)
+{
+    User user("u1", "name", "e@x", "2026-10-16T08:00:00Z", "2026-10-16T09:30:00Z");
+    const std::string payload = user.toJson();
+    for (std::size_t size = 1; size < payload.size(); ++size) {
+        const std::string_view truncated(payload.data(), size);
+        UserEventView view(truncated);
+        view.toUser();
+        EXPECT_FALSE(view.isValid()) << truncated;
+    }
+
+    // The fields in front of the error were read, the ones behind it read as empty
+    UserEventView view(R"({"user_id":"u1","email":"e@)");
+    EXPECT_EQ(view.getUserId(), "u1");
+    EXPECT_EQ(view.getEmail(), "");
+    EXPECT_FALSE(view.isValid());
+}
+
+TEST(UserEventViewTest, ProtobufMatchesParseFromString)
+{
+    expectSameAsProtobuf(makeMessage().SerializeAsString());
+    expectSameAsProtobuf(user_service::User().SerializeAsString()); // every field missing
+
+    auto message = makeMessage();
+    message.clear_email();
+    message.clear_updated_at();
+    message.set_username("\xF0\x9F\x98\x80 } \" {");
+    expectSameAsProtobuf(message.SerializeAsString());
+}
+
+TEST(UserEventViewTest, ProtobufTimestampsMatchTimeUtil)
+{
+    auto message = makeMessage();
+    for (const auto nanos : {1, 1000, 1000000, 120000000, 999999999}) {
+        message.mutable_created_at()->set_nanos(nanos);
+        expectSameAsProtobuf(message.SerializeAsString());
+    }
+
+    // Before the epoch, with and without a fraction, down to the first valid second
+    for (const auto seconds : {-1LL, -86400LL, -2208988800LL, -62135596800LL}) {
+        message.mutable_updated_at()->set_seconds(seconds);
+        message.mutable_updated_at()->set_nanos(0);
+        expectSameAsProtobuf(message.SerializeAsString());
+        message.mutable_updated_at()->set_nanos(500000000);
+        expectSameAsProtobuf(message.SerializeAsString());
+    }
+
+    message.mutable_created_at()->set_seconds(253402300799); // 9999-12-31T23:59:59Z
+    expectSameAsProtobuf(message.SerializeAsString());
+}
+
+TEST(UserEventViewTest, TruncatedProtobufIsInvalid)
+{
+    auto message = makeMessage();
+    message.mutable_created_at()->set_nanos(123456789);
+    const std::string payload = message.SerializeAsString();
+    for (std::size_t size = 1; size < payload.size(); ++size) {
+        const std::string truncated = payload.substr(0, size);
+        User expected;
+        const bool parsed = parseProtobuf(truncated, expected);
+
+        // A cut between two fields is a shorter message to both decoders
+        UserEventView view(truncated);
+        view.toUser();
+        EXPECT_EQ(view.isValid(), parsed) << size;
+        if (parsed) {
+            expectFields(view, expected);
+        }
+    }
+}
+
+TEST(UserEventViewTest, EnvelopeUserIdComesFromTheHeader)
+{
+    const std::string json = R"({"user_id":"in-payload","username":"name","email":"e@x","created_at":"c"})";
+    const std::string envelope = EventEnvelope::encode(user_profile::utils::event::EventType::eUserUpdated,
+        "in-header", std::chrono::system_clock::now(), json);
+    ASSERT_FALSE(envelope.empty());
+
+    User expected = User().fromJson(json);
+    expected.setUserId("in-header");
+    {
+        UserEventView view(envelope);
+        EXPECT_EQ(view.getEncoding(), UserEventView::Encoding::eJson);
+    }
+    expectSameUser(envelope, expected);
+
+    const std::string protobuf = makeMessage().SerializeAsString();
+    const std::string wrapped = EventEnvelope::encode(user_profile::utils::event::EventType::eUserCreated,
+        makeMessage().user_id(), std::chrono::system_clock::now(), protobuf);
+    ASSERT_TRUE(parseProtobuf(protobuf, expected));
+    expectSameUser(wrapped, expected);
+}
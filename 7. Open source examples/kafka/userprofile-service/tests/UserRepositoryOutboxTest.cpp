@@ -0,0 +1,127 @@
+/**
+ * @file UserRepositoryOutboxTest.cpp
+ * @author trung.la
+ * @date 10-16-2026
+ * @brief This file tests the Outbox table of UserRepository on a temporary SQLite database
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "User.h"
+#include "UserRepository.h"
+
+namespace
+{
+    const std::string kTopic = "user-events";
+
+    class UserRepositoryOutboxTest : public ::testing::Test
+    {
+    protected:
+        UserRepositoryOutboxTest()
+        {
+            // The repository opens SQLite with an empty path, a private temporary database
+            mRepository.selectConnection(UserRepository::ConnectionType::eSQLite);
+            mRepository.createTable();
+        }
+
+        static User makeUser(const std::string& userId)
+        {
+            return User(userId, "name-" + userId, userId + "@example.com", "2026-10-16", "2026-10-16");
+        }
+
+        static OutboxMessage makeEvent(const std::string& key, const std::string& eventId)
+        {
+            OutboxMessage event;
+            event.topic = kTopic;
+            event.key = key;
+            event.payload = std::string("{\"id\":\"") + key + "\"}" + std::string(1, '\0') + "binary";
+            event.type = user_profile::utils::event::EventType::eUserCreated;
+            event.eventId = eventId;
+            return event;
+        }
+
+        static std::vector<std::string> eventIds(const std::vector<OutboxMessage>& rows)
+        {
+            std::vector<std::string> ids;
+            for (const auto& row : rows) {
+                ids.push_back(row.eventId);
+            }
+            return ids;
+        }
+
+        UserRepository mRepository;
+    };
+}
+
+TEST_F(UserRepositoryOutboxTest, UserAndEventAreCommittedTogether)
+{
+    const auto event = makeEvent("u1", "e1");
+    ASSERT_TRUE(mRepository.insert(makeUser("u1"), event));
+    EXPECT_TRUE(mRepository.findById("u1").has_value());
+
+    const auto rows = mRepository.fetchOutbox(10);
+    ASSERT_TRUE(rows.has_value());
+    ASSERT_EQ(rows->size(), 1u);
+    const auto& row = rows->front();
+    EXPECT_GT(row.id, 0);
+    EXPECT_EQ(row.topic, event.topic);
+    EXPECT_EQ(row.key, event.key);
+    EXPECT_EQ(row.payload, event.payload); // a blob, the embedded zero byte survives
+    EXPECT_EQ(row.type, event.type);
+    EXPECT_EQ(row.eventId, event.eventId);
+}
+
+TEST_F(UserRepositoryOutboxTest, FailedUserWriteKeepsNoEvent)
+{
+    ASSERT_TRUE(mRepository.insert(makeUser("u1"), makeEvent("u1", "e1")));
+    EXPECT_FALSE(mRepository.insert(makeUser("u1"), makeEvent("u1", "e2"))); // duplicate user_id
+
+    const auto rows = mRepository.fetchOutbox(10);
+    ASSERT_TRUE(rows.has_value());
+    EXPECT_EQ(eventIds(*rows), (std::vector<std::string>{"e1"}));
+}
+
+TEST_F(UserRepositoryOutboxTest, RowsAreReadInIdOrderUpToTheLimit)
+{
+    ASSERT_TRUE(mRepository.insert(makeUser("u1"), makeEvent("u1", "e1")));
+    ASSERT_TRUE(mRepository.update(makeUser("u1"), makeEvent("u1", "e2")));
+    ASSERT_TRUE(mRepository.insert(makeUser("u2"), makeEvent("u2", "e3")));
+
+    const auto firstTwo = mRepository.fetchOutbox(2);
+    ASSERT_TRUE(firstTwo.has_value());
+    EXPECT_EQ(eventIds(*firstTwo), (std::vector<std::string>{"e1", "e2"}));
+    EXPECT_LT(firstTwo->at(0).id, firstTwo->at(1).id);
+
+    const auto all = mRepository.fetchOutbox(10);
+    ASSERT_TRUE(all.has_value());
+    EXPECT_EQ(eventIds(*all), (std::vector<std::string>{"e1", "e2", "e3"}));
+}
+
+TEST_F(UserRepositoryOutboxTest, RemoveDeletesOnlyTheGivenRows)
+{
+    ASSERT_TRUE(mRepository.insert(makeUser("u1"), makeEvent("u1", "e1")));
+    ASSERT_TRUE(mRepository.insert(makeUser("u2"), makeEvent("u2", "e2")));
+    ASSERT_TRUE(mRepository.insert(makeUser("u3"), makeEvent("u3", "e3")));
+    const auto rows = mRepository.fetchOutbox(10);
+    ASSERT_TRUE(rows.has_value());
+    ASSERT_EQ(rows->size(), 3u);
+
+    EXPECT_TRUE(mRepository.removeOutbox({}));
+    EXPECT_TRUE(mRepository.removeOutbox({rows->at(0).id, rows->at(2).id}));
+
+    const auto remaining = mRepository.fetchOutbox(10);
+    ASSERT_TRUE(remaining.has_value());
+    EXPECT_EQ(eventIds(*remaining), (std::vector<std::string>{"e2"}));
+}
+
+TEST_F(UserRepositoryOutboxTest, OutboxCannotBeReadWithoutConnection)
+{
+    UserRepository repository; // no connection selected
+    EXPECT_FALSE(repository.fetchOutbox(10).has_value());
+    EXPECT_FALSE(repository.removeOutbox({1}));
+    EXPECT_FALSE(repository.insert(makeUser("u1"), makeEvent("u1", "e1")));
+}